@@ -21,7 +21,7 @@ Item {
         var axesList = []
 
         for (var i = 0; i < status.config.axes; ++i) {
-            if (status.motion.axis[i].homed) {
+            if (status.motionAxis[i].homed) {
                 command.unhomeAxis(i);
             }
             if ((axesList.length === 0) ||
@@ -57,8 +57,8 @@ Item {
 
         for (i = (_prepareAxesList.length-1); i >= 0 ; --i) {
             axis = _prepareAxesList[i];
-            if (!status.motion.axis[axis].homing
-                    && !status.motion.axis[axis].homed) {
+            if (!status.motionAxis[axis].homing
+                    && !status.motionAxis[axis].homed) {
                 prepare = true;
             }
             else {
@@ -78,7 +78,7 @@ Item {
 
         for (i = 0; i < _homingAxesList.length; ++i) {
             axis = _homingAxesList[i];
-            if (status.motion.axis[axis].homing) {
+            if (status.motionAxis[axis].homing) {
                 homing = true;
                 break;
             }
@@ -27,7 +27,9 @@ SOURCES += \
     applicationlauncher.cpp \
     applicationpluginitem.cpp \
     applicationplugins.cpp \
+    applicationposition.cpp \
     applicationstatus.cpp \
+    applicationstatusarray.cpp \
     localsettings.cpp
 
 HEADERS += \
@@ -47,7 +49,9 @@ HEADERS += \
     applicationlauncher.h \
     applicationpluginitem.h \
     applicationplugins.h \
+    applicationposition.h \
     applicationstatus.h \
+    applicationstatusarray.h \
     localsettings.h
 
 RESOURCES += \
@@ -8,9 +8,12 @@ namespace qtquickvcp {
 
 ApplicationLauncher::ApplicationLauncher(QObject *parent) :
     application::LauncherBase(parent),
-    m_launchers(QJsonValue(QJsonArray())),
+    m_launchers(new ApplicationStatusArray(this)),
     m_synced(false)
 {
+    connect(m_launchers, &ApplicationStatusArray::elementsChanged,
+            this, &ApplicationLauncher::launchersChanged);
+
     initializeObject();
     addLauncherTopic("launcher");
 }
@@ -87,16 +90,14 @@ void ApplicationLauncher::shutdown()
 void ApplicationLauncher::launcherFullUpdateReceived(const QByteArray &topic, const Container &rx)
 {
     Q_UNUSED(topic);
-    m_launchers = QJsonValue(QJsonArray()); // clear old value
-    MachinetalkService::updateValue(rx, &m_launchers, "launcher", "launcher"); // launcher protobuf value, launcher temp path
-    emit launchersChanged(m_launchers);
+    m_launchers->clear(); // clear old value
+    m_launchers->update(rx, Container::descriptor()->FindFieldByName("launcher"), "launcher"); // launcher temp path
 }
 
 void ApplicationLauncher::launcherIncrementalUpdateReceived(const QByteArray &topic, const Container &rx)
 {
     Q_UNUSED(topic);
-    MachinetalkService::updateValue(rx, &m_launchers, "launcher", "launcher"); // launcher protobuf value, launcher temp path
-    emit launchersChanged(m_launchers);
+    m_launchers->update(rx, Container::descriptor()->FindFieldByName("launcher"), "launcher"); // launcher temp path
 }
 
 void ApplicationLauncher::syncStatus()
@@ -114,8 +115,7 @@ void ApplicationLauncher::unsyncStatus()
 
 void ApplicationLauncher::initializeObject()
 {
-    m_launchers = QJsonValue(QJsonArray());
-    emit launchersChanged(m_launchers);
+    m_launchers->clear();
 }
 
 }; // namespace qtquickvcp
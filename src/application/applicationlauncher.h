@@ -23,23 +23,28 @@
 #define APPLICATIONLAUNCHER_H
 
 #include <QObject>
-#include <QJsonValue>
 #include <machinetalk/protobuf/message.pb.h>
 #include <application/launcherbase.h>
+#include "applicationstatusarray.h"
 
 namespace qtquickvcp {
 
 class ApplicationLauncher : public machinetalk::application::LauncherBase
 {
     Q_OBJECT
-    Q_PROPERTY(QJsonValue launchers READ launchers NOTIFY launchersChanged)
+    Q_PROPERTY(QVariantList launchers READ launchers NOTIFY launchersChanged)
     Q_PROPERTY(bool synced READ isSynced NOTIFY syncedChanged)
 
 public:
     explicit ApplicationLauncher(QObject *parent = 0);
     ~ApplicationLauncher();
 
-    QJsonValue launchers() const
+    QVariantList launchers() const
+    {
+        return m_launchers->elements();
+    }
+
+    ApplicationStatusArray *launcherArray() const
     {
         return m_launchers;
     }
@@ -58,7 +63,7 @@ public slots:
     void shutdown();
 
 private:
-    QJsonValue m_launchers;
+    ApplicationStatusArray *m_launchers;
     bool m_synced;
 
     // more efficient to reuse a protobuf Message
@@ -73,7 +78,7 @@ private slots:
     void unsyncStatus();
 
 signals:
-    void launchersChanged(const QJsonValue &arg);
+    void launchersChanged(const QVariantList &arg);
     void syncedChanged(bool arg);
 }; // class ApplicationLauncher
 } // namespace qtquickvcp
@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "applicationposition.h"
+
+namespace qtquickvcp {
+
+/*!
+    \qmlbasictype position
+    \inqmlmodule Machinekit.Application
+    \brief A position vector with 9 axes.
+    \ingroup application
+
+    The position type holds the values of the axes \c x, \c y, \c z,
+    \c a, \c b, \c c, \c u, \c v and \c w. The axes can be accessed by
+    name or by index using the \c at() and \c axis() methods.
+
+    Unit scaling and offset calculations are done in C++ with the
+    \c scaled(), \c plus() and \c minus() methods.
+
+    \qml
+    Label {
+        text: status.position.scaled(helper.distanceFactor).minus(status.g5xOffset).x.toFixed(3)
+    }
+    \endqml
+
+    \sa ApplicationStatus
+*/
+
+ApplicationPosition::ApplicationPosition()
+{
+    for (int i = 0; i < AxisCount; ++i)
+    {
+        m_values[i] = 0.0;
+    }
+}
+
+/** Returns the value of the axis at index, x is 0 and w is 8 */
+double ApplicationPosition::at(int index) const
+{
+    if ((index < 0) || (index >= AxisCount))
+    {
+        return 0.0;
+    }
+
+    return m_values[index];
+}
+
+/** Returns the value of the axis with the given name, e.g. "x" or "A" */
+double ApplicationPosition::axis(const QString &name) const
+{
+    return at(axisIndex(name));
+}
+
+ApplicationPosition ApplicationPosition::scaled(double factor) const
+{
+    ApplicationPosition position;
+    for (int i = 0; i < AxisCount; ++i)
+    {
+        position.m_values[i] = m_values[i] * factor;
+    }
+    return position;
+}
+
+ApplicationPosition ApplicationPosition::plus(const ApplicationPosition &other) const
+{
+    ApplicationPosition position;
+    for (int i = 0; i < AxisCount; ++i)
+    {
+        position.m_values[i] = m_values[i] + other.m_values[i];
+    }
+    return position;
+}
+
+ApplicationPosition ApplicationPosition::minus(const ApplicationPosition &other) const
+{
+    ApplicationPosition position;
+    for (int i = 0; i < AxisCount; ++i)
+    {
+        position.m_values[i] = m_values[i] - other.m_values[i];
+    }
+    return position;
+}
+
+QVector3D ApplicationPosition::toVector3D() const
+{
+    return QVector3D(static_cast<float>(m_values[0]),
+                     static_cast<float>(m_values[1]),
+                     static_cast<float>(m_values[2]));
+}
+
+QString ApplicationPosition::toString() const
+{
+    return QString("position(%1, %2, %3, %4, %5, %6, %7, %8, %9)")
+            .arg(m_values[0]).arg(m_values[1]).arg(m_values[2])
+            .arg(m_values[3]).arg(m_values[4]).arg(m_values[5])
+            .arg(m_values[6]).arg(m_values[7]).arg(m_values[8]);
+}
+
+void ApplicationPosition::setAt(int index, double value)
+{
+    if ((index < 0) || (index >= AxisCount))
+    {
+        return;
+    }
+
+    m_values[index] = value;
+}
+
+/** Updates the axes present in the message, returns true if a value changed */
+bool ApplicationPosition::update(const machinetalk::Position &position)
+{
+    const double values[AxisCount] = { position.x(), position.y(), position.z(),
+                                       position.a(), position.b(), position.c(),
+                                       position.u(), position.v(), position.w() };
+    const bool present[AxisCount] = { position.has_x(), position.has_y(), position.has_z(),
+                                      position.has_a(), position.has_b(), position.has_c(),
+                                      position.has_u(), position.has_v(), position.has_w() };
+    bool changed = false;
+
+    for (int i = 0; i < AxisCount; ++i)
+    {
+        if (present[i] && (m_values[i] != values[i]))
+        {
+            m_values[i] = values[i];
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+int ApplicationPosition::axisIndex(const QString &name)
+{
+    if (name.size() != 1)
+    {
+        return -1;
+    }
+
+    switch (name.at(0).toLower().toLatin1())
+    {
+    case 'x': return 0;
+    case 'y': return 1;
+    case 'z': return 2;
+    case 'a': return 3;
+    case 'b': return 4;
+    case 'c': return 5;
+    case 'u': return 6;
+    case 'v': return 7;
+    case 'w': return 8;
+    default: return -1;
+    }
+}
+
+bool ApplicationPosition::operator==(const ApplicationPosition &other) const
+{
+    for (int i = 0; i < AxisCount; ++i)
+    {
+        if (m_values[i] != other.m_values[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}; // namespace qtquickvcp
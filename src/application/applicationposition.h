@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef APPLICATIONPOSITION_H
+#define APPLICATIONPOSITION_H
+
+#include <QObject>
+#include <QVector3D>
+#include <machinetalk/protobuf/preview.pb.h>
+
+namespace qtquickvcp {
+
+class ApplicationPosition
+{
+    Q_GADGET
+    Q_PROPERTY(double x READ x WRITE setX)
+    Q_PROPERTY(double y READ y WRITE setY)
+    Q_PROPERTY(double z READ z WRITE setZ)
+    Q_PROPERTY(double a READ a WRITE setA)
+    Q_PROPERTY(double b READ b WRITE setB)
+    Q_PROPERTY(double c READ c WRITE setC)
+    Q_PROPERTY(double u READ u WRITE setU)
+    Q_PROPERTY(double v READ v WRITE setV)
+    Q_PROPERTY(double w READ w WRITE setW)
+
+public:
+    enum { AxisCount = 9 };
+
+    ApplicationPosition();
+
+    double x() const { return m_values[0]; }
+    double y() const { return m_values[1]; }
+    double z() const { return m_values[2]; }
+    double a() const { return m_values[3]; }
+    double b() const { return m_values[4]; }
+    double c() const { return m_values[5]; }
+    double u() const { return m_values[6]; }
+    double v() const { return m_values[7]; }
+    double w() const { return m_values[8]; }
+
+    void setX(double value) { m_values[0] = value; }
+    void setY(double value) { m_values[1] = value; }
+    void setZ(double value) { m_values[2] = value; }
+    void setA(double value) { m_values[3] = value; }
+    void setB(double value) { m_values[4] = value; }
+    void setC(double value) { m_values[5] = value; }
+    void setU(double value) { m_values[6] = value; }
+    void setV(double value) { m_values[7] = value; }
+    void setW(double value) { m_values[8] = value; }
+
+    const double *constData() const
+    {
+        return m_values;
+    }
+
+    Q_INVOKABLE double at(int index) const;
+    Q_INVOKABLE double axis(const QString &name) const;
+    Q_INVOKABLE qtquickvcp::ApplicationPosition scaled(double factor) const;
+    Q_INVOKABLE qtquickvcp::ApplicationPosition plus(const qtquickvcp::ApplicationPosition &other) const;
+    Q_INVOKABLE qtquickvcp::ApplicationPosition minus(const qtquickvcp::ApplicationPosition &other) const;
+    Q_INVOKABLE QVector3D toVector3D() const;
+    Q_INVOKABLE QString toString() const;
+
+    void setAt(int index, double value);
+    bool update(const machinetalk::Position &position);
+
+    static int axisIndex(const QString &name);
+
+    bool operator==(const ApplicationPosition &other) const;
+    bool operator!=(const ApplicationPosition &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    double m_values[AxisCount];
+}; // class ApplicationPosition
+} // namespace qtquickvcp
+
+Q_DECLARE_METATYPE(qtquickvcp::ApplicationPosition)
+
+#endif // APPLICATIONPOSITION_H
@@ -23,6 +23,7 @@
 #include "applicationstatus.h"
 #include <google/protobuf/text_format.h>
 #include <machinetalkservice.h>
+#include <QGuiApplication>
 #include "debughelper.h"
 
 using namespace machinetalk;
@@ -31,15 +32,44 @@ namespace qtquickvcp {
 
 ApplicationStatus::ApplicationStatus(QObject *parent) :
     application::StatusBase(parent),
+    m_motionAxis(new ApplicationStatusArray(this)),
+    m_toolTable(new ApplicationStatusArray(this)),
     m_running(false),
     m_synced(false),
     m_syncedChannels(NoChannel),
-    m_channels(MotionChannel | ConfigChannel | IoChannel | TaskChannel | InterpChannel)
+    m_channels(MotionChannel | ConfigChannel | IoChannel | TaskChannel | InterpChannel),
+    m_frameSynchronized(false),
+    m_framePending(false),
+    m_frameWindow(nullptr),
+    m_pendingChannels(NoChannel)
 {
     connect(this, &ApplicationStatus::taskChanged,
             this, &ApplicationStatus::updateRunning);
     connect(this, &ApplicationStatus::interpChanged,
             this, &ApplicationStatus::updateRunning);
+    connect(m_motionAxis, &ApplicationStatusArray::elementsChanged,
+            this, &ApplicationStatus::motionAxisChanged);
+    connect(m_toolTable, &ApplicationStatusArray::elementsChanged,
+            this, &ApplicationStatus::toolTableChanged);
+
+    // publishes the pending updates if the window does not produce a frame
+    m_frameTimer.setSingleShot(true);
+    m_frameTimer.setInterval(100);
+    connect(&m_frameTimer, &QTimer::timeout,
+            this, &ApplicationStatus::publishPendingUpdates);
+
+    // position vectors and repeated fields are not part of the JSON objects
+    const google::protobuf::Descriptor *motionDescriptor = EmcStatusMotion::descriptor();
+    for (int i = 0; i < motionDescriptor->field_count(); ++i)
+    {
+        const google::protobuf::FieldDescriptor *field = motionDescriptor->field(i);
+        if (field->message_type() == Position::descriptor()) {
+            m_motionSkipFields.insert(field);
+        }
+    }
+    m_motionSkipFields.insert(motionDescriptor->FindFieldByName("axis"));
+    m_ioSkipFields.insert(EmcStatusIo::descriptor()->FindFieldByName("tool_offset"));
+    m_ioSkipFields.insert(EmcStatusIo::descriptor()->FindFieldByName("tool_table"));
 
     initializeObject(MotionChannel);
     initializeObject(ConfigChannel);
@@ -65,8 +95,42 @@ void ApplicationStatus::updateSync(ApplicationStatus::StatusChannel channel)
 
 void ApplicationStatus::updateMotionObject(const EmcStatusMotion &motion)
 {
-    MachinetalkService::recurseMessage(motion, &m_motion);
-    emit motionChanged(m_motion);
+    updateMotionPositions(motion);
+    if (motion.axis_size() > 0) {
+        m_motionAxis->update(motion, EmcStatusMotion::descriptor()->FindFieldByName("axis"));
+    }
+
+    if (MachinetalkService::recurseMessage(motion, &m_motion, QString(), QString("json"), m_motionSkipFields) > 0) {
+        emit motionChanged(m_motion);
+    }
+}
+
+void ApplicationStatus::updateMotionPositions(const EmcStatusMotion &motion)
+{
+    if (motion.has_position() && m_position.update(motion.position())) {
+        emit positionChanged(m_position);
+    }
+    if (motion.has_actual_position() && m_actualPosition.update(motion.actual_position())) {
+        emit actualPositionChanged(m_actualPosition);
+    }
+    if (motion.has_joint_position() && m_jointPosition.update(motion.joint_position())) {
+        emit jointPositionChanged(m_jointPosition);
+    }
+    if (motion.has_joint_actual_position() && m_jointActualPosition.update(motion.joint_actual_position())) {
+        emit jointActualPositionChanged(m_jointActualPosition);
+    }
+    if (motion.has_probed_position() && m_probedPosition.update(motion.probed_position())) {
+        emit probedPositionChanged(m_probedPosition);
+    }
+    if (motion.has_dtg() && m_dtg.update(motion.dtg())) {
+        emit dtgChanged(m_dtg);
+    }
+    if (motion.has_g5x_offset() && m_g5xOffset.update(motion.g5x_offset())) {
+        emit g5xOffsetChanged(m_g5xOffset);
+    }
+    if (motion.has_g92_offset() && m_g92Offset.update(motion.g92_offset())) {
+        emit g92OffsetChanged(m_g92Offset);
+    }
 }
 
 void ApplicationStatus::updateConfigObject(const EmcStatusConfig &config)
@@ -77,8 +141,16 @@ void ApplicationStatus::updateConfigObject(const EmcStatusConfig &config)
 
 void ApplicationStatus::updateIoObject(const EmcStatusIo &io)
 {
-    MachinetalkService::recurseMessage(io, &m_io);
-    emit ioChanged(m_io);
+    if (io.has_tool_offset() && m_toolOffset.update(io.tool_offset())) {
+        emit toolOffsetChanged(m_toolOffset);
+    }
+    if (io.tool_table_size() > 0) {
+        m_toolTable->update(io, EmcStatusIo::descriptor()->FindFieldByName("tool_table"));
+    }
+
+    if (MachinetalkService::recurseMessage(io, &m_io, QString(), QString("json"), m_ioSkipFields) > 0) {
+        emit ioChanged(m_io);
+    }
 }
 
 void ApplicationStatus::updateTaskObject(const EmcStatusTask &task)
@@ -96,6 +168,8 @@ void ApplicationStatus::updateInterpObject(const EmcStatusInterp &interp)
 void ApplicationStatus::emcstatFullUpdateReceived(const QByteArray &topic, const Container &rx)
 {
     StatusChannel channel = m_channelMap.value(topic, NoChannel);
+    emit statusUpdateReceived(channel, rx);
+    publishPendingUpdates(); // keep the order of buffered updates
     emcstatUpdateReceived(channel, rx);
     updateSync(channel);
 }
@@ -103,7 +177,111 @@ void ApplicationStatus::emcstatFullUpdateReceived(const QByteArray &topic, const
 void ApplicationStatus::emcstatIncrementalUpdateReceived(const QByteArray &topic, const Container &rx)
 {
     StatusChannel channel = m_channelMap.value(topic, NoChannel);
-    emcstatUpdateReceived(channel, rx);
+    emit statusUpdateReceived(channel, rx);
+    if (m_frameSynchronized) {
+        bufferUpdate(channel, rx);
+    }
+    else {
+        emcstatUpdateReceived(channel, rx);
+    }
+}
+
+void ApplicationStatus::setFrameSynchronized(bool frameSynchronized)
+{
+    if (m_frameSynchronized == frameSynchronized) {
+        return;
+    }
+
+    m_frameSynchronized = frameSynchronized;
+    if (!m_frameSynchronized) {
+        publishPendingUpdates();
+    }
+    emit frameSynchronizedChanged(frameSynchronized);
+}
+
+/** Merges an incremental update into the pending update, the latest value of a field wins */
+void ApplicationStatus::bufferUpdate(StatusChannel channel, const Container &rx)
+{
+    switch (channel) {
+    case MotionChannel:
+        m_pendingUpdate.mutable_emc_status_motion()->MergeFrom(rx.emc_status_motion());
+        break;
+    case ConfigChannel:
+        m_pendingUpdate.mutable_emc_status_config()->MergeFrom(rx.emc_status_config());
+        break;
+    case IoChannel:
+        m_pendingUpdate.mutable_emc_status_io()->MergeFrom(rx.emc_status_io());
+        break;
+    case TaskChannel:
+        m_pendingUpdate.mutable_emc_status_task()->MergeFrom(rx.emc_status_task());
+        break;
+    case InterpChannel:
+        m_pendingUpdate.mutable_emc_status_interp()->MergeFrom(rx.emc_status_interp());
+        break;
+    case NoChannel:
+        return;
+    }
+
+    m_pendingChannels |= channel;
+    requestFrame();
+}
+
+/** Schedules publishing the pending updates with the next frame of the window */
+void ApplicationStatus::requestFrame()
+{
+    if (m_frameWindow.isNull()) {
+        m_frameWindow = findFrameWindow();
+        if (m_frameWindow.isNull()) { // no window to synchronize to
+            publishPendingUpdates();
+            return;
+        }
+        connect(m_frameWindow.data(), &QQuickWindow::afterAnimating,
+                this, &ApplicationStatus::publishPendingUpdates);
+    }
+
+    if (!m_frameWindow->isExposed()) { // hidden windows do not render frames
+        publishPendingUpdates();
+        return;
+    }
+
+    if (!m_framePending) {
+        m_framePending = true;
+        m_frameWindow->update();
+        m_frameTimer.start();
+    }
+}
+
+QQuickWindow *ApplicationStatus::findFrameWindow() const
+{
+    for (QWindow *window: QGuiApplication::topLevelWindows())
+    {
+        QQuickWindow *quickWindow = qobject_cast<QQuickWindow*>(window);
+        if (quickWindow != nullptr) {
+            return quickWindow;
+        }
+    }
+
+    return nullptr;
+}
+
+/** Converts the pending updates and notifies QML once per frame */
+void ApplicationStatus::publishPendingUpdates()
+{
+    m_framePending = false;
+    m_frameTimer.stop();
+
+    if (m_pendingChannels == NoChannel) {
+        return;
+    }
+
+    const StatusChannels channels = m_pendingChannels;
+    m_pendingChannels = NoChannel;
+    for (StatusChannel channel: { MotionChannel, ConfigChannel, IoChannel, TaskChannel, InterpChannel }) {
+        if (channels & channel) {
+            emcstatUpdateReceived(channel, m_pendingUpdate);
+        }
+    }
+    m_pendingUpdate.Clear();
 }
 
 void ApplicationStatus::syncStatus()
@@ -114,6 +292,8 @@ void ApplicationStatus::syncStatus()
 
 void ApplicationStatus::unsyncStatus()
 {
+    m_pendingChannels = NoChannel;
+    m_pendingUpdate.Clear();
     m_synced = false;
     m_syncedChannels = 0;
     emit syncedChanged(m_synced);
@@ -190,8 +370,9 @@ void ApplicationStatus::initializeObject(ApplicationStatus::StatusChannel channe
     {
     case MotionChannel:
         m_motion = QJsonObject();
-        MachinetalkService::recurseDescriptor(EmcStatusMotion::descriptor(), &m_motion);
+        MachinetalkService::recurseDescriptor(EmcStatusMotion::descriptor(), &m_motion, m_motionSkipFields);
         emit motionChanged(m_motion);
+        initializeValues(MotionChannel);
         break;
     case ConfigChannel:
         m_config = QJsonObject();
@@ -200,8 +381,9 @@ void ApplicationStatus::initializeObject(ApplicationStatus::StatusChannel channe
         break;
     case IoChannel:
         m_io = QJsonObject();
-        MachinetalkService::recurseDescriptor(EmcStatusIo::descriptor(), &m_io);
+        MachinetalkService::recurseDescriptor(EmcStatusIo::descriptor(), &m_io, m_ioSkipFields);
         emit ioChanged(m_io);
+        initializeValues(IoChannel);
         break;
     case TaskChannel:
         m_task = QJsonObject();
@@ -217,4 +399,36 @@ void ApplicationStatus::initializeObject(ApplicationStatus::StatusChannel channe
         break;
     }
 }
+
+void ApplicationStatus::initializeValues(ApplicationStatus::StatusChannel channel)
+{
+    const ApplicationPosition zero;
+
+    if (channel == MotionChannel)
+    {
+        m_position = zero;
+        emit positionChanged(m_position);
+        m_actualPosition = zero;
+        emit actualPositionChanged(m_actualPosition);
+        m_jointPosition = zero;
+        emit jointPositionChanged(m_jointPosition);
+        m_jointActualPosition = zero;
+        emit jointActualPositionChanged(m_jointActualPosition);
+        m_probedPosition = zero;
+        emit probedPositionChanged(m_probedPosition);
+        m_dtg = zero;
+        emit dtgChanged(m_dtg);
+        m_g5xOffset = zero;
+        emit g5xOffsetChanged(m_g5xOffset);
+        m_g92Offset = zero;
+        emit g92OffsetChanged(m_g92Offset);
+        m_motionAxis->clear();
+    }
+    else if (channel == IoChannel)
+    {
+        m_toolOffset = zero;
+        emit toolOffsetChanged(m_toolOffset);
+        m_toolTable->clear();
+    }
+}
 }; // namespace qtquickvcp
@@ -24,9 +24,15 @@
 
 #include <QObject>
 #include <QJsonObject>
+#include <QPointer>
+#include <QTimer>
+#include <QQuickWindow>
 #include <machinetalk/protobuf/message.pb.h>
 #include <machinetalk/protobuf/status.pb.h>
 #include <application/statusbase.h>
+#include <machinetalkservice.h>
+#include "applicationposition.h"
+#include "applicationstatusarray.h"
 
 namespace qtquickvcp {
 
@@ -38,9 +44,21 @@ class ApplicationStatus : public machinetalk::application::StatusBase
     Q_PROPERTY(QJsonObject io READ io NOTIFY ioChanged)
     Q_PROPERTY(QJsonObject task READ task NOTIFY taskChanged)
     Q_PROPERTY(QJsonObject interp READ interp NOTIFY interpChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition position READ position NOTIFY positionChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition actualPosition READ actualPosition NOTIFY actualPositionChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition jointPosition READ jointPosition NOTIFY jointPositionChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition jointActualPosition READ jointActualPosition NOTIFY jointActualPositionChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition probedPosition READ probedPosition NOTIFY probedPositionChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition dtg READ dtg NOTIFY dtgChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition g5xOffset READ g5xOffset NOTIFY g5xOffsetChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition g92Offset READ g92Offset NOTIFY g92OffsetChanged)
+    Q_PROPERTY(qtquickvcp::ApplicationPosition toolOffset READ toolOffset NOTIFY toolOffsetChanged)
+    Q_PROPERTY(QVariantList motionAxis READ motionAxis NOTIFY motionAxisChanged)
+    Q_PROPERTY(QVariantList toolTable READ toolTable NOTIFY toolTableChanged)
     Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
     Q_PROPERTY(bool synced READ isSynced NOTIFY syncedChanged)
     Q_PROPERTY(StatusChannels channels READ channels WRITE setChannels NOTIFY channelsChanged)
+    Q_PROPERTY(bool frameSynchronized READ isFrameSynchronized WRITE setFrameSynchronized NOTIFY frameSynchronizedChanged)
     Q_ENUMS(OriginIndex TrajectoryMode MotionStatus
             AxisType KinematicsType CanonUnits TaskExecState TaskState
             TaskMode InterpreterState InterpreterExitCode PositionOffset
@@ -195,6 +213,71 @@ public:
         return m_interp;
     }
 
+    ApplicationPosition position() const
+    {
+        return m_position;
+    }
+
+    ApplicationPosition actualPosition() const
+    {
+        return m_actualPosition;
+    }
+
+    ApplicationPosition jointPosition() const
+    {
+        return m_jointPosition;
+    }
+
+    ApplicationPosition jointActualPosition() const
+    {
+        return m_jointActualPosition;
+    }
+
+    ApplicationPosition probedPosition() const
+    {
+        return m_probedPosition;
+    }
+
+    ApplicationPosition dtg() const
+    {
+        return m_dtg;
+    }
+
+    ApplicationPosition g5xOffset() const
+    {
+        return m_g5xOffset;
+    }
+
+    ApplicationPosition g92Offset() const
+    {
+        return m_g92Offset;
+    }
+
+    ApplicationPosition toolOffset() const
+    {
+        return m_toolOffset;
+    }
+
+    QVariantList motionAxis() const
+    {
+        return m_motionAxis->elements();
+    }
+
+    QVariantList toolTable() const
+    {
+        return m_toolTable->elements();
+    }
+
+    ApplicationStatusArray *motionAxisArray() const
+    {
+        return m_motionAxis;
+    }
+
+    ApplicationStatusArray *toolTableArray() const
+    {
+        return m_toolTable;
+    }
+
     StatusChannels channels() const
     {
         return m_channels;
@@ -210,6 +293,11 @@ public:
         return m_synced;
     }
 
+    bool isFrameSynchronized() const
+    {
+        return m_frameSynchronized;
+    }
+
 public slots:
     void setChannels(StatusChannels arg)
     {
@@ -220,17 +308,38 @@ public slots:
         emit channelsChanged(arg);
     }
 
+    void setFrameSynchronized(bool frameSynchronized);
+
 private:
     QJsonObject     m_config;
     QJsonObject     m_motion;
     QJsonObject     m_io;
     QJsonObject     m_task;
     QJsonObject     m_interp;
+    ApplicationPosition m_position;
+    ApplicationPosition m_actualPosition;
+    ApplicationPosition m_jointPosition;
+    ApplicationPosition m_jointActualPosition;
+    ApplicationPosition m_probedPosition;
+    ApplicationPosition m_dtg;
+    ApplicationPosition m_g5xOffset;
+    ApplicationPosition m_g92Offset;
+    ApplicationPosition m_toolOffset;
+    ApplicationStatusArray *m_motionAxis;
+    ApplicationStatusArray *m_toolTable;
+    MachinetalkService::FieldSet m_motionSkipFields;
+    MachinetalkService::FieldSet m_ioSkipFields;
     bool            m_running;
     bool            m_synced;
     StatusChannels  m_syncedChannels;
     StatusChannels  m_channels;
     QHash<QByteArray, StatusChannel> m_channelMap;
+    bool            m_frameSynchronized;
+    bool            m_framePending;
+    QPointer<QQuickWindow> m_frameWindow;
+    QTimer          m_frameTimer;
+    StatusChannels  m_pendingChannels;
+    machinetalk::Container m_pendingUpdate;
 
     void emcstatUpdateReceived(StatusChannel channel, const machinetalk::Container &rx);
     void updateSync(StatusChannel channel);
@@ -239,7 +348,12 @@ private:
     void updateIoObject(const machinetalk::EmcStatusIo &io);
     void updateTaskObject(const machinetalk::EmcStatusTask &task);
     void updateInterpObject(const machinetalk::EmcStatusInterp &interp);
+    void updateMotionPositions(const machinetalk::EmcStatusMotion &motion);
     void initializeObject(StatusChannel channel);
+    void initializeValues(StatusChannel channel);
+    void bufferUpdate(StatusChannel channel, const machinetalk::Container &rx);
+    void requestFrame();
+    QQuickWindow *findFrameWindow() const;
 
 
 private slots:
@@ -250,6 +364,7 @@ private slots:
     void updateTopics();
 
     void updateRunning(const QJsonObject &object);
+    void publishPendingUpdates();
 
 signals:
     void configChanged(const QJsonObject &arg);
@@ -257,9 +372,22 @@ signals:
     void ioChanged(const QJsonObject &arg);
     void taskChanged(const QJsonObject &arg);
     void interpChanged(const QJsonObject &arg);
+    void positionChanged(const qtquickvcp::ApplicationPosition &position);
+    void actualPositionChanged(const qtquickvcp::ApplicationPosition &actualPosition);
+    void jointPositionChanged(const qtquickvcp::ApplicationPosition &jointPosition);
+    void jointActualPositionChanged(const qtquickvcp::ApplicationPosition &jointActualPosition);
+    void probedPositionChanged(const qtquickvcp::ApplicationPosition &probedPosition);
+    void dtgChanged(const qtquickvcp::ApplicationPosition &dtg);
+    void g5xOffsetChanged(const qtquickvcp::ApplicationPosition &g5xOffset);
+    void g92OffsetChanged(const qtquickvcp::ApplicationPosition &g92Offset);
+    void toolOffsetChanged(const qtquickvcp::ApplicationPosition &toolOffset);
+    void motionAxisChanged(const QVariantList &motionAxis);
+    void toolTableChanged(const QVariantList &toolTable);
     void channelsChanged(StatusChannels arg);
     void runningChanged(bool arg);
     void syncedChanged(bool arg);
+    void frameSynchronizedChanged(bool frameSynchronized);
+    void statusUpdateReceived(qtquickvcp::ApplicationStatus::StatusChannel channel, const machinetalk::Container &rx);
 }; // class ApplicationStatus
 } // namespace qtquickvcp
 
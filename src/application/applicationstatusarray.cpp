@@ -0,0 +1,239 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "applicationstatusarray.h"
+#include <QQmlEngine>
+#include <machinetalkservice.h>
+
+#if defined(Q_OS_IOS)
+namespace gpb = google_public::protobuf;
+#else
+namespace gpb = google::protobuf;
+#endif
+
+namespace qtquickvcp {
+
+/** Index addressed container for the elements of a repeated status field
+ *
+ *  Every element is a QQmlPropertyMap whose values are patched in place
+ *  when an incremental update arrives. Bindings in QML only re-evaluate for
+ *  the values that actually changed, the element list itself only changes
+ *  when elements are added or removed. C++ consumers can use the
+ *  elementChanged signal to get the changed keys of an element.
+ **/
+ApplicationStatusArray::ApplicationStatusArray(QObject *parent) :
+    QObject(parent)
+{
+}
+
+ApplicationStatusArray::~ApplicationStatusArray()
+{
+    qDeleteAll(m_elements);
+}
+
+/** Returns the element at index or nullptr if the index is out of range */
+QObject *ApplicationStatusArray::at(int index) const
+{
+    return element(index);
+}
+
+/** Patches the elements with the values of the repeated message field
+ *  elements containing only the index field are removed
+ **/
+void ApplicationStatusArray::update(const gpb::Message &message, const gpb::FieldDescriptor *field, const QString &tempDir)
+{
+    const gpb::Reflection *reflection = message.GetReflection();
+    const int fieldSize = reflection->FieldSize(message, field);
+    QList<int> removeList;
+    bool structureChanged = false;
+
+    for (int i = 0; i < fieldSize; ++i)
+    {
+        const gpb::Message &subMessage = reflection->GetRepeatedMessage(message, field, i);
+        const gpb::Descriptor *subDescriptor = subMessage.GetDescriptor();
+        const gpb::FieldDescriptor *indexField = subDescriptor->FindFieldByName("index");
+        const gpb::Reflection *subReflection = subMessage.GetReflection();
+        const int index = subReflection->GetInt32(subMessage, indexField);
+        gpb::vector<const gpb::FieldDescriptor*> setFields;
+
+        subReflection->ListFields(subMessage, &setFields);
+        if (setFields.size() < 2) // only index -> remove element
+        {
+            removeList.append(index);
+            continue;
+        }
+
+        while (m_elements.size() < (index + 1))
+        {
+            m_elements.append(createElement(subDescriptor, m_elements.size()));
+            structureChanged = true;
+        }
+
+        const QStringList changedKeys = updateElement(m_elements.at(index), subMessage, tempDir);
+        if (!changedKeys.isEmpty())
+        {
+            emit elementChanged(index, changedKeys);
+        }
+    }
+
+    if (!removeList.isEmpty())
+    {
+        qSort(removeList.begin(), removeList.end());
+        for (int k = (removeList.size() - 1); k >= 0; --k)
+        {
+            const int index = removeList.at(k);
+            if (index < m_elements.size())
+            {
+                m_elements.takeAt(index)->deleteLater();
+                structureChanged = true;
+            }
+        }
+
+        for (int i = removeList.first(); i < m_elements.size(); ++i)
+        {
+            m_elements.at(i)->insert("index", i);
+        }
+    }
+
+    if (structureChanged)
+    {
+        updateElementList();
+    }
+}
+
+void ApplicationStatusArray::clear()
+{
+    if (m_elements.isEmpty())
+    {
+        return;
+    }
+
+    for (QQmlPropertyMap *element: m_elements)
+    {
+        element->deleteLater();
+    }
+    m_elements.clear();
+    updateElementList();
+}
+
+QQmlPropertyMap *ApplicationStatusArray::createElement(const gpb::Descriptor *descriptor, int index)
+{
+    QQmlPropertyMap *element = new QQmlPropertyMap(this);
+    QJsonObject object;
+
+    QQmlEngine::setObjectOwnership(element, QQmlEngine::CppOwnership);
+
+    MachinetalkService::recurseDescriptor(descriptor, &object);
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it)
+    {
+        element->insert(it.key(), it.value().toVariant());
+    }
+    element->insert("index", index);
+
+    return element;
+}
+
+/** Writes the fields present in the message to the element, returns the names of changed values */
+QStringList ApplicationStatusArray::updateElement(QQmlPropertyMap *element, const gpb::Message &message, const QString &tempDir)
+{
+    const gpb::Reflection *reflection = message.GetReflection();
+    gpb::vector<const gpb::FieldDescriptor*> output;
+    QStringList changedKeys;
+
+    reflection->ListFields(message, &output);
+
+    for (int i = 0; i < (int)output.size(); ++i)
+    {
+        const gpb::FieldDescriptor *field = output[i];
+        const QString name = QString::fromStdString(field->camelcase_name());
+        QVariant value;
+
+        if (name == QLatin1String("index")) {
+            continue;
+        }
+
+        if (field->is_repeated() || (field->cpp_type() == gpb::FieldDescriptor::CPPTYPE_MESSAGE))
+        {
+            // nested values use the same conversion as the JSON status objects
+            QJsonObject object;
+            object.insert(name, QJsonValue::fromVariant(element->value(name)));
+            MachinetalkService::recurseMessage(message, &object, name, tempDir);
+            value = object.value(name).toVariant();
+        }
+        else
+        {
+            switch (field->cpp_type())
+            {
+            case gpb::FieldDescriptor::CPPTYPE_BOOL:
+                value = reflection->GetBool(message, field);
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_DOUBLE:
+                value = reflection->GetDouble(message, field);
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_FLOAT:
+                value = (double)reflection->GetFloat(message, field);
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_INT32:
+                value = (int)reflection->GetInt32(message, field);
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_INT64:
+                value = (int)reflection->GetInt64(message, field);
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_UINT32:
+                value = (int)reflection->GetUInt32(message, field);
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_UINT64:
+                value = (int)reflection->GetUInt64(message, field);
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_STRING:
+                value = QString::fromStdString(reflection->GetString(message, field));
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_ENUM:
+                value = reflection->GetEnum(message, field)->number();
+                break;
+            case gpb::FieldDescriptor::CPPTYPE_MESSAGE:
+                break;
+            }
+        }
+
+        if (element->value(name) != value)
+        {
+            element->insert(name, value); // notifies bindings of this key only
+            changedKeys.append(name);
+        }
+    }
+
+    return changedKeys;
+}
+
+void ApplicationStatusArray::updateElementList()
+{
+    m_elementList.clear();
+    m_elementList.reserve(m_elements.size());
+    for (QQmlPropertyMap *element: m_elements)
+    {
+        m_elementList.append(QVariant::fromValue<QObject*>(element));
+    }
+
+    emit countChanged(m_elements.size());
+    emit elementsChanged(m_elementList);
+}
+}; // namespace qtquickvcp
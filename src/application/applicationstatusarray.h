@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef APPLICATIONSTATUSARRAY_H
+#define APPLICATIONSTATUSARRAY_H
+
+#include <QObject>
+#include <QList>
+#include <QVariant>
+#include <QStringList>
+#include <QQmlPropertyMap>
+#include <google/protobuf/message.h>
+#include <google/protobuf/descriptor.h>
+
+namespace qtquickvcp {
+
+class ApplicationStatusArray : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(QVariantList elements READ elements NOTIFY elementsChanged)
+
+public:
+    explicit ApplicationStatusArray(QObject *parent = 0);
+    ~ApplicationStatusArray();
+
+    int count() const
+    {
+        return m_elements.size();
+    }
+
+    QVariantList elements() const
+    {
+        return m_elementList;
+    }
+
+    QQmlPropertyMap *element(int index) const
+    {
+        return m_elements.value(index, nullptr);
+    }
+
+    Q_INVOKABLE QObject *at(int index) const;
+
+    void update(const google::protobuf::Message &message,
+                const google::protobuf::FieldDescriptor *field,
+                const QString &tempDir = QString("json"));
+    void clear();
+
+private:
+    QList<QQmlPropertyMap*> m_elements;
+    QVariantList            m_elementList;
+
+    QQmlPropertyMap *createElement(const google::protobuf::Descriptor *descriptor, int index);
+    QStringList updateElement(QQmlPropertyMap *element,
+                              const google::protobuf::Message &message,
+                              const QString &tempDir);
+    void updateElementList();
+
+signals:
+    void countChanged(int count);
+    void elementsChanged(const QVariantList &elements);
+    void elementChanged(int index, const QStringList &keys);
+}; // class ApplicationStatusArray
+} // namespace qtquickvcp
+
+#endif // APPLICATIONSTATUSARRAY_H
@@ -32,6 +32,7 @@
 #include "applicationlauncher.h"
 #include "applicationplugins.h"
 #include "applicationpluginitem.h"
+#include "applicationposition.h"
 #include "localsettings.h"
 #include "fileio.h"
 #include "revisionsingleton.h"
@@ -65,6 +66,8 @@ void MachinekitApplicationPlugin::registerTypes(const char *uri)
 
     // @uri Machinekit.Application
     Q_ASSERT(uri == QLatin1String("Machinekit.Application"));
+    qRegisterMetaType<qtquickvcp::ApplicationPosition>();
+
     qmlRegisterType<qtquickvcp::ApplicationConfig>(uri, 1, 0, "ApplicationConfig");
     qmlRegisterType<qtquickvcp::ApplicationConfigItem>(uri, 1, 0, "ApplicationConfigItem");
     qmlRegisterType<qtquickvcp::ApplicationConfigFilter>(uri, 1, 0, "ApplicationConfigFilter");
@@ -33,15 +33,15 @@ ApplicationItem {
     property string prefix: ""
     property string suffix: ""
     property int axes: axisNames.length
-    property var axisHomed: _ready ? status.motion.axis : [{"homed":false}, {"homed":false}, {"homed":false}, {"homed":false}]
+    property var axisHomed: _ready ? status.motionAxis : [{"homed":false}, {"homed":false}, {"homed":false}, {"homed":false}]
     property var axisNames: helper.ready ? helper.axisNamesUpper : ["X", "Y", "Z", "A"]
     property var g5xNames: ["G54", "G55", "G56", "G57", "G58", "G59", "G59.1", "G59.2", "G59.3"]
     property int g5xIndex: _ready ? status.motion.g5xIndex : 1
     property var position: getPosition()
-    property var dtg: _ready ? scalePosition(status.motion.dtg) : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
-    property var g5xOffset: _ready ? scalePosition(status.motion.g5xOffset) : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
-    property var g92Offset: _ready ? scalePosition(status.motion.g92Offset) : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
-    property var toolOffset: _ready ? scalePosition(status.io.toolOffset) : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
+    property var dtg: _ready ? status.dtg.scaled(_distanceFactor) : _zeroPosition
+    property var g5xOffset: _ready ? status.g5xOffset.scaled(_distanceFactor) : _zeroPosition
+    property var g92Offset: _ready ? status.g92Offset.scaled(_distanceFactor) : _zeroPosition
+    property var toolOffset: _ready ? status.toolOffset.scaled(_distanceFactor) : _zeroPosition
     property double velocity: _ready ? status.motion.currentVel * _timeFactor * _distanceFactor : 0.0
     property double distanceToGo: _ready ? status.motion.distanceToGo * _distanceFactor : 0.0
     property bool offsetsVisible: settings.initialized && settings.values.dro.showOffsets
@@ -55,35 +55,19 @@ ApplicationItem {
     property double _timeFactor: helper.ready ? helper.timeFactor : 1
     property double _distanceFactor: helper.ready ? helper.distanceFactor : 1
     property string _distanceUnits: helper.ready ? helper.distanceUnits: "mm"
-
-    function scalePosition(pos)
-    {
-        var newPos = {};
-        for (var i = 0; i < axes; ++i) {
-            var axisName = _axisNames[i];
-            newPos[axisName] = pos[axisName] * _distanceFactor;
-        }
-        return newPos;
-    }
+    readonly property var _zeroPosition: {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
 
     function getPosition() {
-        var basePosition;
-        if (_ready) {
-            basePosition = (positionFeedback === ApplicationStatus.ActualPositionFeedback) ? status.motion.actualPosition : status.motion.position;
-            basePosition = scalePosition(basePosition);
-        }
-        else {
-            basePosition = { "x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0 };
+        if (!_ready) {
+            return _zeroPosition;
         }
 
+        var basePosition = (positionFeedback === ApplicationStatus.ActualPositionFeedback) ? status.actualPosition : status.position;
         if (positionOffset === ApplicationStatus.RelativePositionOffset) {
-            for (var i = 0; i < axes; ++i) {
-                var axisName = _axisNames[i];
-                basePosition[axisName] -= g5xOffset[axisName] + g92Offset[axisName] + toolOffset[axisName];
-            }
+            basePosition = basePosition.minus(status.g5xOffset).minus(status.g92Offset).minus(status.toolOffset);
         }
 
-        return basePosition;
+        return basePosition.scaled(_distanceFactor);
     }
 
     id: droRect
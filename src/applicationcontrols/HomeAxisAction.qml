@@ -26,13 +26,13 @@ import Machinekit.Application 1.0
 
 ApplicationAction {
     property int axis: 0
-    property bool homed: _ready ? (axis > -1 ? status.motion.axis[axis].homed : _allHomed()) : false
+    property bool homed: _ready ? (axis > -1 ? status.motionAxis[axis].homed : _allHomed()) : false
 
     property bool _ready: status.synced && command.connected
 
     function _allHomed() {
         for (var i = 0; i < status.config.axes; ++i) {
-            if (!status.motion.axis[i].homed) {
+            if (!status.motionAxis[i].homed) {
                 return false;
             }
         }
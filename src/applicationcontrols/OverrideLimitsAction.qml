@@ -29,8 +29,8 @@ ApplicationAction {
 
     property bool _ready: status.synced && command.connected
     property bool _axisOnLimit: status.synced
-                                 && status.motion.axis[root.axis].minSoftLimit
-                                 && status.motion.axis[root.axis].maxSoftLimit
+                                 && status.motionAxis[root.axis].minSoftLimit
+                                 && status.motionAxis[root.axis].maxSoftLimit
 
     id: root
     text: qsTr("Override Limits")
@@ -44,7 +44,7 @@ ApplicationAction {
     }
 
     checkable: true
-    checked: _ready ? (status.motion.axis[root.axis].overrideLimits) : false
+    checked: _ready ? (status.motionAxis[root.axis].overrideLimits) : false
     enabled: _ready
              && (status.task.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
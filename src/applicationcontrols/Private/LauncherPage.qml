@@ -181,8 +181,7 @@ Item {
                     var running = false;
 
                     for (var i = 0; i < items.length; ++i) {
-                        items[i].index = i;  // store the original index
-                        if (items[i].running) {
+                        if (items[i].running) {  // items store their original index
                             running = true;
                             var item = items[i];  // move the running items to the front
                             items.splice(i, 1);
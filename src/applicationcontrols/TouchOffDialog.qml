@@ -57,7 +57,7 @@ Dialog {
                 command.setTaskMode('execute', ApplicationCommand.TaskModeMdi);
             }
             var axisName = _axisNames[axis];
-            var position = status.motion.position[axisName] - status.motion.g92Offset[axisName] - status.io.toolOffset[axisName];
+            var position = status.position.minus(status.g92Offset).minus(status.toolOffset).axis(axisName);
             var newOffset = (position - coordinateSpin.value);
             var mdi = "G10 L2 P" + (coordinateSystemCombo.currentIndex + 1) + " " + axisNames[axis] + newOffset.toFixed(6);
             command.executeMdi('execute', mdi);
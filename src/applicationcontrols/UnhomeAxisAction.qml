@@ -47,7 +47,7 @@ ApplicationAction {
         }
         else {
             for (var i = 0; i < status.config.axes; ++i) {
-                if (status.motion.axis[i].homed) {
+                if (status.motionAxis[i].homed) {
                     command.unhomeAxis(i);
                 }
             }
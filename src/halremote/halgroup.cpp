@@ -0,0 +1,394 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "halgroup.h"
+#include "halremotecomponent.h"
+#include "debughelper.h"
+
+using namespace machinetalk;
+
+namespace qtquickvcp {
+/*!
+    \qmltype HalGroup
+    \instantiates QHalGroup
+    \inqmlmodule Machinekit.HalRemote
+    \brief A HAL group monitor.
+    \ingroup halremote
+
+    This component monitors the signals of a HAL group
+    in the HAL real-time environment. The HalGroup connects
+    to the halgroup service provided by a Haltalk instance
+    running on the remote host and subscribes to the group
+    with the given \l name.
+
+    In contrast to a \l HalRemoteComponent no component needs
+    to be bound and the HAL netlist stays untouched. The signal
+    values are read-only.
+
+    All \l{HalSignal}s located below the \l containerItem are
+    updated with the values of the group members having the same
+    name. Group members without a matching HalSignal are reflected
+    by \l halSignals.
+
+    \qml
+    Item {
+        Item {
+            id: container
+
+            HalSignal {
+                id: spindleSpeed
+                name: "spindle-speed"
+            }
+        }
+
+        HalGroup {
+            name: "diagnostics"
+            halgroupUri: "tcp://192.168.1.2:5003"
+            containerItem: container
+            ready: true
+        }
+    }
+    \endqml
+*/
+
+/*! \qmlproperty string HalGroup::halgroupUri
+
+    This property holds the halgroup service uri.
+*/
+
+/*! \qmlproperty string HalGroup::name
+
+    This property holds the name of the HAL group.
+*/
+
+/*! \qmlproperty bool HalGroup::ready
+
+    This property holds whether the HalGroup is ready or not.
+    If the property is set to \c true the group will try to connect. If the
+    property is set to \c false all connections will be closed.
+
+    The default value is \c{false}.
+*/
+
+/*! \qmlproperty bool HalGroup::connected
+
+    This property holds whether the HAL group is connected or not.
+*/
+
+/*! \qmlproperty Item HalGroup::containerItem
+
+    This property holds the item that contains the \l{HalSignal}s
+    that should be updated.
+
+    The default value is the HalGroup itself.
+*/
+
+/*! \qmlproperty string HalGroup::errorString
+
+    This property holds a text description of the last error
+    reported by the halgroup service. When an error is received
+    all signals are marked as not synced and \l connected is
+    set to \c false until the next full update is received.
+*/
+
+/*! \qmlproperty list<HalSignal> HalGroup::halSignals
+
+    This property holds a list of HAL signals when connected.
+*/
+
+QList<HalGroup*> HalGroup::s_groups;
+
+/** HAL group implementation for use with C++ and QML */
+HalGroup::HalGroup(QObject *parent) :
+    halremote::HalgroupBase(parent),
+    m_name("default"),
+    m_connected(false),
+    m_containerItem(this),
+    m_containerSignalsValid(false)
+{
+    s_groups.append(this);
+}
+
+HalGroup::~HalGroup()
+{
+    s_groups.removeAll(this);
+}
+
+/** Adds or removes a completed or moved signal to the groups containing it */
+void HalGroup::updateContainerRegistration(HalSignal *signal)
+{
+    foreach (HalGroup *group, s_groups)
+    {
+        if (!group->m_containerSignalsValid) // the signals are collected on the next connect
+        {
+            continue;
+        }
+
+        const int index = group->m_containerSignals.indexOf(signal);
+        const bool contained = group->isContainerChild(signal);
+        if (contained && (index == -1))
+        {
+            group->m_containerSignals.append(signal);
+        }
+        else if (!contained && (index != -1))
+        {
+            group->m_containerSignals.removeAt(index);
+        }
+    }
+}
+
+void HalGroup::removeContainerRegistration(HalSignal *signal)
+{
+    foreach (HalGroup *group, s_groups)
+    {
+        group->m_containerSignals.removeAll(signal);
+    }
+}
+
+/** Checks whether the object is located below the container item */
+bool HalGroup::isContainerChild(const QObject *object) const
+{
+    QObject *parent = HalRemoteComponent::containerParent(object);
+
+    while (parent != nullptr)
+    {
+        if (parent == m_containerItem)
+        {
+            return true;
+        }
+        parent = HalRemoteComponent::containerParent(parent);
+    }
+
+    return false;
+}
+
+/** Updates the list of signals located below the container item
+ *  All signals are only looked up when the container item has changed,
+ *  afterwards the signals register and unregister themselves with the
+ *  groups containing them.
+ */
+void HalGroup::updateContainerSignals()
+{
+    if (m_containerSignalsValid)
+    {
+        // a QObject::setParent of a signal itself is not notified, drop signals moved away
+        for (int i = (m_containerSignals.size() - 1); i >= 0; --i)
+        {
+            if (!isContainerChild(m_containerSignals.at(i)))
+            {
+                m_containerSignals.removeAt(i);
+            }
+        }
+        return;
+    }
+
+    m_containerSignals.clear();
+    foreach (HalSignal *signal, HalSignal::registeredSignals())
+    {
+        if (isContainerChild(signal))
+        {
+            m_containerSignals.append(signal);
+        }
+    }
+    m_containerSignalsValid = true;
+}
+
+/** Adds all signals registered below the container item to a map */
+void HalGroup::addSignals()
+{
+    if (m_containerItem == nullptr)
+    {
+        return;
+    }
+
+    updateContainerSignals();
+    foreach (HalSignal *signal, m_containerSignals)
+    {
+        if (signal->name().isEmpty() || (signal->enabled() == false))    // ignore signals with empty name and disabled signals
+        {
+            continue;
+        }
+        m_signalsByName[signal->name()] = signal;
+        m_signals.append(signal);
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_name, "signal added: " << signal->name())
+#endif
+    }
+
+    emit halSignalsChanged(halSignals());
+}
+
+/** Removes all previously added signals */
+void HalGroup::removeSignals()
+{
+    foreach (HalSignal *signal, m_signalsByName)
+    {
+        if (signal->parent() == this) // signal was created by this class
+        {
+            signal->deleteLater();
+        }
+    }
+
+    m_signalsByHandle.clear();
+    m_signalsByName.clear();
+    m_signals.clear();
+    emit halSignalsChanged(halSignals());
+}
+
+/** Updates a local signal with the value of a remote signal */
+void HalGroup::signalUpdate(const Signal &remoteSignal, HalSignal *localSignal)
+{
+#ifdef QT_DEBUG
+    DEBUG_TAG(2, m_name,  "signal update" << localSignal->name() << remoteSignal.halfloat() << remoteSignal.halbit() << remoteSignal.hals32() << remoteSignal.halu32())
+#endif
+
+    if (remoteSignal.has_halfloat())
+    {
+        localSignal->setValue(QVariant(remoteSignal.halfloat()));
+    }
+    else if (remoteSignal.has_halbit())
+    {
+        localSignal->setValue(QVariant(remoteSignal.halbit()));
+    }
+    else if (remoteSignal.has_hals32())
+    {
+        localSignal->setValue(QVariant(remoteSignal.hals32()));
+    }
+    else if (remoteSignal.has_halu32())
+    {
+        localSignal->setValue(QVariant(remoteSignal.halu32()));
+    }
+}
+
+/** Adds a local signal based on remote signal representation **/
+HalSignal *HalGroup::addLocalSignal(const Signal &remoteSignal)
+{
+    QString name = QString::fromStdString(remoteSignal.name());
+    HalSignal *localSignal = new HalSignal(this);
+    localSignal->setName(name);
+    m_signalsByName[name] = localSignal;
+    m_signals.append(localSignal);
+
+    return localSignal;
+}
+
+void HalGroup::halgroupFullUpdateReceived(const QByteArray &topic, const Container &rx)
+{
+    Q_UNUSED(topic);
+    bool signalsAdded = false;
+
+    if (rx.group_size() == 0) // empty message
+    {
+        return;
+    }
+
+    const Group &group = rx.group(0);
+    for (int i = 0; i < group.member_size(); ++i)
+    {
+        const Member &member = group.member(i);
+        if (!member.has_signal())   // nested groups, pins and params are not monitored
+        {
+            continue;
+        }
+
+        const Signal &remoteSignal = member.signal();
+        QString name = QString::fromStdString(remoteSignal.name());
+        HalSignal *localSignal = m_signalsByName.value(name, nullptr);
+        if (localSignal == nullptr)
+        {
+            localSignal = addLocalSignal(remoteSignal);
+            signalsAdded = true;
+        }
+
+        localSignal->setType(static_cast<HalSignal::ValueType>(remoteSignal.type()));
+        localSignal->setHandle(static_cast<int>(remoteSignal.handle()));
+        m_signalsByHandle.insert(static_cast<int>(remoteSignal.handle()), localSignal);
+        signalUpdate(remoteSignal, localSignal);
+        localSignal->setSynced(true);
+    }
+
+    if (signalsAdded)
+    {
+        emit halSignalsChanged(halSignals());
+    }
+
+    if ((state() == Up) && !m_connected) // recovered from an error reported by the service
+    {
+        syncSignals();
+    }
+
+    channelsSynced();
+}
+
+void HalGroup::halgroupIncrementalUpdateReceived(const QByteArray &topic, const Container &rx)
+{
+    Q_UNUSED(topic);
+
+    // one message carries all signals changed since the last update
+    for (int i = 0; i < rx.signal_size(); ++i)
+    {
+        const Signal &remoteSignal = rx.signal(i);
+        HalSignal *localSignal = m_signalsByHandle.value(static_cast<int>(remoteSignal.handle()), nullptr);
+        if (localSignal != nullptr) // in case we received a wrong signal handle
+        {
+            signalUpdate(remoteSignal, localSignal);
+        }
+    }
+}
+
+void HalGroup::halgroupErrorReceived(const QByteArray &topic, const Container &rx)
+{
+    Q_UNUSED(topic);
+    Q_UNUSED(rx);
+
+    // the error string is updated by the base, the signal values are no longer valid
+    DEBUG_TAG(1, m_name, "halgroup error" << errorString())
+    unsyncSignals();
+}
+
+void HalGroup::syncSignals()
+{
+    m_connected = true;
+    emit connectedChanged(m_connected);
+}
+
+void HalGroup::unsyncSignals()
+{
+    foreach (HalSignal *signal, m_signals)
+    {
+        signal->setSynced(false);
+    }
+
+    if (m_connected)
+    {
+        m_connected = false;
+        emit connectedChanged(m_connected);
+    }
+}
+
+void HalGroup::updateTopics()
+{
+    removeSignals();
+    clearHalgroupTopics();
+    addHalgroupTopic(m_name);
+    addSignals();
+}
+}; // namespace qtquickvcp
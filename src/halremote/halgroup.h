@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef HALGROUP_H
+#define HALGROUP_H
+
+#include <QObject>
+#include <QQmlListProperty>
+#include <machinetalk/protobuf/message.pb.h>
+#include <halremote/halgroupbase.h>
+#include "halsignal.h"
+
+namespace qtquickvcp {
+
+class HalGroup : public machinetalk::halremote::HalgroupBase
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(bool connected READ isConnected NOTIFY connectedChanged)
+    Q_PROPERTY(QObject *containerItem READ containerItem WRITE setContainerItem NOTIFY containerItemChanged)
+    Q_PROPERTY(QQmlListProperty<qtquickvcp::HalSignal> halSignals READ halSignals NOTIFY halSignalsChanged)
+
+public:
+    explicit HalGroup(QObject *parent = 0);
+    ~HalGroup();
+
+    QString name() const
+    {
+        return m_name;
+    }
+
+    bool isConnected() const
+    {
+        return m_connected;
+    }
+
+    QObject *containerItem() const
+    {
+        return m_containerItem;
+    }
+
+    QQmlListProperty<HalSignal> halSignals()
+    {
+        return QQmlListProperty<HalSignal>(this, m_signals);
+    }
+
+    int signalCount() const
+    {
+        return m_signals.count();
+    }
+
+    HalSignal *signal(int index) const
+    {
+        return m_signals.at(index);
+    }
+
+    static void updateContainerRegistration(HalSignal *signal);
+    static void removeContainerRegistration(HalSignal *signal);
+
+public slots:
+    void setName(QString name)
+    {
+        if (this->state() != Down) {
+            return;
+        }
+
+        if (m_name != name) {
+            m_name = name;
+            emit nameChanged(name);
+        }
+    }
+
+    void setContainerItem(QObject *containerItem)
+    {
+        if (m_containerItem == containerItem) {
+            return;
+        }
+
+        m_containerItem = containerItem;
+        m_containerSignalsValid = false; // the signal list is collected again on the next connect
+        emit containerItemChanged(containerItem);
+    }
+
+private:
+    QString         m_name;
+    bool            m_connected;
+    QObject*        m_containerItem;
+
+    QMap<QString, HalSignal*> m_signalsByName;
+    QHash<int, HalSignal*>    m_signalsByHandle;
+    QList<HalSignal*>         m_signals;
+    QList<HalSignal*>         m_containerSignals;
+    bool                      m_containerSignalsValid;
+
+    static QList<HalGroup*> s_groups;
+
+    void updateContainerSignals();
+    bool isContainerChild(const QObject *object) const;
+    void addSignals();
+    void removeSignals();
+    void signalUpdate(const machinetalk::Signal &remoteSignal, HalSignal *localSignal);
+    HalSignal *addLocalSignal(const machinetalk::Signal &remoteSignal);
+
+    // HalgroupBase interface
+private slots:
+    void halgroupFullUpdateReceived(const QByteArray &topic, const machinetalk::Container &rx);
+    void halgroupIncrementalUpdateReceived(const QByteArray &topic, const machinetalk::Container &rx);
+    void halgroupErrorReceived(const QByteArray &topic, const machinetalk::Container &rx);
+    void syncSignals();
+    void unsyncSignals();
+    void updateTopics();
+
+signals:
+    void nameChanged(QString name);
+    void connectedChanged(bool connected);
+    void containerItemChanged(QObject *containerItem);
+    void halSignalsChanged(QQmlListProperty<HalSignal> arg);
+}; // class HalGroup
+} // namespace qtquickvcp
+
+#endif // HALGROUP_H
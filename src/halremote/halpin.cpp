@@ -20,6 +20,7 @@
 **
 ****************************************************************************/
 #include "halpin.h"
+#include "halremotecomponent.h"
 
 namespace qtquickvcp {
 
@@ -124,6 +125,9 @@ namespace qtquickvcp {
     to \c true when the echo from the \l HalRemoteComponent is received.
 */
 
+QMap<int, HalPin*> HalPin::s_registeredPins;
+int HalPin::s_registryIndex = 0;
+
 HalPin::HalPin(QObject *parent) :
     QObject(parent),
     m_name("default"),
@@ -133,8 +137,39 @@ HalPin::HalPin(QObject *parent) :
     m_syncValue(false),
     m_handle(0),
     m_enabled(true),
-    m_synced(false)
+    m_synced(false),
+    m_registryIndex(s_registryIndex++)
 {
+    s_registeredPins.insert(m_registryIndex, this);
+
+    if (parent != nullptr)  // pins created from C++ are not completed by the QML engine
+    {
+        updateRegistration();
+    }
+}
+
+HalPin::~HalPin()
+{
+    s_registeredPins.remove(m_registryIndex);
+    HalRemoteComponent::removeContainerRegistration(this);
+}
+
+void HalPin::componentComplete()
+{
+    updateRegistration();
+}
+
+/** Registers the pin with the components containing it
+ *  and follows the parents of the pin to notice when it is moved.
+ */
+void HalPin::updateRegistration()
+{
+    foreach (const QMetaObject::Connection &connection, m_parentConnections)
+    {
+        disconnect(connection);
+    }
+    m_parentConnections = HalRemoteComponent::connectContainerParents(this, SLOT(updateRegistration()));
+    HalRemoteComponent::updateContainerRegistration(this);
 }
 
 void HalPin::setType(HalPin::HalPinType arg)
@@ -24,13 +24,17 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QMap>
+#include <QList>
+#include <QQmlParserStatus>
 #include <machinetalk/protobuf/message.pb.h>
 
 namespace qtquickvcp {
 
-class HalPin : public QObject
+class HalPin : public QObject, public QQmlParserStatus
 {
     Q_OBJECT
+    Q_INTERFACES(QQmlParserStatus)
     Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
     Q_PROPERTY(HalPinType type READ type WRITE setType NOTIFY typeChanged)
     Q_PROPERTY(HalPinDirection direction READ direction WRITE setDirection NOTIFY directionChanged)
@@ -43,6 +47,7 @@ class HalPin : public QObject
 
 public:
     explicit HalPin(QObject *parent = 0);
+    ~HalPin();
 
     enum HalPinType {
         Bit = machinetalk::HAL_BIT,
@@ -92,6 +97,15 @@ public:
         return m_synced;
     }
 
+    /** all existing pins in order of creation */
+    static const QMap<int, HalPin*> &registeredPins()
+    {
+        return s_registeredPins;
+    }
+
+    void classBegin() {}
+    void componentComplete();
+
 signals:
 
     void nameChanged(QString arg);
@@ -112,6 +126,9 @@ void setHandle(int arg);
 void setEnabled(bool arg);
 void setSynced(bool arg);
 
+private slots:
+    void updateRegistration();
+
 private:
     QString         m_name;
     HalPinType       m_type;
@@ -121,6 +138,11 @@ private:
     int             m_handle;
     bool            m_enabled;
     bool            m_synced;
+    int             m_registryIndex;
+    QList<QMetaObject::Connection> m_parentConnections;
+
+    static QMap<int, HalPin*> s_registeredPins;
+    static int                s_registryIndex;
 }; // class HalPin
 } // namespace qtquickvcp
 
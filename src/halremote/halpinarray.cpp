@@ -0,0 +1,368 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "halpinarray.h"
+#include "halremotecomponent.h"
+
+namespace qtquickvcp {
+
+/*!
+    \qmltype HalPinArray
+    \instantiates QHalPinArray
+    \inqmlmodule Machinekit.HalRemote
+    \brief An array of HAL pins.
+    \ingroup halremote
+
+    This component provides the counterpart of \l count pins of
+    a HAL remote component named \c{name.0} to \c{name.N-1}. The
+    values of all pins are stored in one contiguous buffer and
+    all changes of an update are reported at once.
+
+    The HalPinArray is a list model and can be used directly as model
+    for views and repeaters. A change of the pin values only updates the
+    delegates inside the changed range.
+
+    \qml
+    HalPinArray {
+        id: temperatures
+        name: "temperature"
+        type: HalPin.Float
+        direction: HalPin.In
+        count: 64
+    }
+
+    Repeater {
+        model: temperatures
+        Label { text: model.name + ": " + model.value.toFixed(1) }
+    }
+    \endqml
+
+    \sa HalPin, HalRemoteComponent
+*/
+
+/*! \qmlproperty string HalPinArray::name
+
+    This property holds the base name of the HAL pins.
+*/
+
+/*! \qmlproperty enumeration HalPinArray::type
+
+    This property holds the type of the HAL pins. See \l{HalPin::type}.
+*/
+
+/*! \qmlproperty enumeration HalPinArray::direction
+
+    This property holds the direction of the HAL pins. See \l{HalPin::direction}.
+*/
+
+/*! \qmlproperty int HalPinArray::count
+
+    This property holds the number of pins.
+
+    The default value is \c{0}.
+*/
+
+/*! \qmlproperty bool HalPinArray::enabled
+
+    This property holds whether the pin array is enabled or not.
+
+    The default value is \c{true}.
+*/
+
+/*! \qmlproperty bool HalPinArray::synced
+
+    This property holds whether the pin array is synced or not.
+*/
+
+/*! \qmlsignal HalPinArray::valuesChanged(int first, int last)
+
+    This signal is emitted once per update for the range of
+    pins from \a first to \a last that have changed their values.
+*/
+
+QMap<int, HalPinArray*> HalPinArray::s_registeredPinArrays;
+int HalPinArray::s_registryIndex = 0;
+
+HalPinArray::HalPinArray(QObject *parent) :
+    QAbstractListModel(parent),
+    m_name("default"),
+    m_type(HalPin::Bit),
+    m_direction(HalPin::Out),
+    m_enabled(true),
+    m_synced(false),
+    m_dirtyFirst(-1),
+    m_dirtyLast(-1),
+    m_registryIndex(s_registryIndex++)
+{
+    s_registeredPinArrays.insert(m_registryIndex, this);
+}
+
+HalPinArray::~HalPinArray()
+{
+    s_registeredPinArrays.remove(m_registryIndex);
+    HalRemoteComponent::removeContainerRegistration(this);
+}
+
+void HalPinArray::componentComplete()
+{
+    updateRegistration();
+}
+
+/** Registers the pin array with the components containing it
+ *  and follows the parents of the pin array to notice when it is moved.
+ */
+void HalPinArray::updateRegistration()
+{
+    foreach (const QMetaObject::Connection &connection, m_parentConnections)
+    {
+        disconnect(connection);
+    }
+    m_parentConnections = HalRemoteComponent::connectContainerParents(this, SLOT(updateRegistration()));
+    HalRemoteComponent::updateContainerRegistration(this);
+}
+
+QVariant HalPinArray::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (index.row() >= m_values.size()))
+    {
+        return QVariant();
+    }
+
+    switch (role)
+    {
+    case NameRole:
+        return pinName(index.row());
+    case ValueRole:
+        return toVariant(m_values.at(index.row()));
+    case HandleRole:
+        return m_handles.at(index.row());
+    default:
+        return QVariant();
+    }
+}
+
+int HalPinArray::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return m_values.size();
+}
+
+QHash<int, QByteArray> HalPinArray::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[NameRole] = "name";
+    roles[ValueRole] = "value";
+    roles[HandleRole] = "handle";
+    return roles;
+}
+
+/*! \qmlmethod variant HalPinArray::value(int index)
+
+    Returns the value of the pin at \a index.
+*/
+QVariant HalPinArray::value(int index) const
+{
+    if ((index < 0) || (index >= m_values.size()))
+    {
+        return QVariant();
+    }
+
+    return toVariant(m_values.at(index));
+}
+
+/*! \qmlmethod HalPinArray::setValue(int index, variant value)
+
+    Sets the \a value of the pin at \a index. Only values of output
+    and input/output pins are sent to the remote component.
+*/
+void HalPinArray::setValue(int index, const QVariant &value)
+{
+    if ((index < 0) || (index >= m_values.size()))
+    {
+        return;
+    }
+
+    const double newValue = fromVariant(value);
+    if (m_values.at(index) == newValue)
+    {
+        return;
+    }
+
+    m_values[index] = newValue;
+    const QModelIndex modelIndex = this->index(index);
+    emit dataChanged(modelIndex, modelIndex, QVector<int>() << ValueRole);
+    emit valuesChanged(index, index);
+    emit valueSet(index);
+}
+
+void HalPinArray::setHandle(int index, int handle)
+{
+    m_handles[index] = handle;
+}
+
+/** Updates a value from the remote side, changes are collected until flushChanges is called */
+void HalPinArray::updateValue(int index, double value)
+{
+    if (m_values.at(index) == value)
+    {
+        return;
+    }
+
+    m_values[index] = value;
+    if (m_dirtyFirst == -1)
+    {
+        m_dirtyFirst = index;
+        m_dirtyLast = index;
+    }
+    else
+    {
+        m_dirtyFirst = qMin(m_dirtyFirst, index);
+        m_dirtyLast = qMax(m_dirtyLast, index);
+    }
+}
+
+/** Notifies about all values changed since the last call with a single signal */
+void HalPinArray::flushChanges()
+{
+    if (m_dirtyFirst == -1)
+    {
+        return;
+    }
+
+    const int first = m_dirtyFirst;
+    const int last = m_dirtyLast;
+    m_dirtyFirst = -1;
+    m_dirtyLast = -1;
+
+    emit dataChanged(index(first), index(last), QVector<int>() << ValueRole);
+    emit valuesChanged(first, last);
+}
+
+void HalPinArray::setName(const QString &name)
+{
+    if (m_name == name)
+    {
+        return;
+    }
+
+    m_name = name;
+    emit nameChanged(name);
+    if (!m_values.isEmpty())
+    {
+        emit dataChanged(index(0), index(m_values.size() - 1), QVector<int>() << NameRole);
+    }
+}
+
+void HalPinArray::setType(HalPin::HalPinType type)
+{
+    if (m_type == type)
+    {
+        return;
+    }
+
+    m_type = type;
+    emit typeChanged(type);
+}
+
+void HalPinArray::setDirection(HalPin::HalPinDirection direction)
+{
+    if (m_direction == direction)
+    {
+        return;
+    }
+
+    m_direction = direction;
+    emit directionChanged(direction);
+}
+
+void HalPinArray::setCount(int count)
+{
+    count = qMax(0, count);
+    if (m_values.size() == count)
+    {
+        return;
+    }
+
+    beginResetModel();
+    m_values.resize(count);
+    m_handles.resize(count);
+    m_dirtyFirst = -1;
+    m_dirtyLast = -1;
+    endResetModel();
+    emit countChanged(count);
+}
+
+void HalPinArray::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+    {
+        return;
+    }
+
+    m_enabled = enabled;
+    emit enabledChanged(enabled);
+}
+
+void HalPinArray::setSynced(bool synced)
+{
+    if (m_synced == synced)
+    {
+        return;
+    }
+
+    m_synced = synced;
+    emit syncedChanged(synced);
+}
+
+QVariant HalPinArray::toVariant(double value) const
+{
+    switch (m_type)
+    {
+    case HalPin::Bit:
+        return QVariant(value != 0.0);
+    case HalPin::Float:
+        return QVariant(value);
+    case HalPin::S32:
+        return QVariant(static_cast<int>(value));
+    case HalPin::U32:
+        return QVariant(static_cast<uint>(value));
+    }
+
+    return QVariant();
+}
+
+double HalPinArray::fromVariant(const QVariant &value) const
+{
+    switch (m_type)
+    {
+    case HalPin::Bit:
+        return value.toBool() ? 1.0 : 0.0;
+    case HalPin::Float:
+        return value.toDouble();
+    case HalPin::S32:
+        return static_cast<double>(value.toInt());
+    case HalPin::U32:
+        return static_cast<double>(value.toUInt());
+    }
+
+    return 0.0;
+}
+}; // namespace qtquickvcp
@@ -0,0 +1,163 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef HALPINARRAY_H
+#define HALPINARRAY_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <QMap>
+#include <QList>
+#include <QQmlParserStatus>
+#include "halpin.h"
+
+namespace qtquickvcp {
+
+class HalPinArray : public QAbstractListModel, public QQmlParserStatus
+{
+    Q_OBJECT
+    Q_INTERFACES(QQmlParserStatus)
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(qtquickvcp::HalPin::HalPinType type READ type WRITE setType NOTIFY typeChanged)
+    Q_PROPERTY(qtquickvcp::HalPin::HalPinDirection direction READ direction WRITE setDirection NOTIFY directionChanged)
+    Q_PROPERTY(int count READ count WRITE setCount NOTIFY countChanged)
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(bool synced READ synced NOTIFY syncedChanged)
+    Q_ENUMS(HalPinArrayRoles)
+
+public:
+    enum HalPinArrayRoles {
+        NameRole = Qt::UserRole,
+        ValueRole,
+        HandleRole
+    };
+
+    explicit HalPinArray(QObject *parent = 0);
+    ~HalPinArray();
+
+    QVariant data(const QModelIndex &index, int role) const;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    QHash<int, QByteArray> roleNames() const;
+
+    QString name() const
+    {
+        return m_name;
+    }
+
+    HalPin::HalPinType type() const
+    {
+        return m_type;
+    }
+
+    HalPin::HalPinDirection direction() const
+    {
+        return m_direction;
+    }
+
+    int count() const
+    {
+        return m_values.size();
+    }
+
+    bool enabled() const
+    {
+        return m_enabled;
+    }
+
+    bool synced() const
+    {
+        return m_synced;
+    }
+
+    /** contiguous buffer holding the pin values, bits and integers are stored as exact doubles */
+    const double *constData() const
+    {
+        return m_values.constData();
+    }
+
+    int handle(int index) const
+    {
+        return m_handles.at(index);
+    }
+
+    QString pinName(int index) const
+    {
+        return QString("%1.%2").arg(m_name).arg(index);
+    }
+
+    Q_INVOKABLE QVariant value(int index) const;
+    Q_INVOKABLE void setValue(int index, const QVariant &value);
+
+    void setHandle(int index, int handle);
+    void updateValue(int index, double value);
+    void flushChanges();
+
+    static const QMap<int, HalPinArray*> &registeredPinArrays()
+    {
+        return s_registeredPinArrays;
+    }
+
+    void classBegin() {}
+    void componentComplete();
+
+public slots:
+    void setName(const QString &name);
+    void setType(HalPin::HalPinType type);
+    void setDirection(HalPin::HalPinDirection direction);
+    void setCount(int count);
+    void setEnabled(bool enabled);
+    void setSynced(bool synced);
+
+private slots:
+    void updateRegistration();
+
+private:
+    QString                 m_name;
+    HalPin::HalPinType      m_type;
+    HalPin::HalPinDirection m_direction;
+    bool                    m_enabled;
+    bool                    m_synced;
+    QVector<double>         m_values;
+    QVector<int>            m_handles;
+    int                     m_dirtyFirst;
+    int                     m_dirtyLast;
+    int                     m_registryIndex;
+    QList<QMetaObject::Connection> m_parentConnections;
+
+    static QMap<int, HalPinArray*> s_registeredPinArrays;
+    static int                     s_registryIndex;
+
+    QVariant toVariant(double value) const;
+    double fromVariant(const QVariant &value) const;
+
+signals:
+    void nameChanged(const QString &name);
+    void typeChanged(HalPin::HalPinType type);
+    void directionChanged(HalPin::HalPinDirection direction);
+    void countChanged(int count);
+    void enabledChanged(bool enabled);
+    void syncedChanged(bool synced);
+    void valuesChanged(int first, int last);
+    void valueSet(int index);
+}; // class HalPinArray
+} // namespace qtquickvcp
+
+#endif // HALPINARRAY_H
@@ -13,14 +13,21 @@ include(../machinetalk/machinetalk.pri)
 SOURCES += \
     plugin.cpp \
     halpin.cpp \
+    halpinarray.cpp \
     halremotecomponent.cpp \
-    halsignal.cpp
+    halsignal.cpp \
+    halgroup.cpp \
+    halscope.cpp
 
 HEADERS += \
     plugin.h \
     halpin.h \
+    halpinarray.h \
     halremotecomponent.h \
-    halsignal.h
+    halsignal.h \
+    halgroup.h \
+    halscope.h \
+    samplebuffer.h
 
 QML_INFRA_FILES = \
     qmldir
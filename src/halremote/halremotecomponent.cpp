@@ -1,5 +1,7 @@
 #include "halremotecomponent.h"
 #include <google/protobuf/text_format.h>
+#include <QGuiApplication>
+#include <QQuickItem>
 #include "debughelper.h"
 
 #if defined(Q_OS_IOS)
@@ -28,9 +30,8 @@ namespace qtquickvcp {
     \l{halrcompUri} and \l containerItem set in order
     to work.
 
-    The HalRemoteComponent scans the \l containerItem
-    and its children for \l{HalPin}s when \l ready is set
-    to \c true.
+    The HalRemoteComponent adds all \l{HalPin}s and \l{HalPinArray}s
+    located below the \l containerItem when \l ready is set to \c true.
 
     The following example creates a HAL remote component
     \c myComponent with one pin \c myPin. The resulting
@@ -173,6 +174,21 @@ namespace qtquickvcp {
     This property holds a list of HAL pins when bound or connected.
 */
 
+/*! \qmlproperty bool HalRemoteComponent::frameSynchronized
+
+    This property holds whether value changes of input pins are delivered
+    synchronized to the frames of the window. If set to \c true only the
+    latest value of each pin is published once per frame, regardless how
+    fast the remote component sends updates.
+
+    C++ consumers that need every sample can connect to the
+    \c pinUpdateReceived signal.
+
+    The default value is \c{false}.
+*/
+
+QList<HalRemoteComponent*> HalRemoteComponent::s_components;
+
 /** Remote HAL Component implementation for use with C++ and QML */
 HalRemoteComponent::HalRemoteComponent(QObject *parent) :
     halremote::RemoteComponentBase(parent),
@@ -182,8 +198,39 @@ HalRemoteComponent::HalRemoteComponent(QObject *parent) :
     m_errorString(""),
     m_containerItem(this),
     m_create(true),
-    m_bind(true)
+    m_bind(true),
+    m_containerPinsValid(false),
+    m_frameSynchronized(false),
+    m_framePending(false),
+    m_frameWindow(nullptr)
 {
+    s_components.append(this);
+
+    // publishes the pending pins if the window does not produce a frame
+    m_frameTimer.setSingleShot(true);
+    m_frameTimer.setInterval(100);
+    connect(&m_frameTimer, &QTimer::timeout,
+            this, &HalRemoteComponent::publishPendingPins);
+}
+
+HalRemoteComponent::~HalRemoteComponent()
+{
+    s_components.removeAll(this);
+}
+
+void HalRemoteComponent::setFrameSynchronized(bool frameSynchronized)
+{
+    if (m_frameSynchronized == frameSynchronized)
+    {
+        return;
+    }
+
+    m_frameSynchronized = frameSynchronized;
+    if (!m_frameSynchronized)
+    {
+        publishPendingPins();
+    }
+    emit frameSynchronizedChanged(frameSynchronized);
 }
 
 /** Updates a remote pin witht the value of a local pin */
@@ -240,26 +287,204 @@ void HalRemoteComponent::pinChange(QVariant value)
     sendHalrcompSet(m_tx);
 }
 
-/** Recurses through a list of objects */
-QObjectList HalRemoteComponent::recurseObjects(const QObjectList &list)
+/** Updates a remote pin with the value of a local pin array element */
+void HalRemoteComponent::pinArrayChange(int index)
+{
+    HalPinArray *pinArray;
+    Pin *halPin;
+
+    if (state() != Synced) // only accept pin changes if we are connected
+    {
+        return;
+    }
+
+    pinArray = static_cast<HalPinArray *>(QObject::sender());
+
+    if (pinArray->direction() == HalPin::In)   // Only update Output or IO pins
+    {
+        return;
+    }
+
+#ifdef QT_DEBUG
+    DEBUG_TAG(2, m_name,  "pin change" << pinArray->pinName(index) << pinArray->value(index))
+#endif
+
+    halPin = m_tx.add_pin();
+    halPin->set_handle(pinArray->handle(index));
+    halPin->set_type((ValueType)pinArray->type());
+    const double value = pinArray->constData()[index];
+    if (pinArray->type() == HalPin::Float)
+    {
+        halPin->set_halfloat(value);
+    }
+    else if (pinArray->type() == HalPin::Bit)
+    {
+        halPin->set_halbit(value != 0.0);
+    }
+    else if (pinArray->type() == HalPin::S32)
+    {
+        halPin->set_hals32(static_cast<int>(value));
+    }
+    else if (pinArray->type() == HalPin::U32)
+    {
+        halPin->set_halu32(static_cast<uint>(value));
+    }
+
+    sendHalrcompSet(m_tx);
+}
+
+/** Returns the parent used for the container lookup
+ *  items use their visual parent, which is changed by Loader, Repeater
+ *  and the parent property in QML.
+ */
+QObject *HalRemoteComponent::containerParent(const QObject *object)
+{
+    const QQuickItem *item = qobject_cast<const QQuickItem*>(object);
+
+    if ((item != nullptr) && (item->parentItem() != nullptr))
+    {
+        return item->parentItem();
+    }
+
+    return object->parent();
+}
+
+/** Connects the slot of the object to the parent changes of all items above it */
+QList<QMetaObject::Connection> HalRemoteComponent::connectContainerParents(QObject *object, const char *slot)
+{
+    QList<QMetaObject::Connection> connections;
+    QObject *parent = containerParent(object);
+
+    while (parent != nullptr)
+    {
+        if (qobject_cast<QQuickItem*>(parent) != nullptr)
+        {
+            connections.append(connect(parent, SIGNAL(parentChanged(QQuickItem*)),
+                                       object, slot));
+        }
+        parent = containerParent(parent);
+    }
+
+    return connections;
+}
+
+template <typename T>
+static void updateRegistration(QList<T*> *list, T *object, bool contained)
 {
-    QObjectList halObjects;
+    const int index = list->indexOf(object);
 
-    foreach (QObject *object, list)
+    if (contained && (index == -1))
+    {
+        list->append(object);
+    }
+    else if (!contained && (index != -1))
+    {
+        list->removeAt(index);
+    }
+}
+
+/** Adds or removes a completed or moved pin to the components containing it */
+void HalRemoteComponent::updateContainerRegistration(HalPin *pin)
+{
+    foreach (HalRemoteComponent *component, s_components)
     {
-        HalPin *halPin = qobject_cast<HalPin *>(object);
-        if (halPin != nullptr)
+        if (component->m_containerPinsValid) // otherwise the pins are collected on the next connect
         {
-            halObjects.append(object);
+            updateRegistration(&component->m_containerPins, pin, component->isContainerChild(pin));
         }
+    }
+}
+
+void HalRemoteComponent::updateContainerRegistration(HalPinArray *pinArray)
+{
+    foreach (HalRemoteComponent *component, s_components)
+    {
+        if (component->m_containerPinsValid)
+        {
+            updateRegistration(&component->m_containerPinArrays, pinArray, component->isContainerChild(pinArray));
+        }
+    }
+}
+
+void HalRemoteComponent::removeContainerRegistration(HalPin *pin)
+{
+    foreach (HalRemoteComponent *component, s_components)
+    {
+        component->m_containerPins.removeAll(pin);
+    }
+}
 
-        if (object->children().size() > 0)
+void HalRemoteComponent::removeContainerRegistration(HalPinArray *pinArray)
+{
+    foreach (HalRemoteComponent *component, s_components)
+    {
+        component->m_containerPinArrays.removeAll(pinArray);
+    }
+}
+
+/** Checks whether the object is located below the container item */
+bool HalRemoteComponent::isContainerChild(const QObject *object) const
+{
+    QObject *parent = containerParent(object);
+
+    while (parent != nullptr)
+    {
+        if (parent == m_containerItem)
         {
-            halObjects.append(recurseObjects(object->children()));
+            return true;
         }
+        parent = containerParent(parent);
     }
 
-    return halObjects;
+    return false;
+}
+
+/** Updates the lists of pins located below the container item
+ *  All pins are only looked up when the container item has changed,
+ *  afterwards the pins register and unregister themselves with the
+ *  components containing them.
+ */
+void HalRemoteComponent::updateContainerPins()
+{
+    if (m_containerPinsValid)
+    {
+        // a QObject::setParent of a pin itself is not notified, drop pins moved away
+        for (int i = (m_containerPins.size() - 1); i >= 0; --i)
+        {
+            if (!isContainerChild(m_containerPins.at(i)))
+            {
+                m_containerPins.removeAt(i);
+            }
+        }
+        for (int i = (m_containerPinArrays.size() - 1); i >= 0; --i)
+        {
+            if (!isContainerChild(m_containerPinArrays.at(i)))
+            {
+                m_containerPinArrays.removeAt(i);
+            }
+        }
+        return;
+    }
+
+    m_containerPins.clear();
+    foreach (HalPin *pin, HalPin::registeredPins())
+    {
+        if (isContainerChild(pin))
+        {
+            m_containerPins.append(pin);
+        }
+    }
+
+    m_containerPinArrays.clear();
+    foreach (HalPinArray *pinArray, HalPinArray::registeredPinArrays())
+    {
+        if (isContainerChild(pinArray))
+        {
+            m_containerPinArrays.append(pinArray);
+        }
+    }
+
+    m_containerPinsValid = true;
 }
 
 /** Updates a local pin with the value of a remote pin */
@@ -287,6 +512,60 @@ void HalRemoteComponent::pinUpdate(const Pin &remotePin, HalPin *localPin)
     }
 }
 
+/** Updates a local pin array element with the value of a remote pin */
+void HalRemoteComponent::pinArrayUpdate(const Pin &remotePin, HalPinArray *localPinArray, int index)
+{
+    if (remotePin.has_halfloat())
+    {
+        localPinArray->updateValue(index, remotePin.halfloat());
+    }
+    else if (remotePin.has_halbit())
+    {
+        localPinArray->updateValue(index, remotePin.halbit() ? 1.0 : 0.0);
+    }
+    else if (remotePin.has_hals32())
+    {
+        localPinArray->updateValue(index, static_cast<double>(remotePin.hals32()));
+    }
+    else if (remotePin.has_halu32())
+    {
+        localPinArray->updateValue(index, static_cast<double>(remotePin.halu32()));
+    }
+}
+
+/** Maps the handle of a remote pin named array.index to the matching pin array element */
+bool HalRemoteComponent::addPinArrayHandle(const Pin &remotePin, const QString &name)
+{
+    int dotIndex = name.lastIndexOf(".");
+    if (dotIndex == -1)
+    {
+        return false;
+    }
+
+    HalPinArray *pinArray = m_pinArraysByName.value(name.left(dotIndex), nullptr);
+    bool ok;
+    int index = name.mid(dotIndex + 1).toInt(&ok);
+    if ((pinArray == nullptr) || !ok || (index < 0) || (index >= pinArray->count()))
+    {
+        return false;
+    }
+
+    pinArray->setHandle(index, static_cast<int>(remotePin.handle()));
+    m_pinArraysByHandle.insert(static_cast<int>(remotePin.handle()), qMakePair(pinArray, index));
+    pinArrayUpdate(remotePin, pinArray, index);
+
+    return true;
+}
+
+/** Emits a single change notification for each pin array changed by the last update */
+void HalRemoteComponent::flushPinArrays()
+{
+    foreach (HalPinArray *pinArray, m_pinArraysByName)
+    {
+        pinArray->flushChanges();
+    }
+}
+
 /** Adds a local pin based on remote pin representation **/
 HalPin *HalRemoteComponent::addLocalPin(const Pin &remotePin)
 {
@@ -335,6 +614,33 @@ void HalRemoteComponent::bindPins()
             halPin->set_halu32(pin->value().toUInt());
         }
     }
+    foreach (HalPinArray *pinArray, m_pinArraysByName)
+    {
+        for (int i = 0; i < pinArray->count(); ++i)
+        {
+            Pin *halPin = component->add_pin();
+            const double value = pinArray->constData()[i];
+            halPin->set_name(QString("%1.%2").arg(m_name).arg(pinArray->pinName(i)).toStdString());
+            halPin->set_type(static_cast<ValueType>(pinArray->type()));
+            halPin->set_dir(static_cast<HalPinDirection>(pinArray->direction()));
+            if (pinArray->type() == HalPin::Float)
+            {
+                halPin->set_halfloat(value);
+            }
+            else if (pinArray->type() == HalPin::Bit)
+            {
+                halPin->set_halbit(value != 0.0);
+            }
+            else if (pinArray->type() == HalPin::S32)
+            {
+                halPin->set_hals32(static_cast<int>(value));
+            }
+            else if (pinArray->type() == HalPin::U32)
+            {
+                halPin->set_halu32(static_cast<uint>(value));
+            }
+        }
+    }
 
 #ifdef QT_DEBUG
     std::string s;
@@ -362,11 +668,9 @@ QString HalRemoteComponent::splitPinFromHalName(const QString &name)
     return newName;
 }
 
-/** Scans all children of the container item for pins and adds them to a map */
+/** Adds all pins registered below the container item to a map */
 void HalRemoteComponent::addPins()
 {
-    QObjectList halObjects;
-
     if (m_containerItem == nullptr)
     {
         return;
@@ -375,10 +679,9 @@ void HalRemoteComponent::addPins()
     clearHalrcompTopics();
     addHalrcompTopic(m_name);
 
-    halObjects = recurseObjects(m_containerItem->children());
-    foreach (QObject *object, halObjects)
+    updateContainerPins();
+    foreach (HalPin *pin, m_containerPins)
     {
-        HalPin *pin = static_cast<HalPin *>(object);
         if (pin->name().isEmpty()  || (pin->enabled() == false))    // ignore pins with empty name and disabled pins
         {
             continue;
@@ -392,6 +695,20 @@ void HalRemoteComponent::addPins()
 #endif
     }
 
+    foreach (HalPinArray *pinArray, m_containerPinArrays)
+    {
+        if (pinArray->name().isEmpty()  || (pinArray->enabled() == false))    // ignore pin arrays with empty name and disabled pin arrays
+        {
+            continue;
+        }
+        m_pinArraysByName[pinArray->name()] = pinArray;
+        connect(pinArray, &HalPinArray::valueSet,
+                this, &HalRemoteComponent::pinArrayChange);
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_name, "pin array added: " << pinArray->name() << pinArray->count())
+#endif
+    }
+
     emit pinsChanged(pins());
 }
 
@@ -409,9 +726,18 @@ void HalRemoteComponent::removePins()
         }
     }
 
+    foreach (HalPinArray *pinArray, m_pinArraysByName)
+    {
+        disconnect(pinArray, &HalPinArray::valueSet,
+                   this, &HalRemoteComponent::pinArrayChange);
+    }
+
     m_pinsByHandle.clear();
     m_pinsByName.clear();
     m_pins.clear();
+    m_pinArraysByHandle.clear();
+    m_pinArraysByName.clear();
+    m_pendingPins.clear();
     emit pinsChanged(pins());
 }
 
@@ -423,6 +749,11 @@ void HalRemoteComponent::unsyncPins()
         i.next();
         i.value()->setSynced(false);
     }
+
+    foreach (HalPinArray *pinArray, m_pinArraysByName)
+    {
+        pinArray->setSynced(false);
+    }
 }
 
 void HalRemoteComponent::halrcompFullUpdateReceived(const QByteArray &topic,const Container &rx)
@@ -430,6 +761,8 @@ void HalRemoteComponent::halrcompFullUpdateReceived(const QByteArray &topic,cons
     Q_UNUSED(topic);
     bool pinsAdded = false;
 
+    m_pendingPins.clear(); // full update holds the latest values
+
     if (rx.comp_size() == 0) // empty message
     {
         return;
@@ -443,7 +776,11 @@ void HalRemoteComponent::halrcompFullUpdateReceived(const QByteArray &topic,cons
         name = splitPinFromHalName(name);
 
         HalPin *localPin = m_pinsByName.value(name, nullptr);
-        if (localPin == nullptr)
+        if ((localPin == nullptr) && addPinArrayHandle(remotePin, name))
+        {
+            continue;
+        }
+        else if (localPin == nullptr)
         {
             localPin = addLocalPin(remotePin);
             pinsAdded = true;
@@ -459,6 +796,12 @@ void HalRemoteComponent::halrcompFullUpdateReceived(const QByteArray &topic,cons
         emit pinsChanged(pins());
     }
 
+    flushPinArrays();
+    foreach (HalPinArray *pinArray, m_pinArraysByName)
+    {
+        pinArray->setSynced(true);
+    }
+
     pinsSynced(); // accept that pins have been synced
 }
 
@@ -466,15 +809,111 @@ void HalRemoteComponent::halrcompIncrementalUpdateReceived(const QByteArray &top
 {
     Q_UNUSED(topic);
 
+    emit pinUpdateReceived(rx);
+
+    if (m_frameSynchronized)
+    {
+        for (int i = 0; i < rx.pin_size(); ++i)
+        {
+            m_pendingPins.insert(static_cast<int>(rx.pin(i).handle()), rx.pin(i)); // latest value wins
+        }
+        requestFrame();
+        return;
+    }
+
     for (int i = 0; i < rx.pin_size(); ++i)
     {
-        Pin remotePin = rx.pin(i);
-        HalPin *localPin = m_pinsByHandle.value(remotePin.handle(), nullptr);
-        if (localPin != nullptr) // in case we received a wrong pin handle
+        updatePinByHandle(rx.pin(i));
+    }
+
+    flushPinArrays();   // one notification per pin array and update
+}
+
+/** Updates the local pin or pin array element matching the handle of the remote pin */
+void HalRemoteComponent::updatePinByHandle(const Pin &remotePin)
+{
+    HalPin *localPin = m_pinsByHandle.value(remotePin.handle(), nullptr);
+    if (localPin != nullptr) // in case we received a wrong pin handle
+    {
+        pinUpdate(remotePin, localPin);
+        return;
+    }
+
+    QHash<int, QPair<HalPinArray*, int>>::const_iterator it = m_pinArraysByHandle.constFind(remotePin.handle());
+    if (it != m_pinArraysByHandle.constEnd())
+    {
+        pinArrayUpdate(remotePin, it.value().first, it.value().second);
+    }
+}
+
+/** Schedules publishing the pending pin values with the next frame of the window */
+void HalRemoteComponent::requestFrame()
+{
+    if (m_frameWindow.isNull())
+    {
+        m_frameWindow = findFrameWindow();
+        if (m_frameWindow.isNull()) // no window to synchronize to
         {
-            pinUpdate(remotePin, localPin);
+            publishPendingPins();
+            return;
         }
+        connect(m_frameWindow.data(), &QQuickWindow::afterAnimating,
+                this, &HalRemoteComponent::publishPendingPins);
     }
+
+    if (!m_frameWindow->isExposed()) // hidden windows do not render frames
+    {
+        publishPendingPins();
+        return;
+    }
+
+    if (!m_framePending)
+    {
+        m_framePending = true;
+        m_frameWindow->update();
+        m_frameTimer.start();
+    }
+}
+
+/** Returns the window of the container item or the first Qt Quick window */
+QQuickWindow *HalRemoteComponent::findFrameWindow() const
+{
+    QQuickItem *item = qobject_cast<QQuickItem*>(m_containerItem);
+    if ((item != nullptr) && (item->window() != nullptr))
+    {
+        return item->window();
+    }
+
+    foreach (QWindow *window, QGuiApplication::topLevelWindows())
+    {
+        QQuickWindow *quickWindow = qobject_cast<QQuickWindow*>(window);
+        if (quickWindow != nullptr)
+        {
+            return quickWindow;
+        }
+    }
+
+    return nullptr;
+}
+
+/** Applies the latest value of all pins changed since the last frame */
+void HalRemoteComponent::publishPendingPins()
+{
+    m_framePending = false;
+    m_frameTimer.stop();
+
+    if (m_pendingPins.isEmpty())
+    {
+        return;
+    }
+
+    foreach (const Pin &remotePin, m_pendingPins)
+    {
+        updatePinByHandle(remotePin);
+    }
+    m_pendingPins.clear();
+
+    flushPinArrays();
 }
 
 void HalRemoteComponent::halrcompErrorReceived(const QByteArray &topic, const Container &rx)
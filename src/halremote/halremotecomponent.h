@@ -25,9 +25,13 @@
 
 #include <QObject>
 #include <QQmlListProperty>
+#include <QPointer>
+#include <QTimer>
+#include <QQuickWindow>
 #include <machinetalk/protobuf/message.pb.h>
 #include <halremote/remotecomponentbase.h>
 #include "halpin.h"
+#include "halpinarray.h"
 
 namespace qtquickvcp {
 
@@ -41,10 +45,12 @@ class HalRemoteComponent : public machinetalk::halremote::RemoteComponentBase
     Q_PROPERTY(bool create READ create WRITE setCreate NOTIFY createChanged)
     Q_PROPERTY(bool bind READ bind WRITE setBind NOTIFY bindChanged)
     Q_PROPERTY(QQmlListProperty<qtquickvcp::HalPin> pins READ pins NOTIFY pinsChanged)
+    Q_PROPERTY(bool frameSynchronized READ isFrameSynchronized WRITE setFrameSynchronized NOTIFY frameSynchronizedChanged)
     Q_ENUMS(ConnectionError)
 
 public:
     explicit HalRemoteComponent(QObject *parent  = 0);
+    ~HalRemoteComponent();
 
     enum ConnectionError {
         NoError = 0,
@@ -89,6 +95,28 @@ public:
         return m_bind;
     }
 
+    bool isFrameSynchronized() const
+    {
+        return m_frameSynchronized;
+    }
+
+    HalPin *pinByHandle(int handle) const
+    {
+        return m_pinsByHandle.value(handle, nullptr);
+    }
+
+    static QList<HalRemoteComponent*> components()
+    {
+        return s_components;
+    }
+
+    static QObject *containerParent(const QObject *object);
+    static QList<QMetaObject::Connection> connectContainerParents(QObject *object, const char *slot);
+    static void updateContainerRegistration(HalPin *pin);
+    static void updateContainerRegistration(HalPinArray *pinArray);
+    static void removeContainerRegistration(HalPin *pin);
+    static void removeContainerRegistration(HalPinArray *pinArray);
+
 public slots:
     void setName(QString name)
     {
@@ -109,6 +137,7 @@ public slots:
         }
 
         m_containerItem = containerItem;
+        m_containerPinsValid = false; // the pin lists are collected again on the next connect
         emit containerItemChanged(containerItem);
     }
 
@@ -132,6 +161,8 @@ public slots:
         emit bindChanged(bind);
     }
 
+    void setFrameSynchronized(bool frameSynchronized);
+
     QQmlListProperty<HalPin> pins()
     {
         return QQmlListProperty<HalPin>(this, m_pins);
@@ -146,6 +177,7 @@ public slots:
     }
 
     void pinChange(QVariant value);
+    void pinArrayChange(int index);
 
 private:
     QString         m_name;
@@ -161,13 +193,32 @@ private:
     QMap<QString, HalPin*> m_pinsByName;
     QHash<int, HalPin*>    m_pinsByHandle;
     QList<HalPin*>         m_pins;
-
-    QObjectList recurseObjects(const QObjectList &list);
+    QList<HalPin*>         m_containerPins;
+    bool                   m_containerPinsValid;
+    QMap<QString, HalPinArray*>        m_pinArraysByName;
+    QHash<int, QPair<HalPinArray*, int>> m_pinArraysByHandle;
+    QList<HalPinArray*>                m_containerPinArrays;
+    bool                               m_frameSynchronized;
+    bool                               m_framePending;
+    QPointer<QQuickWindow>             m_frameWindow;
+    QTimer                             m_frameTimer;
+    QHash<int, machinetalk::Pin>       m_pendingPins;
+
+    static QList<HalRemoteComponent*> s_components;
+
+    void updateContainerPins();
+    bool isContainerChild(const QObject *object) const;
     void bindPins();
     static QString splitPinFromHalName(const QString &name);
 
     void pinUpdate(const machinetalk::Pin &remotePin, HalPin *localPin);
+    void pinArrayUpdate(const machinetalk::Pin &remotePin, HalPinArray *localPinArray, int index);
+    bool addPinArrayHandle(const machinetalk::Pin &remotePin, const QString &name);
+    void flushPinArrays();
     HalPin *addLocalPin(const machinetalk::Pin &remotePin);
+    void updatePinByHandle(const machinetalk::Pin &remotePin);
+    void requestFrame();
+    QQuickWindow *findFrameWindow() const;
 
     // RemoteComponentBase interface
 private slots:
@@ -183,6 +234,7 @@ private slots:
     void setDisconnected();
     void setConnecting();
     void setTimeout();
+    void publishPendingPins();
 
 signals:
     void nameChanged(QString name);
@@ -193,6 +245,8 @@ signals:
     void createChanged(bool create);
     void bindChanged(bool bind);
     void pinsChanged(QQmlListProperty<HalPin> arg);
+    void frameSynchronizedChanged(bool frameSynchronized);
+    void pinUpdateReceived(const machinetalk::Container &rx);
 }; // class HalRemoteComponent
 } // namespace qtquickvcp
 
@@ -0,0 +1,602 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "halscope.h"
+#include <QFile>
+#include <QTextStream>
+#include <QDataStream>
+#include <QPointF>
+#include <limits>
+#include "halpin.h"
+#include "halsignal.h"
+#include "halremotecomponent.h"
+
+using namespace machinetalk;
+
+namespace qtquickvcp {
+
+/*!
+    \qmltype HalScope
+    \instantiates QHalScope
+    \inqmlmodule Machinekit.HalRemote
+    \brief A capture engine for HAL pins and signals.
+    \ingroup halremote
+
+    This component records the values of \l{HalPin}s and \l{HalSignal}s
+    with timestamps at the full incoming update rate. The samples are
+    stored in ring buffers in C++ and can be decimated for display or
+    exported to a file.
+
+    A capture is started with \l start. Depending on the \l triggerMode
+    the capture completes after the trigger condition was met on the
+    \l triggerSource and the post trigger part of the \l captureTime
+    has elapsed.
+
+    \qml
+    HalScope {
+        id: scope
+        sources: [velocityPin, followingErrorPin]
+        triggerSource: 0
+        triggerMode: HalScope.RisingEdge
+        triggerLevel: 10.0
+        captureTime: 2.0
+        preTrigger: 0.2
+    }
+    \endqml
+*/
+
+/*! \qmlproperty list<QtObject> HalScope::sources
+
+    This property holds the \l{HalPin}s and \l{HalSignal}s that should be
+    recorded. Each source is recorded to its own channel.
+
+    Input pins are recorded from every update received by their
+    \l HalRemoteComponent, also when \c frameSynchronized coalesces
+    the value changes of the pins.
+*/
+
+/*! \qmlproperty int HalScope::bufferSize
+
+    This property holds the number of samples stored per channel. The value
+    is rounded up to the next power of two.
+
+    The default value is \c{65536}.
+*/
+
+/*! \qmlproperty real HalScope::captureTime
+
+    This property holds the length of the capture window in seconds.
+
+    The default value is \c{1.0}.
+*/
+
+/*! \qmlproperty real HalScope::preTrigger
+
+    This property holds the part of the capture window located before
+    the trigger point as a fraction between \c 0.0 and \c 1.0.
+
+    The default value is \c{0.5}.
+*/
+
+/*! \qmlproperty int HalScope::triggerSource
+
+    This property holds the index of the source used for triggering.
+
+    The default value is \c{0}.
+*/
+
+/*! \qmlproperty enumeration HalScope::triggerMode
+
+    This property holds the trigger condition.
+
+    \list
+    \li HalScope.NoTrigger - The capture runs continuously until \l stop is called. (Default)
+    \li HalScope.RisingEdge - Triggers when the value crosses \l triggerLevel upwards.
+    \li HalScope.FallingEdge - Triggers when the value crosses \l triggerLevel downwards.
+    \li HalScope.AnyEdge - Triggers when the value crosses \l triggerLevel in any direction.
+    \li HalScope.HighLevel - Triggers when the value is greater or equal to \l triggerLevel.
+    \li HalScope.LowLevel - Triggers when the value is less or equal to \l triggerLevel.
+    \endlist
+*/
+
+/*! \qmlproperty real HalScope::triggerLevel
+
+    This property holds the level used by the trigger condition.
+
+    The default value is \c{0.5}.
+*/
+
+/*! \qmlproperty enumeration HalScope::state
+
+    This property holds the state of the capture.
+
+    \list
+    \li HalScope.Idle - No capture is running.
+    \li HalScope.Armed - Samples are recorded and the trigger condition is checked.
+    \li HalScope.Triggered - The trigger condition was met, the post trigger samples are recorded.
+    \li HalScope.Complete - The capture is complete.
+    \endlist
+*/
+
+/*! \qmlsignal HalScope::captureFinished()
+
+    This signal is emitted when the capture is complete.
+*/
+
+HalScope::HalScope(QObject *parent) :
+    QObject(parent),
+    m_bufferSize(65536),
+    m_captureTime(1.0),
+    m_preTrigger(0.5),
+    m_triggerSource(0),
+    m_triggerMode(NoTrigger),
+    m_triggerLevel(0.5),
+    m_state(Idle),
+    m_triggerTime(0),
+    m_lastTriggerValue(0.0),
+    m_lastTriggerValueValid(false)
+{
+    m_postTriggerTimer.setSingleShot(true);
+    connect(&m_postTriggerTimer, &QTimer::timeout,
+            this, &HalScope::finishCapture);
+}
+
+HalScope::~HalScope()
+{
+    qDeleteAll(m_buffers);
+}
+
+void HalScope::setBufferSize(int bufferSize)
+{
+    if ((m_bufferSize == bufferSize) || (m_state == Armed) || (m_state == Triggered)) {
+        return;
+    }
+
+    m_bufferSize = bufferSize;
+    emit bufferSizeChanged(bufferSize);
+}
+
+void HalScope::setCaptureTime(double captureTime)
+{
+    if (m_captureTime == captureTime) {
+        return;
+    }
+
+    m_captureTime = captureTime;
+    emit captureTimeChanged(captureTime);
+}
+
+void HalScope::setPreTrigger(double preTrigger)
+{
+    preTrigger = qBound(0.0, preTrigger, 1.0);
+    if (m_preTrigger == preTrigger) {
+        return;
+    }
+
+    m_preTrigger = preTrigger;
+    emit preTriggerChanged(preTrigger);
+}
+
+void HalScope::setTriggerSource(int triggerSource)
+{
+    if (m_triggerSource == triggerSource) {
+        return;
+    }
+
+    m_triggerSource = triggerSource;
+    m_lastTriggerValueValid = false;
+    emit triggerSourceChanged(triggerSource);
+}
+
+void HalScope::setTriggerMode(HalScope::TriggerMode triggerMode)
+{
+    if (m_triggerMode == triggerMode) {
+        return;
+    }
+
+    m_triggerMode = triggerMode;
+    emit triggerModeChanged(triggerMode);
+}
+
+void HalScope::setTriggerLevel(double triggerLevel)
+{
+    if (m_triggerLevel == triggerLevel) {
+        return;
+    }
+
+    m_triggerLevel = triggerLevel;
+    emit triggerLevelChanged(triggerLevel);
+}
+
+void HalScope::setState(HalScope::CaptureState state)
+{
+    if (m_state == state) {
+        return;
+    }
+
+    m_state = state;
+    emit stateChanged(state);
+}
+
+/** Starts a new capture, all previously recorded samples are discarded */
+void HalScope::start()
+{
+    stop();
+
+    qDeleteAll(m_buffers);
+    m_buffers.clear();
+    m_channelNames.clear();
+    m_remoteChannels.clear();
+    m_elapsedTimer.start();
+    m_triggerTime = 0;
+    m_lastTriggerValueValid = false;
+
+    for (int i = 0; i < m_sources.size(); ++i)
+    {
+        QObject *source = m_sources.at(i);
+        m_buffers.append(new SampleBuffer<HalSample>(m_bufferSize));
+
+        // the sources may be destroyed before the capture is exported
+        const QString name = source->property("name").toString();
+        m_channelNames.append(name.isEmpty() ? QString("channel%1").arg(i) : name);
+
+        HalPin *pin = qobject_cast<HalPin*>(source);
+        HalSignal *signal = qobject_cast<HalSignal*>(source);
+        if ((pin != nullptr) && (pin->direction() == HalPin::In))
+        {
+            // valueChanged may be coalesced per frame, record every received value instead
+            m_remoteChannels.insert(pin, i);
+            addSample(i, pin->value());
+        }
+        else if (pin != nullptr)
+        {
+            m_connections.append(connect(pin, &HalPin::valueChanged,
+                                         this, [this, i](const QVariant &value) { addSample(i, value); }));
+            addSample(i, pin->value());
+        }
+        else if (signal != nullptr)
+        {
+            m_connections.append(connect(signal, &HalSignal::valueChanged,
+                                         this, [this, i](const QVariant &value) { addSample(i, value); }));
+            addSample(i, signal->value());
+        }
+    }
+
+    if (!m_remoteChannels.isEmpty())
+    {
+        foreach (HalRemoteComponent *component, HalRemoteComponent::components())
+        {
+            m_connections.append(connect(component, &HalRemoteComponent::pinUpdateReceived,
+                                         this, [this, component](const Container &rx) { addRemoteSamples(component, rx); }));
+        }
+    }
+
+    setState((m_triggerMode == NoTrigger) ? Triggered : Armed);
+}
+
+/** Stops a running capture */
+void HalScope::stop()
+{
+    foreach (const QMetaObject::Connection &connection, m_connections)
+    {
+        disconnect(connection);
+    }
+    m_connections.clear();
+    m_postTriggerTimer.stop();
+
+    if (m_state == Triggered)
+    {
+        setState(Complete);
+        emit captureFinished();
+    }
+    else if (m_state == Armed)
+    {
+        setState(Idle);
+    }
+}
+
+void HalScope::finishCapture()
+{
+    stop();
+}
+
+void HalScope::addSample(int channel, const QVariant &value)
+{
+    HalSample sample;
+    sample.timestamp = m_elapsedTimer.nsecsElapsed();
+    sample.value = value.toDouble();
+    m_buffers.at(channel)->push(sample);
+
+    if ((m_state != Armed) || (channel != m_triggerSource))
+    {
+        return;
+    }
+
+    if (checkTrigger(sample.value))
+    {
+        m_triggerTime = sample.timestamp;
+        setState(Triggered);
+        m_postTriggerTimer.start(qMax(0, static_cast<int>(m_captureTime * (1.0 - m_preTrigger) * 1000.0)));
+    }
+    m_lastTriggerValue = sample.value;
+    m_lastTriggerValueValid = true;
+}
+
+/** Records the values of the source pins contained in a remote component update */
+void HalScope::addRemoteSamples(const HalRemoteComponent *component, const Container &rx)
+{
+    for (int i = 0; i < rx.pin_size(); ++i)
+    {
+        const Pin &remotePin = rx.pin(i);
+        const int channel = m_remoteChannels.value(component->pinByHandle(static_cast<int>(remotePin.handle())), -1);
+        if (channel == -1)
+        {
+            continue;
+        }
+
+        if (remotePin.has_halfloat())
+        {
+            addSample(channel, remotePin.halfloat());
+        }
+        else if (remotePin.has_halbit())
+        {
+            addSample(channel, remotePin.halbit());
+        }
+        else if (remotePin.has_hals32())
+        {
+            addSample(channel, remotePin.hals32());
+        }
+        else if (remotePin.has_halu32())
+        {
+            addSample(channel, remotePin.halu32());
+        }
+    }
+}
+
+bool HalScope::checkTrigger(double value) const
+{
+    switch (m_triggerMode)
+    {
+    case NoTrigger:
+        return true;
+    case RisingEdge:
+        return m_lastTriggerValueValid && (m_lastTriggerValue < m_triggerLevel) && (value >= m_triggerLevel);
+    case FallingEdge:
+        return m_lastTriggerValueValid && (m_lastTriggerValue > m_triggerLevel) && (value <= m_triggerLevel);
+    case AnyEdge:
+        return m_lastTriggerValueValid && (((m_lastTriggerValue < m_triggerLevel) && (value >= m_triggerLevel))
+                                           || ((m_lastTriggerValue > m_triggerLevel) && (value <= m_triggerLevel)));
+    case HighLevel:
+        return value >= m_triggerLevel;
+    case LowLevel:
+        return value <= m_triggerLevel;
+    }
+
+    return false;
+}
+
+/** Calculates the capture window in ns, the window ends at the last sample when no trigger is used */
+void HalScope::captureWindow(qint64 *begin, qint64 *end) const
+{
+    const qint64 captureTime = static_cast<qint64>(m_captureTime * 1e9);
+
+    if ((m_triggerMode != NoTrigger) && (m_state >= Triggered))
+    {
+        *begin = m_triggerTime - static_cast<qint64>(captureTime * m_preTrigger);
+        *end = *begin + captureTime;
+    }
+    else
+    {
+        *end = m_elapsedTimer.isValid() ? m_elapsedTimer.nsecsElapsed() : 0;
+        *begin = *end - captureTime;
+    }
+}
+
+/** Copies the samples located inside the window including the value held at the window begin */
+void HalScope::windowSamples(int channel, qint64 begin, qint64 end, QVector<HalSample> *samples) const
+{
+    const SampleBuffer<HalSample> *buffer = m_buffers.at(channel);
+    buffer->copy(buffer->readIndex(), buffer->writeIndex(), samples);
+
+    int first = 0;
+    while ((first < samples->size()) && (samples->at(first).timestamp < begin)) {
+        first++;
+    }
+    int last = first;
+    while ((last < samples->size()) && (samples->at(last).timestamp <= end)) {
+        last++;
+    }
+
+    if (first > 0) {  // keep the value held at the window begin
+        first--;
+        (*samples)[first].timestamp = begin;
+    }
+    samples->remove(last, samples->size() - last);
+    samples->remove(0, first);
+}
+
+QStringList HalScope::channelNames() const
+{
+    return m_channelNames;
+}
+
+/*! \qmlmethod list<point> HalScope::decimate(int channel, int buckets)
+
+    Reduces the samples of the \a channel inside the capture window to
+    \a buckets min/max pairs suitable for display. For each bucket the
+    minimum and the maximum value are returned as points, the x coordinate
+    holds the time in seconds relative to the trigger point.
+*/
+QVariantList HalScope::decimate(int channel, int buckets) const
+{
+    QVariantList points;
+
+    if ((channel < 0) || (channel >= m_buffers.size()) || (buckets <= 0))
+    {
+        return points;
+    }
+
+    qint64 begin;
+    qint64 end;
+    captureWindow(&begin, &end);
+    const qint64 reference = ((m_triggerMode != NoTrigger) && (m_state >= Triggered)) ? m_triggerTime : end;
+
+    QVector<HalSample> samples;
+    windowSamples(channel, begin, end, &samples);
+    if (samples.isEmpty())
+    {
+        return points;
+    }
+
+    const double bucketWidth = static_cast<double>(end - begin) / buckets;
+    double value = samples.first().value;
+    int index = 0;
+    points.reserve(buckets * 2);
+    for (int bucket = 0; bucket < buckets; ++bucket)
+    {
+        const qint64 bucketEnd = begin + static_cast<qint64>(bucketWidth * (bucket + 1));
+        double min = value;
+        double max = value;
+        while ((index < samples.size()) && (samples.at(index).timestamp <= bucketEnd))
+        {
+            value = samples.at(index).value;
+            min = qMin(min, value);
+            max = qMax(max, value);
+            index++;
+        }
+
+        const double time = (begin + bucketWidth * (bucket + 0.5) - reference) / 1e9;
+        points.append(QPointF(time, min));
+        points.append(QPointF(time, max));
+    }
+
+    return points;
+}
+
+/*! \qmlmethod bool HalScope::exportCsv(url fileUrl)
+
+    Exports the samples inside the capture window to a CSV file. Each row
+    holds the time in seconds relative to the trigger point followed by the
+    values of all channels at this point in time.
+*/
+bool HalScope::exportCsv(const QUrl &fileUrl) const
+{
+    QFile file(fileUrl.toLocalFile());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    qint64 begin;
+    qint64 end;
+    captureWindow(&begin, &end);
+    const qint64 reference = ((m_triggerMode != NoTrigger) && (m_state >= Triggered)) ? m_triggerTime : end;
+
+    QList<QVector<HalSample>> channels;
+    for (int i = 0; i < m_buffers.size(); ++i)
+    {
+        QVector<HalSample> samples;
+        windowSamples(i, begin, end, &samples);
+        channels.append(samples);
+    }
+
+    QTextStream stream(&file);
+    stream << "time," << channelNames().join(",") << "\n";
+
+    // merge the channels, values are held until the next sample
+    QVector<int> indices(channels.size(), 0);
+    QVector<double> values(channels.size(), 0.0);
+    forever
+    {
+        qint64 timestamp = std::numeric_limits<qint64>::max();
+        for (int i = 0; i < channels.size(); ++i)
+        {
+            if (indices.at(i) < channels.at(i).size()) {
+                timestamp = qMin(timestamp, channels.at(i).at(indices.at(i)).timestamp);
+            }
+        }
+        if (timestamp == std::numeric_limits<qint64>::max())
+        {
+            break;
+        }
+
+        for (int i = 0; i < channels.size(); ++i)
+        {
+            while ((indices.at(i) < channels.at(i).size()) && (channels.at(i).at(indices.at(i)).timestamp == timestamp))
+            {
+                values[i] = channels.at(i).at(indices.at(i)).value;
+                indices[i]++;
+            }
+        }
+
+        stream << QString::number((timestamp - reference) / 1e9, 'f', 9);
+        for (int i = 0; i < values.size(); ++i)
+        {
+            stream << "," << values.at(i);
+        }
+        stream << "\n";
+    }
+
+    return true;
+}
+
+/*! \qmlmethod bool HalScope::exportBinary(url fileUrl)
+
+    Exports the samples inside the capture window to a binary file. The
+    file contains a header with the trigger time and the channel names
+    followed by the raw timestamp and value pairs of each channel.
+*/
+bool HalScope::exportBinary(const QUrl &fileUrl) const
+{
+    QFile file(fileUrl.toLocalFile());
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    qint64 begin;
+    qint64 end;
+    captureWindow(&begin, &end);
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_4);
+    stream << static_cast<quint32>(0x48534350); // HSCP
+    stream << static_cast<quint32>(1);          // version
+    stream << static_cast<qint64>(m_triggerTime);
+    stream << static_cast<quint32>(m_buffers.size());
+
+    const QStringList names = channelNames();
+    for (int i = 0; i < m_buffers.size(); ++i)
+    {
+        QVector<HalSample> samples;
+        windowSamples(i, begin, end, &samples);
+
+        stream << names.at(i);
+        stream << static_cast<quint32>(samples.size());
+        foreach (const HalSample &sample, samples)
+        {
+            stream << sample.timestamp << sample.value;
+        }
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+}; // namespace qtquickvcp
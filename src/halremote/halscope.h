@@ -0,0 +1,181 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef HALSCOPE_H
+#define HALSCOPE_H
+
+#include <QObject>
+#include <QQmlListProperty>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QUrl>
+#include <QVariant>
+#include <QHash>
+#include <machinetalk/protobuf/message.pb.h>
+#include "samplebuffer.h"
+
+namespace qtquickvcp {
+
+class HalRemoteComponent;
+
+class HalScope : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QQmlListProperty<QObject> sources READ sources NOTIFY sourcesChanged)
+    Q_PROPERTY(int bufferSize READ bufferSize WRITE setBufferSize NOTIFY bufferSizeChanged)
+    Q_PROPERTY(double captureTime READ captureTime WRITE setCaptureTime NOTIFY captureTimeChanged)
+    Q_PROPERTY(double preTrigger READ preTrigger WRITE setPreTrigger NOTIFY preTriggerChanged)
+    Q_PROPERTY(int triggerSource READ triggerSource WRITE setTriggerSource NOTIFY triggerSourceChanged)
+    Q_PROPERTY(TriggerMode triggerMode READ triggerMode WRITE setTriggerMode NOTIFY triggerModeChanged)
+    Q_PROPERTY(double triggerLevel READ triggerLevel WRITE setTriggerLevel NOTIFY triggerLevelChanged)
+    Q_PROPERTY(CaptureState state READ state NOTIFY stateChanged)
+    Q_ENUMS(TriggerMode)
+    Q_ENUMS(CaptureState)
+
+public:
+    explicit HalScope(QObject *parent = 0);
+    ~HalScope();
+
+    enum TriggerMode {
+        NoTrigger = 0,
+        RisingEdge = 1,
+        FallingEdge = 2,
+        AnyEdge = 3,
+        HighLevel = 4,
+        LowLevel = 5
+    };
+
+    enum CaptureState {
+        Idle = 0,
+        Armed = 1,
+        Triggered = 2,
+        Complete = 3
+    };
+
+    QQmlListProperty<QObject> sources()
+    {
+        return QQmlListProperty<QObject>(this, m_sources);
+    }
+
+    int bufferSize() const
+    {
+        return m_bufferSize;
+    }
+
+    double captureTime() const
+    {
+        return m_captureTime;
+    }
+
+    double preTrigger() const
+    {
+        return m_preTrigger;
+    }
+
+    int triggerSource() const
+    {
+        return m_triggerSource;
+    }
+
+    TriggerMode triggerMode() const
+    {
+        return m_triggerMode;
+    }
+
+    double triggerLevel() const
+    {
+        return m_triggerLevel;
+    }
+
+    CaptureState state() const
+    {
+        return m_state;
+    }
+
+    int channelCount() const
+    {
+        return m_buffers.count();
+    }
+
+    const SampleBuffer<HalSample> *channelBuffer(int channel) const
+    {
+        return m_buffers.at(channel);
+    }
+
+    Q_INVOKABLE QVariantList decimate(int channel, int buckets) const;
+    Q_INVOKABLE bool exportCsv(const QUrl &fileUrl) const;
+    Q_INVOKABLE bool exportBinary(const QUrl &fileUrl) const;
+
+public slots:
+    void setBufferSize(int bufferSize);
+    void setCaptureTime(double captureTime);
+    void setPreTrigger(double preTrigger);
+    void setTriggerSource(int triggerSource);
+    void setTriggerMode(TriggerMode triggerMode);
+    void setTriggerLevel(double triggerLevel);
+    void start();
+    void stop();
+
+private:
+    QList<QObject*> m_sources;
+    int             m_bufferSize;
+    double          m_captureTime;
+    double          m_preTrigger;
+    int             m_triggerSource;
+    TriggerMode     m_triggerMode;
+    double          m_triggerLevel;
+    CaptureState    m_state;
+
+    QList<SampleBuffer<HalSample>*> m_buffers;
+    QStringList     m_channelNames;
+    QHash<QObject*, int> m_remoteChannels;
+    QList<QMetaObject::Connection>  m_connections;
+    QElapsedTimer   m_elapsedTimer;
+    QTimer          m_postTriggerTimer;
+    qint64          m_triggerTime;
+    double          m_lastTriggerValue;
+    bool            m_lastTriggerValueValid;
+
+    void setState(CaptureState state);
+    void addSample(int channel, const QVariant &value);
+    void addRemoteSamples(const HalRemoteComponent *component, const machinetalk::Container &rx);
+    bool checkTrigger(double value) const;
+    void captureWindow(qint64 *begin, qint64 *end) const;
+    void windowSamples(int channel, qint64 begin, qint64 end, QVector<HalSample> *samples) const;
+    QStringList channelNames() const;
+
+private slots:
+    void finishCapture();
+
+signals:
+    void sourcesChanged(QQmlListProperty<QObject> arg);
+    void bufferSizeChanged(int bufferSize);
+    void captureTimeChanged(double captureTime);
+    void preTriggerChanged(double preTrigger);
+    void triggerSourceChanged(int triggerSource);
+    void triggerModeChanged(TriggerMode triggerMode);
+    void triggerLevelChanged(double triggerLevel);
+    void stateChanged(CaptureState state);
+    void captureFinished();
+}; // class HalScope
+} // namespace qtquickvcp
+
+#endif // HALSCOPE_H
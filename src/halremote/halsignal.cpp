@@ -21,9 +21,65 @@
 ****************************************************************************/
 
 #include "halsignal.h"
+#include "halgroup.h"
+#include "halremotecomponent.h"
 
 namespace qtquickvcp {
 
+/*!
+    \qmltype HalSignal
+    \instantiates QHalSignal
+    \inqmlmodule Machinekit.HalRemote
+    \brief A HAL signal.
+    \ingroup halremote
+
+    This component provides the counterpart of one signal of
+    a HAL group. The HalSignal component works in combination
+    with the \l HalGroup and is read-only.
+
+    \qml
+    HalSignal {
+        id: halSignal
+        name: "spindle-speed"
+    }
+    \endqml
+
+    \sa HalGroup
+*/
+
+/*! \qmlproperty string HalSignal::name
+
+    This property holds the name of the HAL signal.
+*/
+
+/*! \qmlproperty enumeration HalSignal::type
+
+    This property holds the type of the HAL signal. The type is
+    updated from the remote signal on the first full update.
+*/
+
+/*! \qmlproperty variant HalSignal::value
+
+    This property holds the value of the signal.
+*/
+
+/*! \qmlproperty bool HalSignal::enabled
+
+    This property holds whether the HAL signal is enabled or not. A disabled
+    signal will be ignored by the \l{HalGroup}.
+
+    The default value is \c{true}.
+*/
+
+/*! \qmlproperty bool HalSignal::synced
+
+    This property holds whether the signal is synced with the remote
+    HAL group or not.
+*/
+
+QMap<int, HalSignal*> HalSignal::s_registeredSignals;
+int HalSignal::s_registryIndex = 0;
+
 HalSignal::HalSignal(QObject *parent) :
     QObject(parent),
     m_name("default"),
@@ -31,8 +87,39 @@ HalSignal::HalSignal(QObject *parent) :
     m_value(false),
     m_handle(0),
     m_enabled(true),
-    m_synced(false)
+    m_synced(false),
+    m_registryIndex(s_registryIndex++)
+{
+    s_registeredSignals.insert(m_registryIndex, this);
+
+    if (parent != nullptr)  // signals created from C++ are not completed by the QML engine
+    {
+        updateRegistration();
+    }
+}
+
+HalSignal::~HalSignal()
 {
+    s_registeredSignals.remove(m_registryIndex);
+    HalGroup::removeContainerRegistration(this);
+}
+
+void HalSignal::componentComplete()
+{
+    updateRegistration();
+}
+
+/** Registers the signal with the groups containing it
+ *  and follows the parents of the signal to notice when it is moved.
+ */
+void HalSignal::updateRegistration()
+{
+    foreach (const QMetaObject::Connection &connection, m_parentConnections)
+    {
+        disconnect(connection);
+    }
+    m_parentConnections = HalRemoteComponent::connectContainerParents(this, SLOT(updateRegistration()));
+    HalGroup::updateContainerRegistration(this);
 }
 
 void HalSignal::setName(QString arg)
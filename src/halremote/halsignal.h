@@ -25,13 +25,17 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QMap>
+#include <QList>
+#include <QQmlParserStatus>
 #include <machinetalk/protobuf/message.pb.h>
 
 namespace qtquickvcp {
 
-class HalSignal : public QObject
+class HalSignal : public QObject, public QQmlParserStatus
 {
     Q_OBJECT
+    Q_INTERFACES(QQmlParserStatus)
     Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
     Q_PROPERTY(ValueType type READ type NOTIFY typeChanged)
     Q_PROPERTY(QVariant value READ value NOTIFY valueChanged)
@@ -42,6 +46,7 @@ class HalSignal : public QObject
 
 public:
     explicit HalSignal(QObject *parent = 0);
+    ~HalSignal();
 
     enum ValueType {
         Bit = machinetalk::HAL_BIT,
@@ -80,6 +85,15 @@ public:
         return m_synced;
     }
 
+    /** all existing signals in order of creation */
+    static const QMap<int, HalSignal*> &registeredSignals()
+    {
+        return s_registeredSignals;
+    }
+
+    void classBegin() {}
+    void componentComplete();
+
 public slots:
     void setName(QString arg);
     void setType(ValueType arg);
@@ -96,6 +110,9 @@ signals:
     void enabledChanged(bool arg);
     void syncedChanged(bool arg);
 
+private slots:
+    void updateRegistration();
+
 private:
     QString m_name;
     ValueType m_type;
@@ -103,6 +120,11 @@ private:
     int m_handle;
     bool m_enabled;
     bool m_synced;
+    int m_registryIndex;
+    QList<QMetaObject::Connection> m_parentConnections;
+
+    static QMap<int, HalSignal*> s_registeredSignals;
+    static int s_registryIndex;
 }; // class HalSignal
 } // namespace qtquickvcp
 
@@ -21,8 +21,11 @@
 ****************************************************************************/
 #include "plugin.h"
 #include "halpin.h"
+#include "halpinarray.h"
 #include "halsignal.h"
 #include "halremotecomponent.h"
+#include "halgroup.h"
+#include "halscope.h"
 
 void MachinekitHalRemotePlugin::registerTypes(const char *uri)
 {
@@ -34,7 +37,10 @@ void MachinekitHalRemotePlugin::registerTypes(const char *uri)
     Q_ASSERT(uri == QLatin1String("Machinekit.HalRemote"));
     qmlRegisterType<qtquickvcp::HalRemoteComponent>(uri, 1, 0, "HalRemoteComponent");
     qmlRegisterType<qtquickvcp::HalPin>(uri, 1, 0, "HalPin");
+    qmlRegisterType<qtquickvcp::HalPinArray>(uri, 1, 0, "HalPinArray");
     qmlRegisterType<qtquickvcp::HalSignal>(uri, 1, 0, "HalSignal");
+    qmlRegisterType<qtquickvcp::HalGroup>(uri, 1, 0, "HalGroup");
+    qmlRegisterType<qtquickvcp::HalScope>(uri, 1, 0, "HalScope");
 }
 
 void MachinekitHalRemotePlugin::initializeEngine(QQmlEngine *engine, const char *uri)
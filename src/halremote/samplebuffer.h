@@ -0,0 +1,130 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef SAMPLEBUFFER_H
+#define SAMPLEBUFFER_H
+
+#include <QVector>
+#include <atomic>
+
+namespace qtquickvcp {
+
+struct HalSample {
+    qint64 timestamp;   // ns since the start of the capture
+    double value;
+};
+
+/** Single producer ring buffer keeping the most recent samples
+ *  The writer never blocks and overwrites the oldest samples. Readers
+ *  copy a range of samples and drop the ones that have been overwritten
+ *  while copying, therefore no lock is necessary. The slot the writer
+ *  may be filling is never handed out, so one sample less than the
+ *  capacity is available to readers.
+ */
+template <typename T>
+class SampleBuffer
+{
+public:
+    explicit SampleBuffer(int capacity = 1024)
+    {
+        resize(capacity);
+    }
+
+    /** Resizes the buffer and discards all samples, must not be used while writing */
+    void resize(int capacity)
+    {
+        int size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_data.fill(T(), size);
+        m_mask = static_cast<quint64>(size - 1);
+        m_writeIndex.store(0, std::memory_order_release);
+    }
+
+    void clear()
+    {
+        m_writeIndex.store(0, std::memory_order_release);
+    }
+
+    int capacity() const
+    {
+        return m_data.size();
+    }
+
+    /** Index of the next sample that will be written */
+    quint64 writeIndex() const
+    {
+        return m_writeIndex.load(std::memory_order_acquire);
+    }
+
+    /** Index of the oldest sample still available, excluding the slot of the next write */
+    quint64 readIndex() const
+    {
+        const quint64 index = writeIndex() + 1;
+        const quint64 size = static_cast<quint64>(m_data.size());
+        return (index > size) ? (index - size) : 0;
+    }
+
+    void push(const T &sample)
+    {
+        const quint64 index = m_writeIndex.load(std::memory_order_relaxed);
+        m_data[static_cast<int>(index & m_mask)] = sample;
+        m_writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    /** Copies the samples [from, to) that are still available, returns the index of the first copied sample */
+    quint64 copy(quint64 from, quint64 to, QVector<T> *samples) const
+    {
+        const quint64 oldest = readIndex();
+        const quint64 newest = writeIndex();
+        from = qMax(from, oldest);
+        to = qMin(to, newest);
+        samples->clear();
+        if (from >= to) {
+            return from;
+        }
+
+        samples->reserve(static_cast<int>(to - from));
+        for (quint64 i = from; i < to; ++i) {
+            samples->append(m_data.at(static_cast<int>(i & m_mask)));
+        }
+
+        // drop samples overwritten by the writer in the meantime
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const quint64 valid = readIndex();
+        if (valid > from) {
+            const int overwritten = static_cast<int>(qMin(valid, to) - from);
+            samples->remove(0, overwritten);
+            from += static_cast<quint64>(overwritten);
+        }
+
+        return from;
+    }
+
+private:
+    QVector<T> m_data;
+    quint64 m_mask;
+    std::atomic<quint64> m_writeIndex;
+}; // class SampleBuffer
+} // namespace qtquickvcp
+
+#endif // SAMPLEBUFFER_H
@@ -0,0 +1,360 @@
+/****************************************************************************
+**
+** This file was generated by a code generator based on imatix/gsl
+** Any changes in this file will be lost.
+**
+****************************************************************************/
+#include "halgroupbase.h"
+#include <google/protobuf/text_format.h>
+#include "debughelper.h"
+
+#if defined(Q_OS_IOS)
+namespace gpb = google_public::protobuf;
+#else
+namespace gpb = google::protobuf;
+#endif
+
+using namespace nzmqt;
+
+namespace machinetalk {
+namespace halremote {
+
+/** Generic Halgroup Base implementation */
+HalgroupBase::HalgroupBase(QObject *parent) :
+    QObject(parent),
+    QQmlParserStatus(),
+    m_componentCompleted(false),
+    m_ready(false),
+    m_debugName("Halgroup Base"),
+    m_halgroupChannel(nullptr),
+    m_state(Down),
+    m_previousState(Down),
+    m_errorString("")
+{
+    // initialize halgroup channel
+    m_halgroupChannel = new halremote::HalgroupSubscribe(this);
+    m_halgroupChannel->setDebugName(m_debugName + " - halgroup");
+    connect(m_halgroupChannel, &halremote::HalgroupSubscribe::socketUriChanged,
+            this, &HalgroupBase::halgroupUriChanged);
+    connect(m_halgroupChannel, &halremote::HalgroupSubscribe::stateChanged,
+            this, &HalgroupBase::halgroupChannelStateChanged);
+    connect(m_halgroupChannel, &halremote::HalgroupSubscribe::socketMessageReceived,
+            this, &HalgroupBase::processHalgroupChannelMessage);
+
+    connect(m_halgroupChannel, &halremote::HalgroupSubscribe::heartbeatIntervalChanged,
+            this, &HalgroupBase::halgroupHeartbeatIntervalChanged);
+    // state machine
+    connect(this, &HalgroupBase::fsmUpEntered,
+            this, &HalgroupBase::fsmUpEntry);
+    connect(this, &HalgroupBase::fsmUpExited,
+            this, &HalgroupBase::fsmUpExit);
+    connect(this, &HalgroupBase::fsmDownConnect,
+            this, &HalgroupBase::fsmDownConnectEvent);
+    connect(this, &HalgroupBase::fsmTryingHalgroupUp,
+            this, &HalgroupBase::fsmTryingHalgroupUpEvent);
+    connect(this, &HalgroupBase::fsmTryingDisconnect,
+            this, &HalgroupBase::fsmTryingDisconnectEvent);
+    connect(this, &HalgroupBase::fsmSyncingChannelsSynced,
+            this, &HalgroupBase::fsmSyncingChannelsSyncedEvent);
+    connect(this, &HalgroupBase::fsmSyncingHalgroupTrying,
+            this, &HalgroupBase::fsmSyncingHalgroupTryingEvent);
+    connect(this, &HalgroupBase::fsmSyncingDisconnect,
+            this, &HalgroupBase::fsmSyncingDisconnectEvent);
+    connect(this, &HalgroupBase::fsmUpHalgroupTrying,
+            this, &HalgroupBase::fsmUpHalgroupTryingEvent);
+    connect(this, &HalgroupBase::fsmUpDisconnect,
+            this, &HalgroupBase::fsmUpDisconnectEvent);
+}
+
+HalgroupBase::~HalgroupBase()
+{
+}
+
+/** Add a topic that should be subscribed **/
+void HalgroupBase::addHalgroupTopic(const QString &name)
+{
+    m_halgroupChannel->addSocketTopic(name);
+}
+
+/** Removes a topic from the list of topics that should be subscribed **/
+void HalgroupBase::removeHalgroupTopic(const QString &name)
+{
+    m_halgroupChannel->removeSocketTopic(name);
+}
+
+/** Clears the the topics that should be subscribed **/
+void HalgroupBase::clearHalgroupTopics()
+{
+    m_halgroupChannel->clearSocketTopics();
+}
+
+void HalgroupBase::startHalgroupChannel()
+{
+    m_halgroupChannel->setReady(true);
+}
+
+void HalgroupBase::stopHalgroupChannel()
+{
+    m_halgroupChannel->setReady(false);
+}
+
+/** Processes all message received on halgroup */
+void HalgroupBase::processHalgroupChannelMessage(const QByteArray &topic, const Container &rx)
+{
+
+    // react to halgroup full update message
+    if (rx.type() == MT_HALGROUP_FULL_UPDATE)
+    {
+        halgroupFullUpdateReceived(topic, rx);
+    }
+
+    // react to halgroup incremental update message
+    if (rx.type() == MT_HALGROUP_INCREMENTAL_UPDATE)
+    {
+        halgroupIncrementalUpdateReceived(topic, rx);
+    }
+
+    // react to halgroup error message
+    if (rx.type() == MT_HALGROUP_ERROR)
+    {
+        // update error string with note
+        m_errorString = "";
+        for (int i = 0; i < rx.note_size(); ++i)
+        {
+            m_errorString.append(QString::fromStdString(rx.note(i)) + "\n");
+        }
+        emit errorStringChanged(m_errorString);
+        halgroupErrorReceived(topic, rx);
+    }
+
+    emit halgroupMessageReceived(topic, rx);
+}
+
+void HalgroupBase::fsmDown()
+{
+#ifdef QT_DEBUG
+    DEBUG_TAG(1, m_debugName, "State DOWN");
+#endif
+    m_state = Down;
+    emit stateChanged(m_state);
+}
+
+void HalgroupBase::fsmDownConnectEvent()
+{
+    if (m_state == Down)
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_debugName, "Event CONNECT");
+#endif
+        // handle state change
+        emit fsmDownExited(QPrivateSignal());
+        fsmTrying();
+        emit fsmTryingEntered(QPrivateSignal());
+        // execute actions
+        updateTopics();
+        startHalgroupChannel();
+     }
+}
+
+void HalgroupBase::fsmTrying()
+{
+#ifdef QT_DEBUG
+    DEBUG_TAG(1, m_debugName, "State TRYING");
+#endif
+    m_state = Trying;
+    emit stateChanged(m_state);
+}
+
+void HalgroupBase::fsmTryingHalgroupUpEvent()
+{
+    if (m_state == Trying)
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_debugName, "Event HALGROUP UP");
+#endif
+        // handle state change
+        emit fsmTryingExited(QPrivateSignal());
+        fsmSyncing();
+        emit fsmSyncingEntered(QPrivateSignal());
+        // execute actions
+     }
+}
+
+void HalgroupBase::fsmTryingDisconnectEvent()
+{
+    if (m_state == Trying)
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_debugName, "Event DISCONNECT");
+#endif
+        // handle state change
+        emit fsmTryingExited(QPrivateSignal());
+        fsmDown();
+        emit fsmDownEntered(QPrivateSignal());
+        // execute actions
+        stopHalgroupChannel();
+     }
+}
+
+void HalgroupBase::fsmSyncing()
+{
+#ifdef QT_DEBUG
+    DEBUG_TAG(1, m_debugName, "State SYNCING");
+#endif
+    m_state = Syncing;
+    emit stateChanged(m_state);
+}
+
+void HalgroupBase::fsmSyncingChannelsSyncedEvent()
+{
+    if (m_state == Syncing)
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_debugName, "Event CHANNELS SYNCED");
+#endif
+        // handle state change
+        emit fsmSyncingExited(QPrivateSignal());
+        fsmUp();
+        emit fsmUpEntered(QPrivateSignal());
+        // execute actions
+     }
+}
+
+void HalgroupBase::fsmSyncingHalgroupTryingEvent()
+{
+    if (m_state == Syncing)
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_debugName, "Event HALGROUP TRYING");
+#endif
+        // handle state change
+        emit fsmSyncingExited(QPrivateSignal());
+        fsmTrying();
+        emit fsmTryingEntered(QPrivateSignal());
+        // execute actions
+     }
+}
+
+void HalgroupBase::fsmSyncingDisconnectEvent()
+{
+    if (m_state == Syncing)
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_debugName, "Event DISCONNECT");
+#endif
+        // handle state change
+        emit fsmSyncingExited(QPrivateSignal());
+        fsmDown();
+        emit fsmDownEntered(QPrivateSignal());
+        // execute actions
+        stopHalgroupChannel();
+     }
+}
+
+void HalgroupBase::fsmUp()
+{
+#ifdef QT_DEBUG
+    DEBUG_TAG(1, m_debugName, "State UP");
+#endif
+    m_state = Up;
+    emit stateChanged(m_state);
+}
+void HalgroupBase::fsmUpEntry()
+{
+    syncSignals();
+}
+void HalgroupBase::fsmUpExit()
+{
+    unsyncSignals();
+}
+
+void HalgroupBase::fsmUpHalgroupTryingEvent()
+{
+    if (m_state == Up)
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_debugName, "Event HALGROUP TRYING");
+#endif
+        // handle state change
+        emit fsmUpExited(QPrivateSignal());
+        fsmTrying();
+        emit fsmTryingEntered(QPrivateSignal());
+        // execute actions
+     }
+}
+
+void HalgroupBase::fsmUpDisconnectEvent()
+{
+    if (m_state == Up)
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, m_debugName, "Event DISCONNECT");
+#endif
+        // handle state change
+        emit fsmUpExited(QPrivateSignal());
+        fsmDown();
+        emit fsmDownEntered(QPrivateSignal());
+        // execute actions
+        stopHalgroupChannel();
+     }
+}
+
+void HalgroupBase::halgroupChannelStateChanged(halremote::HalgroupSubscribe::State state)
+{
+
+    if (state == halremote::HalgroupSubscribe::Trying)
+    {
+        if (m_state == Up)
+        {
+            emit fsmUpHalgroupTrying(QPrivateSignal());
+        }
+    }
+
+    if (state == halremote::HalgroupSubscribe::Trying)
+    {
+        if (m_state == Syncing)
+        {
+            emit fsmSyncingHalgroupTrying(QPrivateSignal());
+        }
+    }
+
+    if (state == halremote::HalgroupSubscribe::Up)
+    {
+        if (m_state == Trying)
+        {
+            emit fsmTryingHalgroupUp(QPrivateSignal());
+        }
+    }
+}
+
+/** start trigger function */
+void HalgroupBase::start()
+{
+    if (m_state == Down) {
+        emit fsmDownConnect(QPrivateSignal());
+    }
+}
+
+/** stop trigger function */
+void HalgroupBase::stop()
+{
+    if (m_state == Trying) {
+        emit fsmTryingDisconnect(QPrivateSignal());
+    }
+    if (m_state == Syncing) {
+        emit fsmSyncingDisconnect(QPrivateSignal());
+    }
+    if (m_state == Up) {
+        emit fsmUpDisconnect(QPrivateSignal());
+    }
+}
+
+/** channels synced trigger function */
+void HalgroupBase::channelsSynced()
+{
+    if (m_state == Syncing) {
+        emit fsmSyncingChannelsSynced(QPrivateSignal());
+    }
+}
+} // namespace halremote
+} // namespace machinetalk
@@ -0,0 +1,208 @@
+/****************************************************************************
+**
+** This file was generated by a code generator based on imatix/gsl
+** Any changes in this file will be lost.
+**
+****************************************************************************/
+#ifndef HALGROUP_BASE_H
+#define HALGROUP_BASE_H
+#include <QObject>
+#include <QQmlParserStatus>
+#include <nzmqt/nzmqt.hpp>
+#include <machinetalk/protobuf/message.pb.h>
+#include <halremote/halgroupsubscribe.h>
+
+namespace machinetalk {
+namespace halremote {
+
+class HalgroupBase : public QObject
+,public QQmlParserStatus
+{
+    Q_OBJECT
+    Q_INTERFACES(QQmlParserStatus)
+    Q_PROPERTY(bool ready READ ready WRITE setReady NOTIFY readyChanged)
+    Q_PROPERTY(QString halgroupUri READ halgroupUri WRITE setHalgroupUri NOTIFY halgroupUriChanged)
+    Q_PROPERTY(QString debugName READ debugName WRITE setDebugName NOTIFY debugNameChanged)
+    Q_PROPERTY(State connectionState READ state NOTIFY stateChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY errorStringChanged)
+    Q_PROPERTY(int halgroupHeartbeatInterval READ halgroupHeartbeatInterval WRITE setHalgroupHeartbeatInterval NOTIFY halgroupHeartbeatIntervalChanged)
+    Q_ENUMS(State)
+
+public:
+    explicit HalgroupBase(QObject *parent = 0);
+    ~HalgroupBase();
+
+    enum State {
+        Down = 0,
+        Trying = 1,
+        Syncing = 2,
+        Up = 3,
+    };
+
+    void classBegin() {}
+    /** componentComplete is executed when the QML component is fully loaded */
+    void componentComplete()
+    {
+        m_componentCompleted = true;
+
+        if (m_ready == true)    // the component was set to ready before it was completed
+        {
+            start();
+        }
+    }
+
+    QString halgroupUri() const
+    {
+        return m_halgroupChannel->socketUri();
+    }
+
+    QString debugName() const
+    {
+        return m_debugName;
+    }
+
+    State state() const
+    {
+        return m_state;
+    }
+
+    QString errorString() const
+    {
+        return m_errorString;
+    }
+
+    int halgroupHeartbeatInterval() const
+    {
+        return m_halgroupChannel->heartbeatInterval();
+    }
+
+    bool ready() const
+    {
+        return m_ready;
+    }
+
+public slots:
+
+    void setHalgroupUri(QString uri)
+    {
+        m_halgroupChannel->setSocketUri(uri);
+    }
+
+    void setDebugName(QString debugName)
+    {
+        if (m_debugName == debugName)
+            return;
+
+        m_debugName = debugName;
+        emit debugNameChanged(debugName);
+    }
+
+    void setHalgroupHeartbeatInterval(int interval)
+    {
+        m_halgroupChannel->setHeartbeatInterval(interval);
+    }
+
+    void setReady(bool ready)
+    {
+        if (m_ready == ready)
+            return;
+
+        m_ready = ready;
+        emit readyChanged(ready);
+
+        if (m_componentCompleted == false)
+        {
+            return;
+        }
+
+        if (m_ready)
+        {
+            start();
+        }
+        else
+        {
+            stop();
+        }
+    }
+
+    void addHalgroupTopic(const QString &name);
+    void removeHalgroupTopic(const QString &name);
+    void clearHalgroupTopics();
+
+protected:
+    void start(); // start trigger
+    void stop(); // stop trigger
+    void channelsSynced(); // channels synced trigger
+
+private:
+    bool m_componentCompleted;
+    bool m_ready;
+    QString m_debugName;
+
+    QSet<QString> m_halgroupTopics;   // the topics we are interested in
+    halremote::HalgroupSubscribe *m_halgroupChannel;
+
+    State         m_state;
+    State         m_previousState;
+    QString       m_errorString;
+    // more efficient to reuse a protobuf Messages
+    Container m_halgroupRx;
+
+private slots:
+
+    void startHalgroupChannel();
+    void stopHalgroupChannel();
+    void halgroupChannelStateChanged(halremote::HalgroupSubscribe::State state);
+    void processHalgroupChannelMessage(const QByteArray &topic, const Container &rx);
+
+    void fsmDown();
+    void fsmDownConnectEvent();
+    void fsmTrying();
+    void fsmTryingHalgroupUpEvent();
+    void fsmTryingDisconnectEvent();
+    void fsmSyncing();
+    void fsmSyncingChannelsSyncedEvent();
+    void fsmSyncingHalgroupTryingEvent();
+    void fsmSyncingDisconnectEvent();
+    void fsmUp();
+    void fsmUpEntry();
+    void fsmUpExit();
+    void fsmUpHalgroupTryingEvent();
+    void fsmUpDisconnectEvent();
+
+    virtual void halgroupFullUpdateReceived(const QByteArray &topic, const Container &rx) = 0;
+    virtual void halgroupIncrementalUpdateReceived(const QByteArray &topic, const Container &rx) = 0;
+    virtual void halgroupErrorReceived(const QByteArray &topic, const Container &rx) = 0;
+    virtual void syncSignals() = 0;
+    virtual void unsyncSignals() = 0;
+    virtual void updateTopics() = 0;
+
+signals:
+    void halgroupUriChanged(QString uri);
+    void halgroupMessageReceived(const QByteArray &topic, const Container &rx);
+    void debugNameChanged(QString debugName);
+    void stateChanged(HalgroupBase::State state);
+    void errorStringChanged(QString errorString);
+    void halgroupHeartbeatIntervalChanged(int interval);
+    void readyChanged(bool ready);
+    // fsm
+    void fsmDownEntered(QPrivateSignal);
+    void fsmDownExited(QPrivateSignal);
+    void fsmDownConnect(QPrivateSignal);
+    void fsmTryingEntered(QPrivateSignal);
+    void fsmTryingExited(QPrivateSignal);
+    void fsmTryingHalgroupUp(QPrivateSignal);
+    void fsmTryingDisconnect(QPrivateSignal);
+    void fsmSyncingEntered(QPrivateSignal);
+    void fsmSyncingExited(QPrivateSignal);
+    void fsmSyncingChannelsSynced(QPrivateSignal);
+    void fsmSyncingHalgroupTrying(QPrivateSignal);
+    void fsmSyncingDisconnect(QPrivateSignal);
+    void fsmUpEntered(QPrivateSignal);
+    void fsmUpExited(QPrivateSignal);
+    void fsmUpHalgroupTrying(QPrivateSignal);
+    void fsmUpDisconnect(QPrivateSignal);
+};
+} // namespace halremote
+} // namespace machinetalk
+#endif //HALGROUP_BASE_H
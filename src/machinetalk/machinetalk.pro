@@ -19,6 +19,8 @@ SOURCES += $$PWD/common/rpcclient.cpp \
            $$PWD/common/subscribe.cpp \
            $$PWD/halremote/remotecomponentbase.cpp \
            $$PWD/halremote/halrcompsubscribe.cpp \
+           $$PWD/halremote/halgroupbase.cpp \
+           $$PWD/halremote/halgroupsubscribe.cpp \
            $$PWD/application/launchersubscribe.cpp \
            $$PWD/application/launcherbase.cpp \
            $$PWD/application/configbase.cpp \
@@ -35,6 +37,8 @@ HEADERS += $$PWD/common/rpcclient.h \
            $$PWD/common/subscribe.h \
            $$PWD/halremote/remotecomponentbase.h \
            $$PWD/halremote/halrcompsubscribe.h \
+           $$PWD/halremote/halgroupbase.h \
+           $$PWD/halremote/halgroupsubscribe.h \
            $$PWD/application/launchersubscribe.h \
            $$PWD/application/launcherbase.h \
            $$PWD/application/configbase.h \
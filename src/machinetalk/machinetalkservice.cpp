@@ -41,7 +41,10 @@ QString MachinetalkService::enumNameToCamelCase(const QString &name)
     return partList.join("");
 }
 
-void MachinetalkService::recurseDescriptor(const gpb::Descriptor *descriptor, QJsonObject *object)
+/** Initializes a JSON object from a protobuf descriptor
+ *  top level fields in skipFields are left out
+ **/
+void MachinetalkService::recurseDescriptor(const gpb::Descriptor *descriptor, QJsonObject *object, const FieldSet &skipFields)
 {
     for (int i = 0; i < descriptor->field_count(); ++i)
     {
@@ -50,6 +53,11 @@ void MachinetalkService::recurseDescriptor(const gpb::Descriptor *descriptor, QJ
         QJsonValue jsonValue;
 
         field = descriptor->field(i);
+        if (skipFields.contains(field))
+        {
+            continue;
+        }
+
         name = QString::fromStdString(field->camelcase_name());
         switch (field->cpp_type())
         {
@@ -113,10 +121,15 @@ void MachinetalkService::recurseDescriptor(const gpb::Descriptor *descriptor, QJ
     }
 }
 
-int MachinetalkService::recurseMessage(const gpb::Message &message, QJsonObject *object, const QString &fieldFilter, const QString &tempDir)
+/** Merges a protobuf message into a JSON object
+ *  top level fields in skipFields are left out,
+ *  returns the number of fields merged into the object
+ **/
+int MachinetalkService::recurseMessage(const gpb::Message &message, QJsonObject *object, const QString &fieldFilter, const QString &tempDir, const FieldSet &skipFields)
 {
     bool filterEnabled = !fieldFilter.isEmpty();
     bool isPosition = false;
+    int skippedFields = 0;
     const gpb::Reflection *reflection = message.GetReflection();
     gpb::vector< const gpb::FieldDescriptor * > output;
     reflection->ListFields(message, &output);
@@ -146,6 +159,11 @@ int MachinetalkService::recurseMessage(const gpb::Message &message, QJsonObject
             continue;
         }
 
+        if (skipFields.contains(field)) {
+            skippedFields++;
+            continue;
+        }
+
         if (!field->is_repeated())
         {
             switch (field->cpp_type())
@@ -251,7 +269,7 @@ int MachinetalkService::recurseMessage(const gpb::Message &message, QJsonObject
         }
     }
 
-    return output.size();
+    return output.size() - skippedFields;
 }
 
 void MachinetalkService::updateValue(const gpb::Message &message, QJsonValue *value, const QString &field, const QString &tempDir)
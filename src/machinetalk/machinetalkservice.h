@@ -5,6 +5,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QStringList>
+#include <QSet>
 #include <QDir>
 #include <QCoreApplication>
 #include <QUuid>
@@ -27,6 +28,8 @@ class MachinetalkService : public QObject
 public:
     explicit MachinetalkService(QObject *parent = 0);
 
+    typedef QSet<const google::protobuf::FieldDescriptor*> FieldSet;
+
     enum SocketState {
         Down = 1,
         Trying = 2,
@@ -54,11 +57,13 @@ public:
     static bool removeTempPath(const QString &name);
     static QString enumNameToCamelCase(const QString &name);
     static void recurseDescriptor(const google::protobuf::Descriptor *descriptor,
-                                  QJsonObject *object);
+                                  QJsonObject *object,
+                                  const FieldSet &skipFields = FieldSet());
     static int recurseMessage(const google::protobuf::Message &message,
                                QJsonObject *object,
                                const QString &fieldFilter = QString(),
-                               const QString &tempDir = QString("json"));
+                               const QString &tempDir = QString("json"),
+                               const FieldSet &skipFields = FieldSet());
     static void updateValue(const google::protobuf::Message &message,
                             QJsonValue *value,
                             const QString &field,
@@ -28,7 +28,6 @@ QtObject {
     property var status: { "synced": false }
     property var model: undefined
 
-    property int _lastLine: 1
     property bool _ready: status.synced
 
     on_ReadyChanged: {
@@ -42,25 +41,7 @@ QtObject {
 
     function updateLine() {
         if (_ready) {
-            var file = status.task.file;
-            var currentLine = status.motion.motionLine;
-            
-            if (_lastLine > currentLine) {
-                for (var line = 1; line <= _lastLine; ++line) {
-                    model.setData(file, line, false, GCodeProgramModel.ExecutedRole);
-                    model.setData(file, line, false, GCodeProgramModel.ActiveRole);
-                }
-                _lastLine = currentLine;
-            }
-
-            for (line = _lastLine; line < currentLine; ++line) {
-                model.setData(file, line, true, GCodeProgramModel.ExecutedRole);
-                model.setData(file, line, false, GCodeProgramModel.ActiveRole);
-            }
-
-            model.setData(file, currentLine, true, GCodeProgramModel.ActiveRole);
-
-            _lastLine = currentLine;
+            model.setActiveLine(status.task.file, status.motion.motionLine);
         }
     }
 }
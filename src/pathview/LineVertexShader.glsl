@@ -1,31 +1,40 @@
 // global
 uniform highp mat4 projectionMatrix;    // projection matrix
 uniform highp mat4 viewMatrix;          // view matrix
+uniform lowp vec4 palette[16];          // colors of the line states
 
-// line specific
-uniform highp mat4 modelMatrix;         // model matrix
-uniform lowp vec4 color;          // per-vertex color
-
-// vertex specific
-attribute highp vec4 position;    // per-vertex position
-uniform bool stipple;       // enable or disable stippling
+// vertex specific, positions are already transformed to world space
+attribute highp vec4 position;          // per-vertex position
+attribute lowp vec4 color;              // per-vertex color
+attribute highp vec3 stippleOrigin;     // origin of the stipple pattern
+attribute highp float stippleLength;    // length of the stipple pattern, 0 disables stippling
+attribute mediump float state;          // palette entry, 0 uses the vertex color
 
 varying lowp vec4 destinationColor;
 varying highp vec4 currentPosition;
 varying highp vec4 sourcePosition;
+varying highp float destinationStippleLength;
 
 void main() {
-    highp mat4 modelviewMatrix = viewMatrix * modelMatrix;
+    highp mat4 viewProjectionMatrix = projectionMatrix * viewMatrix;
 
-    destinationColor = color;
+    int paletteIndex = int(state * 255.0 + 0.5);  // the state bytes are normalized
+    if (paletteIndex > 0)
+    {
+        destinationColor = palette[paletteIndex];
+    }
+    else
+    {
+        destinationColor = color;
+    }
 
-    if (stipple)
+    destinationStippleLength = stippleLength;
+    if (stippleLength > 0.0)
     {
-        const highp vec4 sourcePoint = vec4(0.0, 0.0, 0.0, 1.0);
-        sourcePosition = projectionMatrix * modelviewMatrix * sourcePoint;
+        sourcePosition = viewProjectionMatrix * vec4(stippleOrigin, 1.0);
     }
 
-    currentPosition = projectionMatrix * modelviewMatrix * position;
+    currentPosition = viewProjectionMatrix * position;
 
     gl_Position = currentPosition;
 }
@@ -2,9 +2,9 @@
 uniform highp mat4 projectionMatrix;    // projection matrix
 uniform highp mat4 viewMatrix;          // view matrix
 
-// model specific
-uniform highp mat4 modelMatrix;         // model matrix
-uniform lowp vec4 color;                // per-vertex color
+// instance specific
+attribute highp mat4 modelMatrix;       // per-instance model matrix
+attribute lowp vec4 color;              // per-instance color
 
 // vertex specific
 attribute highp vec4 position;    // per-vertex position
@@ -24,20 +24,12 @@ struct Light {
 
 uniform Light light;
 
-// selection mode
-uniform lowp vec4 idColor;             // color to be used for selection mode
-uniform bool selectionMode;       // enables or disables the selection mode
-
 varying lowp vec4 destinationColor;  // the output colors
 
 void main(void) {
     highp mat4 modelviewMatrix = viewMatrix * modelMatrix;
 
-    if (selectionMode)
-    {
-        destinationColor = idColor;
-    }
-    else if (light.enabled)
+    if (light.enabled)
     {
         highp vec3 modelViewVertex = vec3(modelMatrix * position);          // transform vertex into eye space
         highp vec3 modelViewNormal = vec3(modelMatrix * vec4(normal, 0.0));            // transform normals orientation into eye space
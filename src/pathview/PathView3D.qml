@@ -292,7 +292,7 @@ GLView3D {
         function getToolInfo()
         {
             var toolInSpindle = status.io.toolInSpindle;
-            var toolTable = status.io.toolTable;
+            var toolTable = status.toolTable;
             var diameter = 0.0;
             var length = 0.0;
             var valid = false;
@@ -313,9 +313,9 @@ GLView3D {
 
         id: tool
         visible: pathView.toolVisible
-        position.x: _ready ? status.motion.position.x - status.io.toolOffset.x : 0
-        position.y: _ready ? status.motion.position.y - status.io.toolOffset.y : 0
-        position.z: (_ready ? status.motion.position.z - status.io.toolOffset.z : 0) + height
+        position.x: _ready ? status.position.x - status.toolOffset.x : 0
+        position.y: _ready ? status.position.y - status.toolOffset.y : 0
+        position.z: (_ready ? status.position.z - status.toolOffset.z : 0) + height
 
         cone: toolInfo.valid ? false : true
         radius: toolInfo.valid ? toolDiameter / 2.0 : 5
@@ -325,6 +325,22 @@ GLView3D {
         rotationAxis: Qt.vector3d(1,0,0)
     }
 
+    Backplot3D {
+        id: backplot
+        visible: pathView.livePlotVisible
+        toolPosition: _ready ? Qt.vector3d(status.position.x - status.toolOffset.x,
+                                           status.position.y - status.toolOffset.y,
+                                           status.position.z - status.toolOffset.z) : Qt.vector3d(0, 0, 0)
+        motionType: _ready ? status.motion.motionType : ApplicationStatus.NoneType
+        lineWidth: 2.0
+        jogColor: pathView.colors["backplotjog"]
+        traverseColor: pathView.colors["backplottraverse"]
+        feedColor: pathView.colors["backplotfeed"]
+        arcColor: pathView.colors["backplotarc"]
+        toolChangeColor: pathView.colors["backplottoolchange"]
+        probingColor: pathView.colors["backplotprobing"]
+    }
+
     Grid3D {
         visible: pathView.gridVisible && (pathView.viewMode !== "Perspective")
         colorAxis1: pathView.colors["grid"]
@@ -353,8 +369,6 @@ GLView3D {
                 return "XZ";
             }
         }
-
-        onPaint: coordinates.requestPaint()
     }
 
     BoundingBox3D {
@@ -389,8 +403,8 @@ GLView3D {
     }
 
     Coordinate3D {
-        property var g5xOffset: status.synced ? status.motion.g5xOffset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
-        property var g92Offset: status.synced ? status.motion.g92Offset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
+        property var g5xOffset: status.synced ? status.g5xOffset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
+        property var g92Offset: status.synced ? status.g92Offset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
         property int positionOffset: status.synced ? status.config.positionOffset : ApplicationStatus.RelativePositionOffset
 
         id: coordinates
@@ -428,8 +442,8 @@ GLView3D {
         textSize: 6 * sizeFactor
         color: pathView.colors["small_origin"]
         g5xIndex: status.synced ? status.motion.g5xIndex : 1
-        g5xOffset: status.synced ? status.motion.g5xOffset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
-        g92Offset: status.synced ? status.motion.g92Offset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
+        g5xOffset: status.synced ? status.g5xOffset.toVector3D() : Qt.vector3d(0.12345, 0.234, 123.12)
+        g92Offset: status.synced ? status.g92Offset.toVector3D() : Qt.vector3d(0.12345, 0.234, 123.12)
         visible: pathView.offsetsVisible && (status.config.positionOffset === ApplicationStatus.RelativePositionOffset)
         viewMode: pathView.viewMode
     }
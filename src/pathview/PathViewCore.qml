@@ -29,6 +29,7 @@ ApplicationItem {
     property alias gcodeProgramModel: gcodeProgramModel
     property alias gcodeProgramLoader: gcodeProgramLoader
     property alias previewClient: previewClient
+    property alias previewCache: previewCache
 
     property bool _ready: file.ready
     property bool _previewEnabled: settings.initialized && settings.values.preview.enable
@@ -39,10 +40,19 @@ ApplicationItem {
         if (_ready) {
             file.onUploadFinished.connect(fileUploadFinished);
             file.onDownloadFinished.connect(fileDownloadFinished);
+            file.onTransferStateChanged.connect(fileTransferStateChanged);
         }
         else {
             file.onUploadFinished.disconnect(fileUploadFinished);
             file.onDownloadFinished.disconnect(fileDownloadFinished);
+            file.onTransferStateChanged.disconnect(fileTransferStateChanged);
+        }
+    }
+
+    function fileTransferStateChanged() {
+        // the download truncates the local file, release the mapped source file before it is read
+        if (file.transferState === ApplicationFile.DownloadRunning) {
+            gcodeProgramModel.clear();
         }
     }
 
@@ -74,15 +84,33 @@ ApplicationItem {
     }
 
     function _executePreview() {
-        if (file.remoteFilePath.split('.').pop() === 'ngc') {   // only open ngc files
-            command.openProgram('preview', file.remoteFilePath);
-            command.runProgram('preview', 0);
+        if (file.remoteFilePath.split('.').pop() !== 'ngc') {   // only open ngc files
+            return;
+        }
+
+        if (status.synced) {
+            previewCache.lookup(file.localFilePath, _previewState());
+        }
+        else {  // the offsets are unknown, the preview cannot be cached
+            _runPreview();
         }
     }
 
+    function _runPreview() {
+        command.openProgram('preview', file.remoteFilePath);
+        command.runProgram('preview', 0);
+    }
+
+    function _previewState() {
+        // the preview depends on the coordinate system and offsets active when the interpreter starts,
+        // the offsets of the other coordinate systems are not published and checked by revalidation
+        return [status.motion.g5xIndex, status.motion.rotationXy,
+                status.g5xOffset.toString(), status.g92Offset.toString(), status.toolOffset.toString()].join(";");
+    }
+
     function updatePreview() {
         if (file.remoteFilePath !== "") {
-            _executePreview();
+            _runPreview();
         }
     }
 
@@ -122,6 +150,17 @@ ApplicationItem {
         id: gcodeProgramModel
     }
 
+    GCodePreviewCache {
+        id: previewCache
+        model: gcodeProgramModel
+        onCacheHit: {
+            if (revalidate) {
+                _runPreview();
+            }
+        }
+        onCacheMissed: _runPreview()
+    }
+
     GCodeProgramLoader {
         id: gcodeProgramLoader
         model: gcodeProgramModel
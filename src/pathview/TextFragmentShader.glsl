@@ -1,20 +1,35 @@
-uniform lowp sampler2D texture;             // The input texture.
+#ifdef GL_ES
+#ifdef GL_OES_standard_derivatives
+#extension GL_OES_standard_derivatives : enable
+#define DERIVATIVES
+#endif
+#else
+#define DERIVATIVES
+#endif
+
+uniform lowp sampler2D texture;             // signed distance field glyph atlas, the outline is at 0.5
+uniform mediump float smoothing;            // fixed antialiasing width, 0 uses the screen space derivatives
 
 varying lowp vec4 destinationColor;         // the output colors
 varying mediump vec2 destinationTexCoordinate; // the output texture coordinate
 
-// selection mode
-uniform lowp vec4 idColor;             // color to be used for selection mode
-uniform bool selectionMode;       // enables or disables the selection mode
-
 void main(void)
 {
-    if (!selectionMode)
+    mediump float distance = texture2D(texture, destinationTexCoordinate).a;
+    mediump float width = smoothing;
+#ifdef DERIVATIVES
+    if (width <= 0.0)
     {
-        gl_FragColor = destinationColor * texture2D(texture, destinationTexCoordinate);
+        // antialias over about one pixel independent of the zoom level
+        width = max(0.7 * length(vec2(dFdx(distance), dFdy(distance))), 0.004);
     }
-    else
+#endif
+    mediump float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+
+    if (alpha <= 0.0)
     {
-        gl_FragColor = idColor * texture2D(texture, destinationTexCoordinate);
+        discard;
     }
+
+    gl_FragColor = vec4(destinationColor.rgb, destinationColor.a * alpha);
 }
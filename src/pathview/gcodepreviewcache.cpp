@@ -0,0 +1,357 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "gcodepreviewcache.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrl>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cstring>
+
+namespace qtquickvcp {
+
+static const char cacheMagic[4] = { 'Q', 'V', 'P', 'C' };
+static const quint32 cacheVersion = 1;
+
+typedef struct {
+    char magic[4];
+    quint32 version;
+    quint32 arcSize;    // the arcs are stored raw, the layout depends on the compiler
+} CacheHeader;
+
+/*!
+    \qmltype GCodePreviewCache
+    \instantiates QGCodePreviewCache
+    \inqmlmodule Machinekit.PathView
+    \brief Caches the preview of programs on disk.
+    \ingroup pathview
+
+    The cache stores the preview of a \l GCodeProgramModel in a compact
+    binary file. The file name is a hash of the program file content and
+    a \c state string, e.g. the active offsets. When the program is
+    opened again, the preview is read from the memory mapped cache file
+    instead of running the preview interpreter on the machine.
+
+    \note The status only contains the offsets of the active coordinate
+    system. A program selecting another coordinate system may produce a
+    different preview with the same \c state, this is detected by
+    \l revalidate which is enabled by default.
+
+    \qml
+    GCodePreviewCache {
+        id: previewCache
+        model: gcodeProgramModel
+        onCacheHit: if (revalidate) runRemotePreview()
+        onCacheMissed: runRemotePreview()
+    }
+    \endqml
+*/
+
+/*! \qmlproperty string GCodePreviewCache::cachePath
+
+    This property holds the directory of the cache files. The default
+    value is a \c preview directory in the cache location of the application.
+*/
+
+/*! \qmlproperty int GCodePreviewCache::maximumFiles
+
+    This property holds the number of cache files to keep, the oldest
+    files are removed. The default value is \c{20}.
+*/
+
+/*! \qmlproperty bool GCodePreviewCache::revalidate
+
+    This property holds whether a cached preview should be checked
+    against the interpreter. When \c true, the preview of the next
+    interpreter run after a cache hit is collected in the background and
+    only replaces the cached preview when it differs. Set it to \c false
+    to trust the cache and skip the interpreter run. The default value
+    is \c{true}.
+*/
+
+/*! \qmlsignal GCodePreviewCache::cacheHit()
+
+    This signal is emitted when the preview was loaded from the cache.
+    If \l revalidate is set, the preview interpreter should be run.
+*/
+
+/*! \qmlsignal GCodePreviewCache::cacheMissed()
+
+    This signal is emitted when no cached preview exists, the preview
+    interpreter should be run. Its preview is cached when it is finished.
+*/
+
+GCodePreviewCache::GCodePreviewCache(QObject *parent) :
+    QObject(parent),
+    m_model(nullptr),
+    m_cachePath(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("preview")),
+    m_maximumFiles(20),
+    m_revalidate(true),
+    m_pendingStarted(false)
+{
+    connect(&m_keyWatcher, &QFutureWatcher<QString>::finished,
+            this, &GCodePreviewCache::keyCalculated);
+}
+
+/*! \qmlmethod GCodePreviewCache::lookup(string localFilePath, string state)
+
+    Loads the cached preview of the file at \a localFilePath with the
+    interpreter \a state into the model. The file is hashed on a worker
+    thread, \l cacheHit or \l cacheMissed is emitted when done.
+*/
+void GCodePreviewCache::lookup(const QString &localFilePath, const QString &state)
+{
+    QString filePath = QUrl(localFilePath).toLocalFile();
+    if (filePath.isEmpty())
+    {
+        filePath = localFilePath;
+    }
+
+    m_pendingKey.clear();
+    m_pendingStarted = false;
+    m_keyWatcher.setFuture(QtConcurrent::run(&GCodePreviewCache::cacheKey, filePath, state));
+}
+
+void GCodePreviewCache::setModel(GCodeProgramModel *arg)
+{
+    if (m_model == arg)
+    {
+        return;
+    }
+
+    if (m_model != nullptr)
+    {
+        disconnect(m_model, &GCodeProgramModel::previewStarted,
+                   this, &GCodePreviewCache::previewStarted);
+        disconnect(m_model, &GCodeProgramModel::previewFinished,
+                   this, &GCodePreviewCache::previewFinished);
+        disconnect(m_model, &GCodeProgramModel::revalidationFinished,
+                   this, &GCodePreviewCache::revalidationFinished);
+    }
+
+    m_model = arg;
+
+    if (m_model != nullptr)
+    {
+        connect(m_model, &GCodeProgramModel::previewStarted,
+                this, &GCodePreviewCache::previewStarted);
+        connect(m_model, &GCodeProgramModel::previewFinished,
+                this, &GCodePreviewCache::previewFinished);
+        connect(m_model, &GCodeProgramModel::revalidationFinished,
+                this, &GCodePreviewCache::revalidationFinished);
+    }
+
+    emit modelChanged(arg);
+}
+
+void GCodePreviewCache::setCachePath(const QString &cachePath)
+{
+    if (m_cachePath == cachePath)
+    {
+        return;
+    }
+
+    m_cachePath = cachePath;
+    emit cachePathChanged(cachePath);
+}
+
+void GCodePreviewCache::setMaximumFiles(int maximumFiles)
+{
+    if (m_maximumFiles == maximumFiles)
+    {
+        return;
+    }
+
+    m_maximumFiles = maximumFiles;
+    emit maximumFilesChanged(maximumFiles);
+}
+
+void GCodePreviewCache::setRevalidate(bool revalidate)
+{
+    if (m_revalidate == revalidate)
+    {
+        return;
+    }
+
+    m_revalidate = revalidate;
+    emit revalidateChanged(revalidate);
+}
+
+/** Runs on a worker thread, returns an empty key if the file cannot be read */
+QString GCodePreviewCache::cacheKey(const QString &filePath, const QString &state)
+{
+    QFile file(filePath);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    if (!file.open(QIODevice::ReadOnly) || !hash.addData(&file))
+    {
+        return QString();
+    }
+    hash.addData(state.toUtf8());
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString GCodePreviewCache::cacheFilePath(const QString &key) const
+{
+    return QDir(m_cachePath).filePath(key + ".preview");
+}
+
+bool GCodePreviewCache::loadPreview(const QString &key, GCodePreviewStore *previewStore) const
+{
+    QFile file(cacheFilePath(key));
+    CacheHeader header;
+
+    if (!file.open(QIODevice::ReadOnly) || (file.size() < static_cast<qint64>(sizeof(header))))
+    {
+        return false;
+    }
+
+    const uchar *data = file.map(0, file.size());
+    if (data == nullptr)
+    {
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+    const bool valid = (memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) == 0)
+                       && (header.version == cacheVersion)
+                       && (header.arcSize == sizeof(GCodePreviewStore::Arc))
+                       && previewStore->read(data + sizeof(header), file.size() - sizeof(header));
+    file.unmap(const_cast<uchar*>(data));
+
+    return valid;
+}
+
+bool GCodePreviewCache::storePreview(const QString &key, const GCodePreviewStore &previewStore) const
+{
+    if (!QDir().mkpath(m_cachePath))
+    {
+        return false;
+    }
+
+    QSaveFile file(cacheFilePath(key));
+    CacheHeader header;
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    header.version = cacheVersion;
+    header.arcSize = sizeof(GCodePreviewStore::Arc);
+
+    if ((file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header))
+        || !previewStore.write(&file))
+    {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+/** Removes the oldest cache files */
+void GCodePreviewCache::removeOldFiles() const
+{
+    const QFileInfoList files = QDir(m_cachePath).entryInfoList(QStringList() << "*.preview", QDir::Files, QDir::Time);
+
+    for (int i = qMax(0, m_maximumFiles); i < files.size(); ++i)
+    {
+        QFile::remove(files.at(i).filePath());
+    }
+}
+
+void GCodePreviewCache::keyCalculated()
+{
+    const QString key = m_keyWatcher.result();
+    GCodePreviewStore previewStore;
+
+    if (key.isEmpty() || (m_model == nullptr))
+    {
+        emit cacheMissed();
+        return;
+    }
+
+    if (!loadPreview(key, &previewStore))
+    {
+        m_pendingKey = key;
+        m_pendingStarted = false;
+        emit cacheMissed();
+        return;
+    }
+
+    m_model->replacePreview(previewStore);
+    if (m_revalidate)
+    {
+        m_pendingKey = key;     // a changed preview replaces the cached one
+        m_pendingStarted = false;
+        m_model->beginRevalidation();
+    }
+    emit cacheHit();
+}
+
+/** Binds the pending key to the first preview started after the lookup */
+void GCodePreviewCache::previewStarted()
+{
+    if (m_pendingKey.isEmpty())
+    {
+        return;
+    }
+
+    if (m_pendingStarted)
+    {
+        m_pendingKey.clear();   // another preview replaced the one of the key
+        m_pendingStarted = false;
+        return;
+    }
+
+    m_pendingStarted = true;
+}
+
+void GCodePreviewCache::previewFinished()
+{
+    if (m_pendingKey.isEmpty() || !m_pendingStarted || (m_model == nullptr))
+    {
+        return;     // no preview pending or a preview started before the lookup finished
+    }
+
+    const QString key = m_pendingKey;
+    m_pendingKey.clear();
+    m_pendingStarted = false;
+
+    if (storePreview(key, m_model->previewStore()))
+    {
+        removeOldFiles();
+    }
+}
+
+/** A changed preview has already been stored, a matching one keeps the cache file */
+void GCodePreviewCache::revalidationFinished()
+{
+    m_pendingKey.clear();
+    m_pendingStarted = false;
+}
+}; // namespace qtquickvcp
@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef GCODEPREVIEWCACHE_H
+#define GCODEPREVIEWCACHE_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include "gcodeprogrammodel.h"
+
+namespace qtquickvcp {
+
+class GCodePreviewCache : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(GCodeProgramModel *model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(QString cachePath READ cachePath WRITE setCachePath NOTIFY cachePathChanged)
+    Q_PROPERTY(int maximumFiles READ maximumFiles WRITE setMaximumFiles NOTIFY maximumFilesChanged)
+    Q_PROPERTY(bool revalidate READ revalidate WRITE setRevalidate NOTIFY revalidateChanged)
+
+public:
+    explicit GCodePreviewCache(QObject *parent = 0);
+
+    GCodeProgramModel * model() const
+    {
+        return m_model;
+    }
+
+    QString cachePath() const
+    {
+        return m_cachePath;
+    }
+
+    int maximumFiles() const
+    {
+        return m_maximumFiles;
+    }
+
+    bool revalidate() const
+    {
+        return m_revalidate;
+    }
+
+signals:
+    void modelChanged(GCodeProgramModel * arg);
+    void cachePathChanged(const QString &cachePath);
+    void maximumFilesChanged(int maximumFiles);
+    void revalidateChanged(bool revalidate);
+    void cacheHit();
+    void cacheMissed();
+
+public slots:
+    void lookup(const QString &localFilePath, const QString &state);
+    void setModel(GCodeProgramModel * arg);
+    void setCachePath(const QString &cachePath);
+    void setMaximumFiles(int maximumFiles);
+    void setRevalidate(bool revalidate);
+
+private:
+    GCodeProgramModel * m_model;
+    QString m_cachePath;
+    int m_maximumFiles;
+    bool m_revalidate;
+    QFutureWatcher<QString> m_keyWatcher;
+    QString m_pendingKey;   // key of the preview being executed, stored when it is finished
+    bool m_pendingStarted;  // the preview of the pending key has been started
+
+    static QString cacheKey(const QString &filePath, const QString &state);
+    QString cacheFilePath(const QString &key) const;
+    bool loadPreview(const QString &key, GCodePreviewStore *previewStore) const;
+    bool storePreview(const QString &key, const GCodePreviewStore &previewStore) const;
+    void removeOldFiles() const;
+
+private slots:
+    void keyCalculated();
+    void previewStarted();
+    void previewFinished();
+    void revalidationFinished();
+}; // class GCodePreviewCache
+} // namespace qtquickvcp
+
+#endif // GCODEPREVIEWCACHE_H
@@ -0,0 +1,371 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "gcodepreviewstore.h"
+#include <cstring>
+#include <limits>
+
+using namespace machinetalk;
+
+namespace qtquickvcp {
+
+template<typename T>
+static bool writeColumn(QIODevice *device, const QVector<T> &column)
+{
+    const quint32 count = static_cast<quint32>(column.size());
+    const qint64 bytes = static_cast<qint64>(count) * sizeof(T);
+
+    return (device->write(reinterpret_cast<const char*>(&count), sizeof(count)) == sizeof(count))
+            && (device->write(reinterpret_cast<const char*>(column.constData()), bytes) == bytes);
+}
+
+template<typename T>
+static bool readColumn(const uchar **data, const uchar *end, QVector<T> *column)
+{
+    quint32 count;
+
+    if ((end - *data) < static_cast<qint64>(sizeof(count)))
+    {
+        return false;
+    }
+    memcpy(&count, *data, sizeof(count));
+    *data += sizeof(count);
+
+    if (count > static_cast<quint32>(std::numeric_limits<int>::max()))
+    {
+        return false;
+    }
+
+    const qint64 bytes = static_cast<qint64>(count) * sizeof(T);
+    if ((end - *data) < bytes)
+    {
+        return false;
+    }
+    column->resize(static_cast<int>(count));
+    memcpy(column->data(), *data, static_cast<size_t>(bytes));
+    *data += bytes;
+
+    return true;
+}
+
+/** Columnar storage of the preview of a program
+ *
+ *  Moves are stored as packed arrays of their type, line, present axes and
+ *  arc parameters. Offset and plane changes are rare and kept as complete
+ *  messages in a side table, the remaining items only keep type and line.
+ *  The columns are implicitly shared, a copy is a cheap read-only snapshot
+ *  that can be passed to other threads.
+ **/
+GCodePreviewStore::GCodePreviewStore()
+{
+}
+
+void GCodePreviewStore::append(int row, const Preview &preview)
+{
+    const PreviewType type = preview.type();
+    int dataIndex = -1;
+    quint16 axisMask = 0;
+
+    m_types.append(static_cast<quint8>(type));
+    m_rows.append(row);
+    m_valueOffsets.append(m_values.size());
+
+    switch (type)
+    {
+    case PV_ARC_FEED:
+    {
+        Arc arc;
+        arc.firstEnd = preview.first_end();
+        arc.secondEnd = preview.second_end();
+        arc.firstAxis = preview.first_axis();
+        arc.secondAxis = preview.second_axis();
+        arc.axisEndPoint = preview.axis_end_point();
+        arc.rotation = preview.rotation();
+        dataIndex = m_arcs.size();
+        m_arcs.append(arc);
+    }
+    // fall through, arcs have a position too
+    case PV_STRAIGHT_FEED:
+    case PV_STRAIGHT_TRAVERSE:
+    {
+        const Position &position = preview.pos();
+        const bool present[AxisCount] = { position.has_x(), position.has_y(), position.has_z(),
+                                          position.has_a(), position.has_b(), position.has_c(),
+                                          position.has_u(), position.has_v(), position.has_w() };
+        const double values[AxisCount] = { position.x(), position.y(), position.z(),
+                                           position.a(), position.b(), position.c(),
+                                           position.u(), position.v(), position.w() };
+        for (int i = 0; i < AxisCount; ++i)
+        {
+            if (present[i])
+            {
+                axisMask |= (1 << i);
+                m_values.append(values[i]);
+            }
+        }
+        break;
+    }
+    case PV_SET_G5X_OFFSET:
+    case PV_SET_G92_OFFSET:
+    case PV_USE_TOOL_OFFSET:
+    case PV_SELECT_PLANE:
+        dataIndex = m_operations.size();
+        m_operations.append(preview);
+        break;
+    default:
+        break;
+    }
+
+    m_axisMasks.append(axisMask);
+    m_dataIndices.append(dataIndex);
+}
+
+void GCodePreviewStore::clear()
+{
+    m_types.clear();
+    m_rows.clear();
+    m_axisMasks.clear();
+    m_valueOffsets.clear();
+    m_dataIndices.clear();
+    m_values.clear();
+    m_arcs.clear();
+    m_operations.clear();
+}
+
+bool GCodePreviewStore::isMove(int index) const
+{
+    const quint8 type = m_types.at(index);
+    return (type == PV_STRAIGHT_FEED) || (type == PV_STRAIGHT_TRAVERSE) || (type == PV_ARC_FEED);
+}
+
+/** Writes the axes present in the move to position, the other axes are cleared */
+void GCodePreviewStore::position(int index, Position *position) const
+{
+    const quint16 axisMask = m_axisMasks.at(index);
+    const double *values = m_values.constData() + m_valueOffsets.at(index);
+
+    position->Clear();
+    if (axisMask & (1 << 0)) { position->set_x(*values++); }
+    if (axisMask & (1 << 1)) { position->set_y(*values++); }
+    if (axisMask & (1 << 2)) { position->set_z(*values++); }
+    if (axisMask & (1 << 3)) { position->set_a(*values++); }
+    if (axisMask & (1 << 4)) { position->set_b(*values++); }
+    if (axisMask & (1 << 5)) { position->set_c(*values++); }
+    if (axisMask & (1 << 6)) { position->set_u(*values++); }
+    if (axisMask & (1 << 7)) { position->set_v(*values++); }
+    if (axisMask & (1 << 8)) { position->set_w(*values++); }
+}
+
+/** Returns the arc parameters of an arc feed */
+const GCodePreviewStore::Arc &GCodePreviewStore::arc(int index) const
+{
+    return m_arcs.at(m_dataIndices.at(index));
+}
+
+/** Returns the complete message of an offset or plane change */
+const Preview &GCodePreviewStore::operation(int index) const
+{
+    return m_operations.at(m_dataIndices.at(index));
+}
+
+/** Writes the columns as raw arrays in host byte order, the operations as serialized messages */
+bool GCodePreviewStore::write(QIODevice *device) const
+{
+    if (!(writeColumn(device, m_types) && writeColumn(device, m_rows) && writeColumn(device, m_axisMasks)
+          && writeColumn(device, m_valueOffsets) && writeColumn(device, m_dataIndices)
+          && writeColumn(device, m_values) && writeColumn(device, m_arcs)))
+    {
+        return false;
+    }
+
+    const quint32 count = static_cast<quint32>(m_operations.size());
+    if (device->write(reinterpret_cast<const char*>(&count), sizeof(count)) != sizeof(count))
+    {
+        return false;
+    }
+
+    for (const Preview &operation: m_operations)
+    {
+        const std::string message = operation.SerializeAsString();
+        const quint32 length = static_cast<quint32>(message.size());
+        if ((device->write(reinterpret_cast<const char*>(&length), sizeof(length)) != sizeof(length))
+            || (device->write(message.data(), length) != length))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/** Reads the columns written with write from data, e.g. a memory mapped file */
+bool GCodePreviewStore::read(const uchar *data, qint64 size)
+{
+    const uchar *end = data + size;
+    quint32 count;
+
+    clear();
+
+    if (!(readColumn(&data, end, &m_types) && readColumn(&data, end, &m_rows) && readColumn(&data, end, &m_axisMasks)
+          && readColumn(&data, end, &m_valueOffsets) && readColumn(&data, end, &m_dataIndices)
+          && readColumn(&data, end, &m_values) && readColumn(&data, end, &m_arcs)))
+    {
+        clear();
+        return false;
+    }
+
+    if ((end - data) < static_cast<qint64>(sizeof(count)))
+    {
+        clear();
+        return false;
+    }
+    memcpy(&count, data, sizeof(count));
+    data += sizeof(count);
+
+    if (count > static_cast<quint32>((end - data) / static_cast<qint64>(sizeof(quint32))))
+    {
+        clear();    // each operation has at least its length
+        return false;
+    }
+
+    m_operations.resize(static_cast<int>(count));
+    for (quint32 i = 0; i < count; ++i)
+    {
+        quint32 length;
+        if ((end - data) < static_cast<qint64>(sizeof(length)))
+        {
+            clear();
+            return false;
+        }
+        memcpy(&length, data, sizeof(length));
+        data += sizeof(length);
+
+        if (((end - data) < static_cast<qint64>(length)) || !m_operations[static_cast<int>(i)].ParseFromArray(data, static_cast<int>(length)))
+        {
+            clear();
+            return false;
+        }
+        data += length;
+    }
+
+    if (!isConsistent())
+    {
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+/** Checks that all items have a known type and only reference existing values, arcs and operations */
+bool GCodePreviewStore::isConsistent() const
+{
+    const int itemCount = m_types.size();
+    if ((m_rows.size() != itemCount) || (m_axisMasks.size() != itemCount)
+        || (m_valueOffsets.size() != itemCount) || (m_dataIndices.size() != itemCount))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < itemCount; ++i)
+    {
+        const int type = m_types.at(i);
+        const quint16 axisMask = m_axisMasks.at(i);
+        const int valueOffset = m_valueOffsets.at(i);
+        const int dataIndex = m_dataIndices.at(i);
+        int valueCount = 0;
+
+        if (!PreviewType_IsValid(type) || ((axisMask >> AxisCount) != 0))
+        {
+            return false;
+        }
+
+        for (int j = 0; j < AxisCount; ++j)
+        {
+            valueCount += (axisMask >> j) & 1;
+        }
+        if ((valueOffset < 0) || (valueOffset > (m_values.size() - valueCount)))
+        {
+            return false;
+        }
+
+        switch (type)
+        {
+        case PV_ARC_FEED:
+            if ((dataIndex < 0) || (dataIndex >= m_arcs.size()))
+            {
+                return false;
+            }
+            break;
+        case PV_SET_G5X_OFFSET:
+        case PV_SET_G92_OFFSET:
+        case PV_USE_TOOL_OFFSET:
+        case PV_SELECT_PLANE:
+            if ((dataIndex < 0) || (dataIndex >= m_operations.size()))
+            {
+                return false;
+            }
+            break;
+        default:
+            if (dataIndex != -1)
+            {
+                return false;
+            }
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool GCodePreviewStore::operator==(const GCodePreviewStore &other) const
+{
+    if ((m_types != other.m_types) || (m_rows != other.m_rows) || (m_axisMasks != other.m_axisMasks)
+        || (m_valueOffsets != other.m_valueOffsets) || (m_dataIndices != other.m_dataIndices)
+        || (m_values != other.m_values) || (m_operations.size() != other.m_operations.size())
+        || (m_arcs.size() != other.m_arcs.size()))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < m_arcs.size(); ++i)
+    {
+        const Arc &arc = m_arcs.at(i);
+        const Arc &otherArc = other.m_arcs.at(i);
+        if ((arc.firstEnd != otherArc.firstEnd) || (arc.secondEnd != otherArc.secondEnd)
+            || (arc.firstAxis != otherArc.firstAxis) || (arc.secondAxis != otherArc.secondAxis)
+            || (arc.axisEndPoint != otherArc.axisEndPoint) || (arc.rotation != otherArc.rotation))
+        {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < m_operations.size(); ++i)
+    {
+        if (m_operations.at(i).SerializeAsString() != other.m_operations.at(i).SerializeAsString())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+}; // namespace qtquickvcp
@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef GCODEPREVIEWSTORE_H
+#define GCODEPREVIEWSTORE_H
+
+#include <QVector>
+#include <QIODevice>
+#include <machinetalk/protobuf/preview.pb.h>
+
+namespace qtquickvcp {
+
+class GCodePreviewStore
+{
+public:
+    enum { AxisCount = 9 };
+
+    typedef struct {
+        double firstEnd;
+        double secondEnd;
+        double firstAxis;
+        double secondAxis;
+        double axisEndPoint;
+        int rotation;
+    } Arc;
+
+    GCodePreviewStore();
+
+    void append(int row, const machinetalk::Preview &preview);
+    void clear();
+
+    int size() const
+    {
+        return m_types.size();
+    }
+
+    const quint8 *types() const
+    {
+        return m_types.constData();
+    }
+
+    const int *rows() const
+    {
+        return m_rows.constData();
+    }
+
+    machinetalk::PreviewType type(int index) const
+    {
+        return static_cast<machinetalk::PreviewType>(m_types.at(index));
+    }
+
+    int row(int index) const
+    {
+        return m_rows.at(index);
+    }
+
+    bool isMove(int index) const;
+    void position(int index, machinetalk::Position *position) const;
+    const Arc &arc(int index) const;
+    const machinetalk::Preview &operation(int index) const;
+
+    bool write(QIODevice *device) const;
+    bool read(const uchar *data, qint64 size);
+
+    bool operator==(const GCodePreviewStore &other) const;
+    bool operator!=(const GCodePreviewStore &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    // one entry per preview item
+    QVector<quint8> m_types;
+    QVector<int> m_rows;            // model row of the line, -1 if unknown
+    QVector<quint16> m_axisMasks;   // axes present in the position of a move
+    QVector<int> m_valueOffsets;    // first axis value of a move
+    QVector<int> m_dataIndices;     // arc of an arc feed or operation of a rare item, -1 otherwise
+
+    QVector<double> m_values;       // values of the present axes, packed in xyzabcuvw order
+    QVector<Arc> m_arcs;
+    QVector<machinetalk::Preview> m_operations; // side table for offsets and plane changes
+
+    bool isConsistent() const;
+}; // class GCodePreviewStore
+} // namespace qtquickvcp
+
+#endif // GCODEPREVIEWSTORE_H
@@ -56,34 +56,19 @@ void GCodeProgramLoader::load()
         remoteFilePath = QDir(remotePath).filePath(fileInfo.fileName());
     }
 
-    QFile file(localFilePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    QSharedPointer<GCodeSourceFile> sourceFile(new GCodeSourceFile());
+    if (!sourceFile->open(localFilePath))
     {
         emit loadingFailed();
         return;
     }
 
-    int lineNumber = 0;
-
-    while (!file.atEnd()) {
-        file.readLine();
-        lineNumber++;
-    }
-
+    // the lines are served from the mapped file, only the line offsets are kept in memory
     m_model->beginUpdate();
-    m_model->prepareFile(remoteFilePath, lineNumber);
-
-    lineNumber = 0;
-    file.reset();
-    while (!file.atEnd()) {
-        QByteArray line = file.readLine();
-        lineNumber++;
-        m_model->setData(remoteFilePath, lineNumber, QString(line), GCodeProgramModel::GCodeRole);
-    }
-
+    m_model->prepareFile(remoteFilePath, sourceFile->lineCount());
+    m_model->setSourceFile(remoteFilePath, sourceFile);
     m_model->endUpdate();
 
-    file.close();
     emit loadingFinished();
 }
 }; // namespace qtquickvcp
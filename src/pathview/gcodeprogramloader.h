@@ -24,7 +24,6 @@
 #define GCODEPROGRAMLOADER_H
 
 #include <QObject>
-#include <QFile>
 #include <QFileInfo>
 #include <QDir>
 #include <QUrl>
@@ -28,13 +28,17 @@ using namespace machinetalk;
 namespace qtquickvcp {
 
 GCodeProgramModel::GCodeProgramModel(QObject *parent) :
-    QAbstractListModel(parent)
+    QAbstractListModel(parent),
+    m_rowCount(0),
+    m_publishedPreviewItems(0),
+    m_revalidationPending(false),
+    m_revalidating(false),
+    m_activeLine(0)
 {
 }
 
 GCodeProgramModel::~GCodeProgramModel()
 {
-    qDeleteAll(m_items);
 }
 
 QVariant GCodeProgramModel::data(const QModelIndex &index, int role) const
@@ -93,7 +97,7 @@ Qt::ItemFlags GCodeProgramModel::flags(const QModelIndex &index) const
 int GCodeProgramModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
-    return m_items.count();
+    return m_rowCount;
 }
 
 QHash<int, QByteArray> GCodeProgramModel::roleNames() const
@@ -108,9 +112,25 @@ QHash<int, QByteArray> GCodeProgramModel::roleNames() const
     return roles;
 }
 
-QLinkedList<GCodeProgramModel::PreviewItem> GCodeProgramModel::previewItems() const
+/** Returns the preview, a copy of the store is a snapshot sharing the data */
+const GCodePreviewStore &GCodeProgramModel::previewStore() const
 {
-    return m_previewItems;
+    return m_previewStore;
+}
+
+/** Serves the G-code of the file lazily from sourceFile, lines previously set with setData are discarded.
+ *  Call between beginUpdate and endUpdate, no change notification is sent.
+ **/
+void GCodeProgramModel::setSourceFile(const QString &fileName, const QSharedPointer<GCodeSourceFile> &sourceFile)
+{
+    if (!m_fileIndices.contains(fileName))
+    {
+        return;
+    }
+
+    FileIndex &fileIndex = m_fileIndices[fileName];
+    fileIndex.sourceFile = sourceFile;
+    fileIndex.lines.clear();
 }
 
 void GCodeProgramModel::prepareFile(const QString &fileName, int lineCount)
@@ -123,7 +143,7 @@ void GCodeProgramModel::prepareFile(const QString &fileName, int lineCount)
     }
     else
     {
-        fileIndex.index = m_items.count();
+        fileIndex.index = m_rowCount;
         fileIndex.count = 0;
     }
 
@@ -131,12 +151,12 @@ void GCodeProgramModel::prepareFile(const QString &fileName, int lineCount)
     int lastRow = (fileIndex.index + lineCount - 1);
     int rowCount = lastRow - firstRow + 1;
 
-    beginInsertRows(QModelIndex(), firstRow, lastRow);
-    for (int i = firstRow; i <= lastRow; ++i)
+    if (rowCount > 0)
     {
-        m_items.insert(i, new GCodeProgramItem(fileName, (i - fileIndex.index + 1)));
+        beginInsertRows(QModelIndex(), firstRow, lastRow);
+        insertFlags(firstRow, rowCount);
+        endInsertRows();
     }
-    endInsertRows();
 
     QHashIterator<QString, FileIndex> i(m_fileIndices);
     while (i.hasNext()) {
@@ -168,12 +188,12 @@ void GCodeProgramModel::removeFile(const QString &fileName)
     int lastRow = fileIndex.index + fileIndex.count - 1;
     int rowCount = lastRow - firstRow + 1;
 
-    beginRemoveRows(QModelIndex(), firstRow, lastRow);
-    for (int i = lastRow; i >= firstRow; i--)
+    if (rowCount > 0)
     {
-        delete m_items.takeAt(i);
+        beginRemoveRows(QModelIndex(), firstRow, lastRow);
+        removeFlags(firstRow, rowCount);
+        endRemoveRows();
     }
-    endRemoveRows();
 
     QHashIterator<QString, FileIndex> i(m_fileIndices);
     while (i.hasNext()) {
@@ -187,6 +207,12 @@ void GCodeProgramModel::removeFile(const QString &fileName)
     }
 
     m_fileIndices.remove(fileName);
+
+    if (m_activeFileName == fileName)
+    {
+        m_activeFileName.clear();
+        m_activeLine = 0;
+    }
 }
 
 void GCodeProgramModel::addLine(const QString &fileName)
@@ -205,7 +231,7 @@ void GCodeProgramModel::addLine(const QString &fileName)
     int row = fileIndex.index + fileIndex.count - 1;
 
     beginInsertRows(QModelIndex(), row, row);
-    m_items.insert(row, new GCodeProgramItem(fileName, fileIndex.count));
+    insertFlags(row, 1);
     endInsertRows();
 
     QHashIterator<QString, FileIndex> i(m_fileIndices);
@@ -224,10 +250,8 @@ void GCodeProgramModel::addLine(const QString &fileName)
 
 void GCodeProgramModel::addPreviewItem(const QModelIndex &index, const Preview &previewItem)
 {
-    PreviewItem item;
-    item.modelIndex = index;
-    item.previewItem = previewItem;
-    m_previewItems.append(item);
+    GCodePreviewStore &previewStore = m_revalidating ? m_revalidationStore : m_previewStore;
+    previewStore.append(index.isValid() ? index.row() : -1, previewItem);
 }
 
 QVariant GCodeProgramModel::data(const QString &fileName, int lineNumber, int role) const
@@ -248,18 +272,23 @@ bool GCodeProgramModel::setData(const QString &fileName, int lineNumber, const Q
 
 void GCodeProgramModel::clear()
 {
-    if (m_items.count() == 0)
+    if (m_rowCount == 0)
     {
         return;
     }
 
-    beginRemoveRows(QModelIndex(), 0, (m_items.count()-1));
-    qDeleteAll(m_items);
-    m_items.clear();
-    m_previewItems.clear();
+    beginRemoveRows(QModelIndex(), 0, (m_rowCount - 1));
+    removeFlags(0, m_rowCount);
+    m_previewStore.clear();
+    m_publishedPreviewItems = 0;
+    m_revalidationPending = false;
+    m_revalidating = false;
+    m_revalidationStore.clear();
     endRemoveRows();
 
     m_fileIndices.clear();
+    m_activeFileName.clear();
+    m_activeLine = 0;
 }
 
 void GCodeProgramModel::clearPreview(bool update)
@@ -268,7 +297,11 @@ void GCodeProgramModel::clearPreview(bool update)
     {
         beginUpdate();
     }
-    m_previewItems.clear();
+    m_previewStore.clear();
+    m_publishedPreviewItems = 0;
+    m_revalidationPending = false;
+    m_revalidating = false;
+    m_revalidationStore.clear();
     if (update)
     {
         endUpdate();
@@ -285,29 +318,235 @@ void GCodeProgramModel::endUpdate()
     endResetModel();
 }
 
+/** Starts a preview that is streamed in parts, the model rows are not reset */
+void GCodeProgramModel::beginPreview()
+{
+    if (m_revalidationPending)
+    {
+        m_revalidationPending = false;
+        m_revalidating = true;
+        m_revalidationStore.clear();
+        return;
+    }
+
+    m_revalidating = false;
+    m_previewStore.clear();
+    m_publishedPreviewItems = 0;
+    emit previewStarted();
+}
+
+/** Announces the preview items added since the last update */
+void GCodeProgramModel::updatePreview()
+{
+    const int first = m_publishedPreviewItems;
+
+    if (m_revalidating || (m_previewStore.size() == first))
+    {
+        return;
+    }
+
+    m_publishedPreviewItems = m_previewStore.size();
+    emit previewItemsAdded(first, m_previewStore.size() - first);
+}
+
+void GCodeProgramModel::endPreview()
+{
+    if (m_revalidating)
+    {
+        const GCodePreviewStore previewStore = m_revalidationStore;
+        m_revalidating = false;
+        m_revalidationStore.clear();
+        if (previewStore != m_previewStore)
+        {
+            replacePreview(previewStore);
+        }
+        emit revalidationFinished();
+        return;
+    }
+
+    updatePreview();
+    emit previewFinished();
+}
+
+/** Replaces the preview at once, e.g. with a cached preview */
+void GCodeProgramModel::replacePreview(const GCodePreviewStore &previewStore)
+{
+    m_revalidating = false;
+    m_previewStore = previewStore;
+    m_publishedPreviewItems = 0;
+    emit previewStarted();
+    updatePreview();
+    emit previewFinished();
+}
+
+/** Collects the next preview without showing it
+ *
+ *  The current preview is only replaced when the new preview differs
+ *  from it, e.g. when a cached preview is checked against the interpreter.
+ **/
+void GCodeProgramModel::beginRevalidation()
+{
+    m_revalidationPending = true;
+}
+
+/** Sets the line being executed, the lines before it are marked as executed
+ *
+ *  Only the lines between the previous and the new active line are updated,
+ *  a single dataChanged signal is emitted for this range. A line number past
+ *  the end of the file marks the whole file as executed, 0 clears the progress.
+ **/
+void GCodeProgramModel::setActiveLine(const QString &fileName, int lineNumber)
+{
+    if (fileName != m_activeFileName)
+    {
+        clearActiveLine();
+    }
+
+    if (!m_fileIndices.contains(fileName))
+    {
+        return;
+    }
+
+    const FileIndex fileIndex = m_fileIndices.value(fileName);
+    lineNumber = qBound(0, lineNumber, fileIndex.count + 1);
+    if ((fileName == m_activeFileName) && (lineNumber == m_activeLine))
+    {
+        return;
+    }
+
+    updateProgress(fileIndex, m_activeLine, lineNumber);
+    m_activeFileName = fileName;
+    m_activeLine = lineNumber;
+}
+
+void GCodeProgramModel::clearActiveLine()
+{
+    if (m_fileIndices.contains(m_activeFileName))
+    {
+        updateProgress(m_fileIndices.value(m_activeFileName), m_activeLine, 0);
+    }
+
+    m_activeFileName.clear();
+    m_activeLine = 0;
+}
+
+/** Returns the name of the file containing row, there are only a few files */
+QString GCodeProgramModel::fileName(int row) const
+{
+    QHashIterator<QString, FileIndex> i(m_fileIndices);
+    while (i.hasNext()) {
+        i.next();
+        const FileIndex &fileIndex = i.value();
+        if ((row >= fileIndex.index) && (row < (fileIndex.index + fileIndex.count)))
+        {
+            return i.key();
+        }
+    }
+
+    return QString();
+}
+
+/** Inserts count rows with cleared flags at row, QBitArray has no insert */
+void GCodeProgramModel::insertFlags(int row, int count)
+{
+    QBitArray *flags[] = { &m_selected, &m_active, &m_executed };
+
+    for (QBitArray *bits: flags)
+    {
+        bits->resize(m_rowCount + count);
+        for (int i = (m_rowCount - 1); i >= row; --i)
+        {
+            bits->setBit(i + count, bits->testBit(i));
+        }
+        bits->fill(false, row, row + count);
+    }
+
+    m_rowCount += count;
+}
+
+void GCodeProgramModel::removeFlags(int row, int count)
+{
+    QBitArray *flags[] = { &m_selected, &m_active, &m_executed };
+
+    for (QBitArray *bits: flags)
+    {
+        for (int i = (row + count); i < m_rowCount; ++i)
+        {
+            bits->setBit(i - count, bits->testBit(i));
+        }
+        bits->resize(m_rowCount - count);
+    }
+
+    m_rowCount -= count;
+}
+
+void GCodeProgramModel::updateProgress(const FileIndex &fileIndex, int previousLine, int lineNumber)
+{
+    const int firstLine = qMax(1, qMin(previousLine, lineNumber));
+    const int lastLine = qMin(fileIndex.count, qMax(previousLine, lineNumber));
+
+    if (firstLine > lastLine)
+    {
+        return;
+    }
+
+    const int firstRow = fileIndex.index + firstLine - 1;
+    const int lastRow = fileIndex.index + lastLine - 1;
+    const int activeRow = fileIndex.index + lineNumber - 1;
+    const int executedEnd = qBound(firstRow, activeRow, lastRow + 1);   // rows before the active row are executed
+
+    m_executed.fill(true, firstRow, executedEnd);
+    m_executed.fill(false, executedEnd, lastRow + 1);
+    m_active.fill(false, firstRow, lastRow + 1);
+    if ((lineNumber >= 1) && (lineNumber <= fileIndex.count))
+    {
+        m_active.setBit(activeRow);
+    }
+
+    emit dataChanged(index(firstRow), index(lastRow), QVector<int>() << ActiveRole << ExecutedRole);
+}
+
 QVariant GCodeProgramModel::internalData(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || (index.row() > (m_items.count() - 1)))
+    if (!index.isValid() || (index.row() > (m_rowCount - 1)))
     {
         return QVariant();
     }
 
-    GCodeProgramItem *item = m_items.at(index.row());
+    const int row = index.row();
 
     switch (role)
     {
-    case LineNumberRole:
-        return QVariant(item->lineNumber());
-    case FileNameRole:
-        return QVariant(item->fileName());
-    case GCodeRole:
-        return QVariant(item->gcode());
     case SelectedRole:
-        return QVariant(item->selected());
+        return QVariant(m_selected.testBit(row));
     case ActiveRole:
-        return QVariant(item->active());
+        return QVariant(m_active.testBit(row));
     case ExecutedRole:
-        return QVariant(item->executed());
+        return QVariant(m_executed.testBit(row));
+    default:
+        break;
+    }
+
+    const QString name = fileName(row);
+    const FileIndex fileIndex = m_fileIndices.value(name);
+    const int lineNumber = row - fileIndex.index + 1;
+
+    switch (role)
+    {
+    case LineNumberRole:
+        return QVariant(lineNumber);
+    case FileNameRole:
+        return QVariant(name);
+    case GCodeRole:
+        if (fileIndex.lines.contains(lineNumber))
+        {
+            return QVariant(fileIndex.lines.value(lineNumber));
+        }
+        else if (!fileIndex.sourceFile.isNull())
+        {
+            return QVariant(fileIndex.sourceFile->line(lineNumber - 1));
+        }
+        return QVariant(QString());
     default:
         return QVariant();
     }
@@ -317,35 +556,36 @@ QVariant GCodeProgramModel::internalData(const QModelIndex &index, int role) con
 
 bool GCodeProgramModel::internalSetData(const QModelIndex &index, const QVariant &value, int role)
 {
-    if (!index.isValid())
+    if (!index.isValid() || (index.row() > (m_rowCount - 1)))
     {
         return false;
     }
 
-    GCodeProgramItem *item = m_items.at(index.row());
-
+    const int row = index.row();
 
     switch (role)
     {
-    case LineNumberRole:
-        item->setLineNumber(value.toInt());
-        break;
-    case FileNameRole:
-        item->setFileName(value.toString());
-        break;
     case GCodeRole:
-        item->setGcode(value.toString());
+    {
+        const QString name = fileName(row);
+        if (!m_fileIndices.contains(name))
+        {
+            return false;
+        }
+        FileIndex &fileIndex = m_fileIndices[name];
+        fileIndex.lines.insert(row - fileIndex.index + 1, value.toString());
         break;
+    }
     case SelectedRole:
-        item->setSelected(value.toBool());
+        m_selected.setBit(row, value.toBool());
         break;
     case ActiveRole:
-        item->setActive(value.toBool());
+        m_active.setBit(row, value.toBool());
         break;
     case ExecutedRole:
-        item->setExecuted(value.toBool());
+        m_executed.setBit(row, value.toBool());
         break;
-    default:
+    default:    // file name and line number are defined by the file layout
         return false;
     }
 
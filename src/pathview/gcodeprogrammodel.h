@@ -24,8 +24,10 @@
 #define GCODEPROGRAMMODEL_H
 
 #include <QAbstractListModel>
-#include <QLinkedList>
-#include "gcodeprogramitem.h"
+#include <QBitArray>
+#include <QSharedPointer>
+#include "gcodepreviewstore.h"
+#include "gcodesourcefile.h"
 
 namespace qtquickvcp {
 
@@ -35,12 +37,6 @@ class GCodeProgramModel : public QAbstractListModel
     Q_ENUMS(GCodeProgramRoles)
 
 public:
-    class PreviewItem {
-    public:
-        QModelIndex modelIndex;
-        machinetalk::Preview previewItem;
-    };
-
     enum GCodeProgramRoles {
             FileNameRole = Qt::UserRole,
             LineNumberRole,
@@ -61,7 +57,9 @@ public:
     Qt::ItemFlags flags(const QModelIndex &index) const;
     int rowCount(const QModelIndex &parent = QModelIndex()) const;
     QHash<int, QByteArray> roleNames() const;
-    QLinkedList<PreviewItem> previewItems() const;
+    const GCodePreviewStore &previewStore() const;
+    void setSourceFile(const QString &fileName, const QSharedPointer<GCodeSourceFile> &sourceFile);
+    void replacePreview(const GCodePreviewStore &previewStore);
 
 public slots:
     void prepareFile(const QString &fileName, int lineCount);
@@ -74,17 +72,44 @@ public slots:
     void clearPreview(bool update = true);
     void beginUpdate();
     void endUpdate();
+    void beginPreview();
+    void updatePreview();
+    void endPreview();
+    void beginRevalidation();
+    void setActiveLine(const QString &fileName, int lineNumber);
+    void clearActiveLine();
+
+signals:
+    void previewStarted();
+    void previewItemsAdded(int first, int count);
+    void previewFinished();
+    void revalidationFinished();
 
 private:
     typedef struct {
         int index;
         int count;
+        QSharedPointer<GCodeSourceFile> sourceFile;  // serves the lines of a loaded file
+        QHash<int, QString> lines;                  // lines set with setData, by line number
     } FileIndex;
 
-    QList<GCodeProgramItem*> m_items;
+    int m_rowCount;
+    QBitArray m_selected;
+    QBitArray m_active;
+    QBitArray m_executed;
     QHash<QString, FileIndex> m_fileIndices;
-    QLinkedList<PreviewItem> m_previewItems;
+    GCodePreviewStore m_previewStore;
+    int m_publishedPreviewItems;    // number of preview items announced with previewItemsAdded
+    bool m_revalidationPending;     // the next preview is collected in the revalidation store
+    bool m_revalidating;
+    GCodePreviewStore m_revalidationStore;
+    QString m_activeFileName;       // file of the program progress
+    int m_activeLine;               // line being executed, the lines before are executed
 
+    QString fileName(int row) const;
+    void insertFlags(int row, int count);
+    void removeFlags(int row, int count);
+    void updateProgress(const FileIndex &fileIndex, int previousLine, int lineNumber);
     QVariant internalData(const QModelIndex &index, int role) const;
     bool internalSetData(const QModelIndex &index, const QVariant &value, int role);
 }; // class GCodeProgramModel
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "gcodesourcefile.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <cstring>
+#include <functional>
+
+namespace qtquickvcp {
+
+static const qint64 scanChunkSize = 16 * 1024 * 1024;
+
+/** Read-only access to the lines of a memory mapped G-code file
+ *
+ *  Opening the file maps it into memory and builds an index of the line
+ *  offsets, the newline scan runs in parallel on chunks of the mapping.
+ *  The text of a line is only decoded when it is requested, the memory
+ *  used by the index is proportional to the line count.
+ **/
+GCodeSourceFile::GCodeSourceFile() :
+    m_data(nullptr),
+    m_size(0)
+{
+}
+
+GCodeSourceFile::~GCodeSourceFile()
+{
+    close();
+}
+
+bool GCodeSourceFile::open(const QString &filePath)
+{
+    close();
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size == 0)  // an empty file cannot be mapped and has no lines
+    {
+        return true;
+    }
+
+    m_data = reinterpret_cast<const char*>(m_file.map(0, m_size));
+    if (m_data == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    QVector<Chunk> chunks;
+    for (qint64 begin = 0; begin < m_size; begin += scanChunkSize)
+    {
+        Chunk chunk;
+        chunk.begin = begin;
+        chunk.end = qMin(begin + scanChunkSize, m_size);
+        chunks.append(chunk);
+    }
+
+    const std::function<QVector<qint64>(const Chunk&)> scan = std::bind(&GCodeSourceFile::scanChunk, m_data, std::placeholders::_1);
+    const QList<QVector<qint64> > chunkOffsets = QtConcurrent::blockingMapped<QList<QVector<qint64> > >(chunks, scan);
+
+    int lineCount = 1;
+    for (const QVector<qint64> &offsets: chunkOffsets)
+    {
+        lineCount += offsets.size();
+    }
+
+    m_lineOffsets.reserve(lineCount);
+    m_lineOffsets.append(0);
+    for (const QVector<qint64> &offsets: chunkOffsets)
+    {
+        m_lineOffsets += offsets;
+    }
+
+    if (m_lineOffsets.last() == m_size)  // no line after the final newline
+    {
+        m_lineOffsets.removeLast();
+    }
+
+    return true;
+}
+
+void GCodeSourceFile::close()
+{
+    if (m_data != nullptr)
+    {
+        m_file.unmap(const_cast<uchar*>(reinterpret_cast<const uchar*>(m_data)));
+        m_data = nullptr;
+    }
+    m_file.close();
+    m_size = 0;
+    m_lineOffsets.clear();
+}
+
+int GCodeSourceFile::lineCount() const
+{
+    return m_lineOffsets.size();
+}
+
+/** Returns the line at index without the line ending */
+QString GCodeSourceFile::line(int index) const
+{
+    if ((index < 0) || (index >= m_lineOffsets.size()))
+    {
+        return QString();
+    }
+
+    const qint64 begin = m_lineOffsets.at(index);
+    qint64 end = (index < (m_lineOffsets.size() - 1)) ? (m_lineOffsets.at(index + 1) - 1) : m_size;
+
+    if ((end > begin) && (m_data[end - 1] == '\r'))
+    {
+        end--;
+    }
+
+    return QString::fromUtf8(m_data + begin, static_cast<int>(end - begin));
+}
+
+/** Returns the offsets of the lines starting inside the chunk, memchr is vectorized by the C library */
+QVector<qint64> GCodeSourceFile::scanChunk(const char *data, const Chunk &chunk)
+{
+    QVector<qint64> offsets;
+    const char *position = data + chunk.begin;
+    const char *end = data + chunk.end;
+
+    while (position < end)
+    {
+        const char *newline = static_cast<const char*>(memchr(position, '\n', static_cast<size_t>(end - position)));
+        if (newline == nullptr)
+        {
+            break;
+        }
+        offsets.append((newline - data) + 1);
+        position = newline + 1;
+    }
+
+    return offsets;
+}
+}; // namespace qtquickvcp
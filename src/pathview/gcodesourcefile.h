@@ -0,0 +1,59 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef GCODESOURCEFILE_H
+#define GCODESOURCEFILE_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+namespace qtquickvcp {
+
+class GCodeSourceFile
+{
+public:
+    GCodeSourceFile();
+    ~GCodeSourceFile();
+
+    bool open(const QString &filePath);
+    void close();
+    int lineCount() const;
+    QString line(int index) const;
+
+private:
+    typedef struct {
+        qint64 begin;
+        qint64 end;
+    } Chunk;
+
+    QFile m_file;
+    const char *m_data;
+    qint64 m_size;
+    QVector<qint64> m_lineOffsets;  // offset of the first character of every line
+
+    static QVector<qint64> scanChunk(const char *data, const Chunk &chunk);
+
+    Q_DISABLE_COPY(GCodeSourceFile)
+}; // class GCodeSourceFile
+} // namespace qtquickvcp
+
+#endif // GCODESOURCEFILE_H
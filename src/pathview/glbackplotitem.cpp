@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#include "glbackplotitem.h"
+
+namespace qtquickvcp {
+
+/** Live plot of the tool position drawn as a single line strip
+ *
+ *  Every change of the tool position appends a sample to a fixed size ring
+ *  of positions owned by the GLView. Only the new samples are uploaded on
+ *  the next frame, when the ring is full the oldest positions are dropped.
+ *  The color of a sample is selected with the motion type through the line
+ *  palette, changing a color does not touch the positions.
+ *
+ *  The positions are used in view coordinates, the transformation of the
+ *  item is not applied.
+ **/
+GLBackplotItem::GLBackplotItem(QQuickItem *parent) :
+    GLItem(parent),
+    m_toolPosition(QVector3D(0, 0, 0)),
+    m_motionType(NoneMotion),
+    m_capacity(100000),
+    m_lineWidth(1.0),
+    m_jogColor(QColor(Qt::yellow)),
+    m_traverseColor(QColor(Qt::cyan)),
+    m_feedColor(QColor(Qt::red)),
+    m_arcColor(QColor(Qt::magenta)),
+    m_toolChangeColor(QColor(Qt::darkYellow)),
+    m_probingColor(QColor(Qt::darkMagenta)),
+    m_clearPending(false),
+    m_hasLastSample(false)
+{
+    connect(this, &GLBackplotItem::visibleChanged,
+            this, &GLBackplotItem::needsUpdate);
+    connect(this, &GLBackplotItem::capacityChanged,
+            this, &GLBackplotItem::needsUpdate);
+    connect(this, &GLBackplotItem::lineWidthChanged,
+            this, &GLBackplotItem::needsUpdate);
+    connect(this, &GLBackplotItem::jogColorChanged,
+            this, &GLBackplotItem::needsUpdate);
+    connect(this, &GLBackplotItem::traverseColorChanged,
+            this, &GLBackplotItem::needsUpdate);
+    connect(this, &GLBackplotItem::feedColorChanged,
+            this, &GLBackplotItem::needsUpdate);
+    connect(this, &GLBackplotItem::arcColorChanged,
+            this, &GLBackplotItem::needsUpdate);
+    connect(this, &GLBackplotItem::toolChangeColorChanged,
+            this, &GLBackplotItem::needsUpdate);
+    connect(this, &GLBackplotItem::probingColorChanged,
+            this, &GLBackplotItem::needsUpdate);
+}
+
+/** Called on synchronization while the GUI thread is blocked */
+void GLBackplotItem::paint(GLView *glView)
+{
+    glView->updatePalette(this, linePalette());
+    glView->updateTrail(this, m_capacity, m_lineWidth);
+
+    if (m_clearPending)
+    {
+        glView->clearTrail(this);
+        m_clearPending = false;
+    }
+
+    for (const Sample &sample: m_pendingSamples)
+    {
+        glView->appendTrail(this, sample.position, sample.state);
+    }
+    m_pendingSamples.clear();
+}
+
+void GLBackplotItem::selectDrawable(void *pointer)
+{
+    Q_UNUSED(pointer)   // the trail can not be picked
+}
+
+/** Removes all plotted positions, the plot continues at the current position */
+void GLBackplotItem::clear()
+{
+    m_pendingSamples.clear();
+    m_clearPending = true;
+    m_hasLastSample = false;
+    appendSample();
+    emit needsUpdate();
+}
+
+void GLBackplotItem::setToolPosition(QVector3D arg)
+{
+    if (m_toolPosition != arg) {
+        m_toolPosition = arg;
+        emit toolPositionChanged(arg);
+        appendSample();
+    }
+}
+
+void GLBackplotItem::setMotionType(int arg)
+{
+    if (m_motionType != arg) {
+        m_motionType = arg;
+        emit motionTypeChanged(arg);
+    }
+}
+
+/** Queues the current tool position, positions repeated in the same state are skipped */
+void GLBackplotItem::appendSample()
+{
+    Sample sample;
+
+    sample.position = m_toolPosition;
+    sample.state = lineState();
+
+    if (m_hasLastSample && (m_lastSample.position == sample.position) && (m_lastSample.state == sample.state))
+    {
+        return;
+    }
+
+    m_lastSample = sample;
+    m_hasLastSample = true;
+
+    if (m_pendingSamples.size() >= m_capacity)    // older samples would be dropped from the ring anyway
+    {
+        m_pendingSamples.removeFirst();
+    }
+    m_pendingSamples.append(sample);
+
+    if (m_pendingSamples.size() == 1)   // one update request per frame is enough
+    {
+        emit needsUpdate();
+    }
+}
+
+/** Returns the palette entry of the current motion type */
+int GLBackplotItem::lineState() const
+{
+    switch (m_motionType)
+    {
+    case TraverseMotion:
+    case IndexRotaryMotion:
+        return 2;
+    case FeedMotion:
+        return 3;
+    case ArcMotion:
+        return 4;
+    case ToolchangeMotion:
+        return 5;
+    case ProbingMotion:
+        return 6;
+    default:
+        return 1;   // no motion from a program, the machine is jogged
+    }
+}
+
+/** Returns the colors of all line states, ordered as returned by lineState */
+QList<QColor> GLBackplotItem::linePalette() const
+{
+    QList<QColor> palette;
+
+    palette << QColor()
+            << m_jogColor << m_traverseColor << m_feedColor
+            << m_arcColor << m_toolChangeColor << m_probingColor;
+
+    return palette;
+}
+}; // namespace qtquickvcp
@@ -0,0 +1,221 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#ifndef GLBACKPLOTITEM_H
+#define GLBACKPLOTITEM_H
+
+#include "glitem.h"
+
+namespace qtquickvcp {
+
+class GLBackplotItem : public GLItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QVector3D toolPosition READ toolPosition WRITE setToolPosition NOTIFY toolPositionChanged)
+    Q_PROPERTY(int motionType READ motionType WRITE setMotionType NOTIFY motionTypeChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(float lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(QColor jogColor READ jogColor WRITE setJogColor NOTIFY jogColorChanged)
+    Q_PROPERTY(QColor traverseColor READ traverseColor WRITE setTraverseColor NOTIFY traverseColorChanged)
+    Q_PROPERTY(QColor feedColor READ feedColor WRITE setFeedColor NOTIFY feedColorChanged)
+    Q_PROPERTY(QColor arcColor READ arcColor WRITE setArcColor NOTIFY arcColorChanged)
+    Q_PROPERTY(QColor toolChangeColor READ toolChangeColor WRITE setToolChangeColor NOTIFY toolChangeColorChanged)
+    Q_PROPERTY(QColor probingColor READ probingColor WRITE setProbingColor NOTIFY probingColorChanged)
+
+public:
+    explicit GLBackplotItem(QQuickItem *parent = 0);
+
+    virtual void paint(GLView *glView);
+
+    QVector3D toolPosition() const
+    {
+        return m_toolPosition;
+    }
+
+    int motionType() const
+    {
+        return m_motionType;
+    }
+
+    int capacity() const
+    {
+        return m_capacity;
+    }
+
+    float lineWidth() const
+    {
+        return m_lineWidth;
+    }
+
+    QColor jogColor() const
+    {
+        return m_jogColor;
+    }
+
+    QColor traverseColor() const
+    {
+        return m_traverseColor;
+    }
+
+    QColor feedColor() const
+    {
+        return m_feedColor;
+    }
+
+    QColor arcColor() const
+    {
+        return m_arcColor;
+    }
+
+    QColor toolChangeColor() const
+    {
+        return m_toolChangeColor;
+    }
+
+    QColor probingColor() const
+    {
+        return m_probingColor;
+    }
+
+signals:
+    void toolPositionChanged(QVector3D arg);
+    void motionTypeChanged(int arg);
+    void capacityChanged(int arg);
+    void lineWidthChanged(float arg);
+    void jogColorChanged(QColor arg);
+    void traverseColorChanged(QColor arg);
+    void feedColorChanged(QColor arg);
+    void arcColorChanged(QColor arg);
+    void toolChangeColorChanged(QColor arg);
+    void probingColorChanged(QColor arg);
+
+public slots:
+    virtual void selectDrawable(void *pointer);
+
+    void clear();
+    void setToolPosition(QVector3D arg);
+    void setMotionType(int arg);
+
+    void setCapacity(int arg)
+    {
+        arg = qMax(2, arg);
+        if (m_capacity != arg) {
+            m_capacity = arg;
+            emit capacityChanged(arg);
+        }
+    }
+
+    void setLineWidth(float arg)
+    {
+        if (m_lineWidth != arg) {
+            m_lineWidth = arg;
+            emit lineWidthChanged(arg);
+        }
+    }
+
+    void setJogColor(QColor arg)
+    {
+        if (m_jogColor != arg) {
+            m_jogColor = arg;
+            emit jogColorChanged(arg);
+        }
+    }
+
+    void setTraverseColor(QColor arg)
+    {
+        if (m_traverseColor != arg) {
+            m_traverseColor = arg;
+            emit traverseColorChanged(arg);
+        }
+    }
+
+    void setFeedColor(QColor arg)
+    {
+        if (m_feedColor != arg) {
+            m_feedColor = arg;
+            emit feedColorChanged(arg);
+        }
+    }
+
+    void setArcColor(QColor arg)
+    {
+        if (m_arcColor != arg) {
+            m_arcColor = arg;
+            emit arcColorChanged(arg);
+        }
+    }
+
+    void setToolChangeColor(QColor arg)
+    {
+        if (m_toolChangeColor != arg) {
+            m_toolChangeColor = arg;
+            emit toolChangeColorChanged(arg);
+        }
+    }
+
+    void setProbingColor(QColor arg)
+    {
+        if (m_probingColor != arg) {
+            m_probingColor = arg;
+            emit probingColorChanged(arg);
+        }
+    }
+
+private:
+    // values of ApplicationStatus::MotionType
+    enum MotionType {
+        NoneMotion = 0,
+        TraverseMotion = 1,
+        FeedMotion = 2,
+        ArcMotion = 3,
+        ToolchangeMotion = 4,
+        ProbingMotion = 5,
+        IndexRotaryMotion = 6
+    };
+
+    typedef struct {
+        QVector3D position;
+        int state;
+    } Sample;
+
+    QVector3D m_toolPosition;
+    int m_motionType;
+    int m_capacity;
+    float m_lineWidth;
+    QColor m_jogColor;
+    QColor m_traverseColor;
+    QColor m_feedColor;
+    QColor m_arcColor;
+    QColor m_toolChangeColor;
+    QColor m_probingColor;
+    QList<Sample> m_pendingSamples;     // appended to the trail on the next synchronization
+    bool m_clearPending;
+    bool m_hasLastSample;
+    Sample m_lastSample;
+
+    void appendSample();
+    int lineState() const;
+    QList<QColor> linePalette() const;
+}; // class GLBackplotItem
+} // namespace qtquickvcp
+
+#endif // GLBACKPLOTITEM_H
@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#include "glboundingboxitem.h"
+
+namespace qtquickvcp {
+
+GLBoundingBoxItem::GLBoundingBoxItem(QQuickItem *parent) :
+    GLItem(parent),
+    m_axes(3),
+    m_minimum(QVector3D(0.0, 0.0, 0.0)),
+    m_maximum(QVector3D(10.0, 10.0, 10.0)),
+    m_size(QVector3D(10.0, 10.0, 10.0)),
+    m_center(QVector3D(5.0, 5.0, 5.0)),
+    m_color(QColor(Qt::red)),
+    m_lineWidth(1.0),
+    m_lineStipple(true),
+    m_lineStippleLength(1.0)
+{
+    connect(this, &GLBoundingBoxItem::axesChanged,
+            this, &GLBoundingBoxItem::needsUpdate);
+    connect(this, &GLBoundingBoxItem::minimumChanged,
+            this, &GLBoundingBoxItem::needsUpdate);
+    connect(this, &GLBoundingBoxItem::maximumChanged,
+            this, &GLBoundingBoxItem::needsUpdate);
+    connect(this, &GLBoundingBoxItem::colorChanged,
+            this, &GLBoundingBoxItem::needsUpdate);
+    connect(this, &GLBoundingBoxItem::lineWidthChanged,
+            this, &GLBoundingBoxItem::needsUpdate);
+    connect(this, &GLBoundingBoxItem::lineStippleChanged,
+            this, &GLBoundingBoxItem::needsUpdate);
+    connect(this, &GLBoundingBoxItem::lineStippleLengthChanged,
+            this, &GLBoundingBoxItem::needsUpdate);
+}
+
+void GLBoundingBoxItem::paint(GLView *glView)
+{
+    const QVector3D size = m_maximum - m_minimum;
+
+    glView->prepare(this);
+    glView->reset();
+    glView->lineStipple(m_lineStipple, m_lineStippleLength);
+    glView->lineWidth(m_lineWidth);
+    glView->color(m_color);
+    glView->translate(m_minimum);
+    glView->beginUnion();
+    glView->lineTo(size.x(), 0.0, 0.0);
+    glView->lineTo(size.x(), size.y(), 0.0);
+    glView->lineTo(0.0, size.y(), 0.0);
+    glView->lineTo(0.0, 0.0, 0.0);
+    if (m_axes > 2)
+    {
+        glView->lineTo(0.0, 0.0, size.z());
+        glView->lineTo(size.x(), 0.0, size.z());
+        glView->lineTo(size.x(), size.y(), size.z());
+        glView->lineTo(0.0, size.y(), size.z());
+        glView->lineTo(0.0, 0.0, size.z());
+        glView->resetTransformations();
+        glView->lineFromTo(0.0, size.y(), 0.0,
+                           0.0, size.y(), size.z());
+        glView->lineFromTo(size.x(), size.y(), 0.0,
+                           size.x(), size.y(), size.z());
+        glView->lineFromTo(size.x(), 0.0, 0.0,
+                           size.x(), 0.0, size.z());
+    }
+    glView->endUnion();
+}
+
+void GLBoundingBoxItem::selectDrawable(void *pointer)
+{
+    Q_UNUSED(pointer)
+}
+
+void GLBoundingBoxItem::setMinimum(QVector3D arg)
+{
+    if (m_minimum != arg) {
+        m_minimum = arg;
+        emit minimumChanged(arg);
+        updateSize();
+    }
+}
+
+void GLBoundingBoxItem::setMaximum(QVector3D arg)
+{
+    if (m_maximum != arg) {
+        m_maximum = arg;
+        emit maximumChanged(arg);
+        updateSize();
+    }
+}
+
+void GLBoundingBoxItem::updateSize()
+{
+    const QVector3D size = m_maximum - m_minimum;
+    const QVector3D center = (m_minimum + m_maximum) * 0.5;
+
+    if (m_size != size) {
+        m_size = size;
+        emit sizeChanged(size);
+    }
+
+    if (m_center != center) {
+        m_center = center;
+        emit centerChanged(center);
+    }
+}
+}; // namespace qtquickvcp
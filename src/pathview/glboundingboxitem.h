@@ -0,0 +1,165 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#ifndef GLBOUNDINGBOXITEM_H
+#define GLBOUNDINGBOXITEM_H
+
+#include "glitem.h"
+
+namespace qtquickvcp {
+
+class GLBoundingBoxItem : public GLItem
+{
+    Q_OBJECT
+    Q_PROPERTY(int axes READ axes WRITE setAxes NOTIFY axesChanged)
+    Q_PROPERTY(QVector3D minimum READ minimum WRITE setMinimum NOTIFY minimumChanged)
+    Q_PROPERTY(QVector3D maximum READ maximum WRITE setMaximum NOTIFY maximumChanged)
+    Q_PROPERTY(QVector3D size READ size NOTIFY sizeChanged)
+    Q_PROPERTY(QVector3D center READ center NOTIFY centerChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(float lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(bool lineStipple READ lineStipple WRITE setLineStipple NOTIFY lineStippleChanged)
+    Q_PROPERTY(float lineStippleLength READ lineStippleLength WRITE setLineStippleLength NOTIFY lineStippleLengthChanged)
+
+public:
+    explicit GLBoundingBoxItem(QQuickItem *parent = 0);
+
+    virtual void paint(GLView *glView);
+
+    int axes() const
+    {
+        return m_axes;
+    }
+
+    QVector3D minimum() const
+    {
+        return m_minimum;
+    }
+
+    QVector3D maximum() const
+    {
+        return m_maximum;
+    }
+
+    QVector3D size() const
+    {
+        return m_size;
+    }
+
+    QVector3D center() const
+    {
+        return m_center;
+    }
+
+    QColor color() const
+    {
+        return m_color;
+    }
+
+    float lineWidth() const
+    {
+        return m_lineWidth;
+    }
+
+    bool lineStipple() const
+    {
+        return m_lineStipple;
+    }
+
+    float lineStippleLength() const
+    {
+        return m_lineStippleLength;
+    }
+
+signals:
+    void axesChanged(int arg);
+    void minimumChanged(QVector3D arg);
+    void maximumChanged(QVector3D arg);
+    void sizeChanged(QVector3D arg);
+    void centerChanged(QVector3D arg);
+    void colorChanged(QColor arg);
+    void lineWidthChanged(float arg);
+    void lineStippleChanged(bool arg);
+    void lineStippleLengthChanged(float arg);
+
+public slots:
+    virtual void selectDrawable(void *pointer);
+
+    void setMinimum(QVector3D arg);
+    void setMaximum(QVector3D arg);
+
+    void setAxes(int arg)
+    {
+        if (m_axes != arg) {
+            m_axes = arg;
+            emit axesChanged(arg);
+        }
+    }
+
+    void setColor(QColor arg)
+    {
+        if (m_color != arg) {
+            m_color = arg;
+            emit colorChanged(arg);
+        }
+    }
+
+    void setLineWidth(float arg)
+    {
+        if (m_lineWidth != arg) {
+            m_lineWidth = arg;
+            emit lineWidthChanged(arg);
+        }
+    }
+
+    void setLineStipple(bool arg)
+    {
+        if (m_lineStipple != arg) {
+            m_lineStipple = arg;
+            emit lineStippleChanged(arg);
+        }
+    }
+
+    void setLineStippleLength(float arg)
+    {
+        if (m_lineStippleLength != arg) {
+            m_lineStippleLength = arg;
+            emit lineStippleLengthChanged(arg);
+        }
+    }
+
+private:
+    int m_axes;
+    QVector3D m_minimum;
+    QVector3D m_maximum;
+    QVector3D m_size;
+    QVector3D m_center;
+    QColor m_color;
+    float m_lineWidth;
+    bool m_lineStipple;
+    float m_lineStippleLength;
+
+    void updateSize();
+}; // class GLBoundingBoxItem
+} // namespace qtquickvcp
+
+#endif // GLBOUNDINGBOXITEM_H
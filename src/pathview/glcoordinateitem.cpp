@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#include "glcoordinateitem.h"
+
+namespace qtquickvcp {
+
+GLCoordinateItem::GLCoordinateItem(QQuickItem *parent) :
+    GLItem(parent),
+    m_axes(3),
+    m_axesLength(5.0),
+    m_textSize(1.0),
+    m_lineWidth(1.0),
+    m_xAxisColor(QColor(Qt::red)),
+    m_yAxisColor(QColor(Qt::green)),
+    m_zAxisColor(QColor(Qt::blue)),
+    m_xAxisRotation(0.0),
+    m_yAxisRotation(0.0),
+    m_zAxisRotation(0.0)
+{
+    connect(this, &GLCoordinateItem::axesChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::axesLengthChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::textSizeChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::lineWidthChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::xAxisColorChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::yAxisColorChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::zAxisColorChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::xAxisRotationChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::yAxisRotationChanged,
+            this, &GLCoordinateItem::needsUpdate);
+    connect(this, &GLCoordinateItem::zAxisRotationChanged,
+            this, &GLCoordinateItem::needsUpdate);
+}
+
+void GLCoordinateItem::paint(GLView *glView)
+{
+    glView->prepare(this);
+    glView->reset();
+    glView->lineWidth(m_lineWidth);
+    glView->beginUnion();
+
+    glView->color(m_xAxisColor);
+    glView->rotate(m_xAxisRotation, 1.0, 0.0, 0.0);
+    glView->beginUnion();
+    glView->line(m_axesLength, 0.0, 0.0);
+    glView->translate(m_axesLength, -m_textSize / 2.0, 0.0);
+    glView->scale(m_textSize, m_textSize, m_textSize);
+    glView->text(QStringLiteral("X"));
+    glView->endUnion();
+
+    if (m_axes > 1)
+    {
+        glView->color(m_yAxisColor);
+        glView->rotate(m_yAxisRotation, 0.0, 1.0, 0.0);
+        glView->beginUnion();
+        glView->line(0.0, m_axesLength, 0.0);
+        glView->translate(m_textSize / 2.0, m_axesLength, 0.0);
+        glView->rotate(90.0, 0.0, 0.0, 1.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->text(QStringLiteral("Y"));
+        glView->endUnion();
+    }
+
+    if (m_axes > 2)
+    {
+        glView->color(m_zAxisColor);
+        glView->rotate(m_zAxisRotation, 0.0, 0.0, 1.0);
+        glView->beginUnion();
+        glView->line(0.0, 0.0, m_axesLength);
+        glView->translate(0.0, 0.0, m_axesLength);
+        glView->rotate(90.0, 1.0, 0.0, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->text(QStringLiteral("Z"), GLView::AlignCenter);
+        glView->endUnion();
+    }
+
+    glView->endUnion();
+}
+
+void GLCoordinateItem::selectDrawable(void *pointer)
+{
+    Q_UNUSED(pointer)
+}
+}; // namespace qtquickvcp
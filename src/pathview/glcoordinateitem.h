@@ -0,0 +1,208 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#ifndef GLCOORDINATEITEM_H
+#define GLCOORDINATEITEM_H
+
+#include "glitem.h"
+
+namespace qtquickvcp {
+
+class GLCoordinateItem : public GLItem
+{
+    Q_OBJECT
+    Q_PROPERTY(int axes READ axes WRITE setAxes NOTIFY axesChanged)
+    Q_PROPERTY(float axesLength READ axesLength WRITE setAxesLength NOTIFY axesLengthChanged)
+    Q_PROPERTY(float textSize READ textSize WRITE setTextSize NOTIFY textSizeChanged)
+    Q_PROPERTY(float lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(QColor xAxisColor READ xAxisColor WRITE setXAxisColor NOTIFY xAxisColorChanged)
+    Q_PROPERTY(QColor yAxisColor READ yAxisColor WRITE setYAxisColor NOTIFY yAxisColorChanged)
+    Q_PROPERTY(QColor zAxisColor READ zAxisColor WRITE setZAxisColor NOTIFY zAxisColorChanged)
+    Q_PROPERTY(float xAxisRotation READ xAxisRotation WRITE setXAxisRotation NOTIFY xAxisRotationChanged)
+    Q_PROPERTY(float yAxisRotation READ yAxisRotation WRITE setYAxisRotation NOTIFY yAxisRotationChanged)
+    Q_PROPERTY(float zAxisRotation READ zAxisRotation WRITE setZAxisRotation NOTIFY zAxisRotationChanged)
+
+public:
+    explicit GLCoordinateItem(QQuickItem *parent = 0);
+
+    virtual void paint(GLView *glView);
+
+    int axes() const
+    {
+        return m_axes;
+    }
+
+    float axesLength() const
+    {
+        return m_axesLength;
+    }
+
+    float textSize() const
+    {
+        return m_textSize;
+    }
+
+    float lineWidth() const
+    {
+        return m_lineWidth;
+    }
+
+    QColor xAxisColor() const
+    {
+        return m_xAxisColor;
+    }
+
+    QColor yAxisColor() const
+    {
+        return m_yAxisColor;
+    }
+
+    QColor zAxisColor() const
+    {
+        return m_zAxisColor;
+    }
+
+    float xAxisRotation() const
+    {
+        return m_xAxisRotation;
+    }
+
+    float yAxisRotation() const
+    {
+        return m_yAxisRotation;
+    }
+
+    float zAxisRotation() const
+    {
+        return m_zAxisRotation;
+    }
+
+signals:
+    void axesChanged(int arg);
+    void axesLengthChanged(float arg);
+    void textSizeChanged(float arg);
+    void lineWidthChanged(float arg);
+    void xAxisColorChanged(QColor arg);
+    void yAxisColorChanged(QColor arg);
+    void zAxisColorChanged(QColor arg);
+    void xAxisRotationChanged(float arg);
+    void yAxisRotationChanged(float arg);
+    void zAxisRotationChanged(float arg);
+
+public slots:
+    virtual void selectDrawable(void *pointer);
+
+    void setAxes(int arg)
+    {
+        if (m_axes != arg) {
+            m_axes = arg;
+            emit axesChanged(arg);
+        }
+    }
+
+    void setAxesLength(float arg)
+    {
+        if (m_axesLength != arg) {
+            m_axesLength = arg;
+            emit axesLengthChanged(arg);
+        }
+    }
+
+    void setTextSize(float arg)
+    {
+        if (m_textSize != arg) {
+            m_textSize = arg;
+            emit textSizeChanged(arg);
+        }
+    }
+
+    void setLineWidth(float arg)
+    {
+        if (m_lineWidth != arg) {
+            m_lineWidth = arg;
+            emit lineWidthChanged(arg);
+        }
+    }
+
+    void setXAxisColor(QColor arg)
+    {
+        if (m_xAxisColor != arg) {
+            m_xAxisColor = arg;
+            emit xAxisColorChanged(arg);
+        }
+    }
+
+    void setYAxisColor(QColor arg)
+    {
+        if (m_yAxisColor != arg) {
+            m_yAxisColor = arg;
+            emit yAxisColorChanged(arg);
+        }
+    }
+
+    void setZAxisColor(QColor arg)
+    {
+        if (m_zAxisColor != arg) {
+            m_zAxisColor = arg;
+            emit zAxisColorChanged(arg);
+        }
+    }
+
+    void setXAxisRotation(float arg)
+    {
+        if (m_xAxisRotation != arg) {
+            m_xAxisRotation = arg;
+            emit xAxisRotationChanged(arg);
+        }
+    }
+
+    void setYAxisRotation(float arg)
+    {
+        if (m_yAxisRotation != arg) {
+            m_yAxisRotation = arg;
+            emit yAxisRotationChanged(arg);
+        }
+    }
+
+    void setZAxisRotation(float arg)
+    {
+        if (m_zAxisRotation != arg) {
+            m_zAxisRotation = arg;
+            emit zAxisRotationChanged(arg);
+        }
+    }
+
+private:
+    int m_axes;
+    float m_axesLength;
+    float m_textSize;
+    float m_lineWidth;
+    QColor m_xAxisColor;
+    QColor m_yAxisColor;
+    QColor m_zAxisColor;
+    float m_xAxisRotation;
+    float m_yAxisRotation;
+    float m_zAxisRotation;
+}; // class GLCoordinateItem
+} // namespace qtquickvcp
+
+#endif // GLCOORDINATEITEM_H
@@ -0,0 +1,325 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "glglyphatlas.h"
+#include <QTextLayout>
+#include <QGlyphRun>
+#include <QtCore/qmath.h>
+#include <cmath>
+#include <limits>
+
+namespace qtquickvcp {
+
+static const int AtlasSize = 1024;
+static const int GlyphPixelSize = 48;   // size the glyphs are rendered with, the distance field scales from there
+static const int Spread = 6;            // pixels of distance stored around the glyph outlines
+static const float Unreachable = 1e20f;
+
+/** Packs signed distance fields of glyphs into a single image
+ *
+ *  Every glyph is stored once per font, so all texts of a view can be drawn
+ *  with one texture. The distance fields stay sharp when scaled up, the
+ *  outline is where the stored value crosses 0.5. Glyphs are packed on
+ *  shelves, the atlas must be cleared when it is full.
+ **/
+GLGlyphAtlas::GLGlyphAtlas() :
+    m_image(AtlasSize, AtlasSize, QImage::Format_Alpha8),
+    m_shelfX(0),
+    m_shelfY(0),
+    m_shelfHeight(0),
+    m_revision(0)
+{
+    m_image.fill(0);
+}
+
+/** Lays out the text as glyph quads and adds missing glyphs to the atlas
+ *
+ *  Returns false if the atlas is full, the glyphs that do not fit are left out.
+ **/
+bool GLGlyphAtlas::layoutText(const QString &text, const QFont &font, QVector<GlyphQuad> *quads, float *width)
+{
+    QFont layoutFont(font);
+    QTextLayout layout;
+    bool complete = true;
+
+    quads->clear();
+    *width = 0.0f;
+
+    layoutFont.setPixelSize(GlyphPixelSize);
+    layout.setFont(layoutFont);
+    layout.setText(text);
+    layout.beginLayout();
+    QTextLine line = layout.createLine();
+    layout.endLayout();
+
+    if (!line.isValid())
+    {
+        return true;
+    }
+
+    const float lineHeight = qMax(1.0f, static_cast<float>(line.height()));
+    *width = static_cast<float>(line.naturalTextWidth()) / lineHeight;
+
+    const QList<QGlyphRun> glyphRuns = layout.glyphRuns();
+    for (const QGlyphRun &glyphRun: glyphRuns)
+    {
+        const QRawFont rawFont = glyphRun.rawFont();
+        const QString fontKey = QString("%1/%2/%3/%4").arg(rawFont.familyName()).arg(rawFont.styleName())
+                                                      .arg(rawFont.weight()).arg(static_cast<int>(rawFont.style()));
+        const QVector<quint32> glyphIndexes = glyphRun.glyphIndexes();
+        const QVector<QPointF> positions = glyphRun.positions();
+
+        for (int i = 0; i < glyphIndexes.size(); ++i)
+        {
+            Glyph entry;
+
+            if (!glyph(rawFont, fontKey, glyphIndexes.at(i), &entry))
+            {
+                complete = false;
+                continue;
+            }
+
+            if (entry.atlasRect.isEmpty())
+            {
+                continue;   // white space
+            }
+
+            // positions are on the baseline, relative to the top of the line
+            const QPointF &position = positions.at(i);
+            GlyphQuad quad;
+            quad.minimum = QVector2D(static_cast<float>(position.x() + entry.bounds.left()) / lineHeight,
+                                     1.0f - static_cast<float>(position.y() + entry.bounds.bottom()) / lineHeight);
+            quad.maximum = QVector2D(static_cast<float>(position.x() + entry.bounds.right()) / lineHeight,
+                                     1.0f - static_cast<float>(position.y() + entry.bounds.top()) / lineHeight);
+            quad.textureMinimum = QVector2D(static_cast<float>(entry.atlasRect.left()) / AtlasSize,
+                                            static_cast<float>(entry.atlasRect.top() + entry.atlasRect.height()) / AtlasSize);
+            quad.textureMaximum = QVector2D(static_cast<float>(entry.atlasRect.left() + entry.atlasRect.width()) / AtlasSize,
+                                            static_cast<float>(entry.atlasRect.top()) / AtlasSize);
+            quads->append(quad);
+        }
+    }
+
+    return complete;
+}
+
+/** Removes all glyphs, the texts must be laid out again */
+void GLGlyphAtlas::clear()
+{
+    m_glyphs.clear();
+    m_image.fill(0);
+    m_shelfX = 0;
+    m_shelfY = 0;
+    m_shelfHeight = 0;
+    m_revision++;
+}
+
+bool GLGlyphAtlas::glyph(const QRawFont &rawFont, const QString &fontKey, quint32 glyphIndex, Glyph *glyph)
+{
+    const QPair<QString, quint32> key(fontKey, glyphIndex);
+    QHash<QPair<QString, quint32>, Glyph>::const_iterator it = m_glyphs.constFind(key);
+
+    if (it != m_glyphs.constEnd())
+    {
+        *glyph = it.value();
+        return true;
+    }
+
+    if (!addGlyph(rawFont, glyphIndex, glyph))
+    {
+        return false;
+    }
+
+    m_glyphs.insert(key, *glyph);
+    return true;
+}
+
+/** Renders the glyph and stores its distance field in the atlas */
+bool GLGlyphAtlas::addGlyph(const QRawFont &rawFont, quint32 glyphIndex, Glyph *glyph)
+{
+    const QImage alphaMap = rawFont.alphaMapForGlyph(glyphIndex, QRawFont::PixelAntialiasing);
+
+    glyph->atlasRect = QRect();
+    glyph->bounds = QRectF();
+
+    if (alphaMap.isNull() || (alphaMap.width() == 0) || (alphaMap.height() == 0))
+    {
+        return true;
+    }
+
+    const int width = alphaMap.width() + 2 * Spread;
+    const int height = alphaMap.height() + 2 * Spread;
+    QRect rect;
+
+    if (!allocate(width, height, &rect))
+    {
+        return false;
+    }
+
+    const QVector<float> values = coverage(alphaMap, Spread);
+    const QVector<float> glyphDistances = distanceField(values, width, height, true);
+    const QVector<float> backgroundDistances = distanceField(values, width, height, false);
+
+    for (int y = 0; y < height; ++y)
+    {
+        uchar *line = m_image.scanLine(rect.top() + y) + rect.left();
+        for (int x = 0; x < width; ++x)
+        {
+            const int index = y * width + x;
+            // the outline is half a pixel from the centers of the pixels at its sides
+            const float distance = (values.at(index) >= 0.5f) ? (backgroundDistances.at(index) - 0.5f)
+                                                               : (0.5f - glyphDistances.at(index));
+            const float value = 127.5f + distance * 127.5f / static_cast<float>(Spread);
+            line[x] = static_cast<uchar>(qBound(0, qRound(value), 255));
+        }
+    }
+
+    // the alpha map starts at the top left corner of the glyph bounding rect rounded down
+    const QRectF boundingRect = rawFont.boundingRect(glyphIndex);
+    glyph->bounds = QRectF(qFloor(boundingRect.left()) - Spread, qFloor(boundingRect.top()) - Spread, width, height);
+    glyph->atlasRect = rect;
+    m_revision++;
+
+    return true;
+}
+
+/** Reserves space on the current shelf or opens a new shelf below it */
+bool GLGlyphAtlas::allocate(int width, int height, QRect *rect)
+{
+    if ((m_shelfX + width) > AtlasSize)
+    {
+        m_shelfX = 0;
+        m_shelfY += m_shelfHeight;
+        m_shelfHeight = 0;
+    }
+
+    if ((width > AtlasSize) || ((m_shelfY + height) > AtlasSize))
+    {
+        return false;
+    }
+
+    *rect = QRect(m_shelfX, m_shelfY, width, height);
+    m_shelfX += width;
+    m_shelfHeight = qMax(m_shelfHeight, height);
+
+    return true;
+}
+
+/** Returns the coverage of the alpha map in the range 0 to 1 with a border of padding pixels */
+QVector<float> GLGlyphAtlas::coverage(const QImage &alphaMap, int padding)
+{
+    const QImage image = (alphaMap.format() == QImage::Format_Indexed8) ? alphaMap : alphaMap.convertToFormat(QImage::Format_Alpha8);
+    const int width = image.width() + 2 * padding;
+    const int height = image.height() + 2 * padding;
+    QVector<float> values(width * height, 0.0f);
+
+    // the index of the gray alpha map color table is the coverage
+    for (int y = 0; y < image.height(); ++y)
+    {
+        const uchar *line = image.constScanLine(y);
+        float *row = values.data() + (y + padding) * width + padding;
+        for (int x = 0; x < image.width(); ++x)
+        {
+            row[x] = static_cast<float>(line[x]) / 255.0f;
+        }
+    }
+
+    return values;
+}
+
+/** Returns the euclidean distance of every pixel to the nearest pixel inside or outside the glyph */
+QVector<float> GLGlyphAtlas::distanceField(const QVector<float> &coverage, int width, int height, bool inside)
+{
+    const int size = qMax(width, height);
+    QVector<float> distances(width * height);
+    QVector<float> buffer(size);
+    QVector<int> vertices(size);
+    QVector<float> ranges(size + 1);
+
+    for (int i = 0; i < distances.size(); ++i)
+    {
+        distances[i] = ((coverage.at(i) >= 0.5f) == inside) ? 0.0f : Unreachable;
+    }
+
+    for (int x = 0; x < width; ++x)
+    {
+        distanceTransform(distances.data() + x, height, width, buffer.data(), vertices.data(), ranges.data());
+    }
+    for (int y = 0; y < height; ++y)
+    {
+        distanceTransform(distances.data() + y * width, width, 1, buffer.data(), vertices.data(), ranges.data());
+    }
+
+    for (int i = 0; i < distances.size(); ++i)
+    {
+        distances[i] = std::sqrt(distances.at(i));
+    }
+
+    return distances;
+}
+
+/** One dimensional squared distance transform of sampled functions (Felzenszwalb and Huttenlocher)
+ *
+ *  Computes the lower envelope of the parabolas rooted at the values in place.
+ **/
+void GLGlyphAtlas::distanceTransform(float *values, int count, int stride, float *buffer, int *vertices, float *ranges)
+{
+    int k = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        buffer[i] = values[i * stride];
+    }
+
+    vertices[0] = 0;
+    ranges[0] = -std::numeric_limits<float>::infinity();
+    ranges[1] = std::numeric_limits<float>::infinity();
+
+    for (int q = 1; q < count; ++q)
+    {
+        float s;
+        forever
+        {
+            const int v = vertices[k];
+            s = ((buffer[q] + static_cast<float>(q * q)) - (buffer[v] + static_cast<float>(v * v))) / static_cast<float>(2 * q - 2 * v);
+            if ((s > ranges[k]) || (k == 0))
+            {
+                break;
+            }
+            k--;
+        }
+        k++;
+        vertices[k] = q;
+        ranges[k] = s;
+        ranges[k + 1] = std::numeric_limits<float>::infinity();
+    }
+
+    k = 0;
+    for (int q = 0; q < count; ++q)
+    {
+        while (ranges[k + 1] < static_cast<float>(q))
+        {
+            k++;
+        }
+        const int v = vertices[k];
+        values[q * stride] = static_cast<float>((q - v) * (q - v)) + buffer[v];
+    }
+}
+}; // namespace qtquickvcp
@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef GLGLYPHATLAS_H
+#define GLGLYPHATLAS_H
+
+#include <QVector>
+#include <QVector2D>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QFont>
+#include <QRawFont>
+#include <QImage>
+#include <QRect>
+#include <QRectF>
+
+namespace qtquickvcp {
+
+class GLGlyphAtlas
+{
+public:
+    // quad of a glyph in text units, the line is one unit high with its top at y = 1
+    typedef struct {
+        QVector2D minimum;
+        QVector2D maximum;
+        QVector2D textureMinimum;   // normalized atlas coordinates of the bottom left corner
+        QVector2D textureMaximum;
+    } GlyphQuad;
+
+    GLGlyphAtlas();
+
+    bool layoutText(const QString &text, const QFont &font, QVector<GlyphQuad> *quads, float *width);
+    void clear();
+
+    const QImage &image() const
+    {
+        return m_image;
+    }
+
+    int revision() const
+    {
+        return m_revision;
+    }
+
+private:
+    typedef struct {
+        QRect atlasRect;    // position inside the atlas image, empty for glyphs without outline
+        QRectF bounds;      // relative to the pen position in pixels, y down
+    } Glyph;
+
+    QImage m_image;
+    QHash<QPair<QString, quint32>, Glyph> m_glyphs;     // glyphs by font key and glyph index
+    int m_shelfX;       // packing position on the current shelf
+    int m_shelfY;
+    int m_shelfHeight;
+    int m_revision;     // incremented when the image changes
+
+    bool glyph(const QRawFont &rawFont, const QString &fontKey, quint32 glyphIndex, Glyph *glyph);
+    bool addGlyph(const QRawFont &rawFont, quint32 glyphIndex, Glyph *glyph);
+    bool allocate(int width, int height, QRect *rect);
+    static QVector<float> coverage(const QImage &alphaMap, int padding);
+    static QVector<float> distanceField(const QVector<float> &coverage, int width, int height, bool inside);
+    static void distanceTransform(float *values, int count, int stride, float *buffer, int *vertices, float *ranges);
+}; // class GLGlyphAtlas
+} // namespace qtquickvcp
+
+#endif // GLGLYPHATLAS_H
@@ -0,0 +1,237 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#include "glgriditem.h"
+#include <cmath>
+
+namespace qtquickvcp {
+
+/** Grid of major and minor lines inside a plane of the box from minimum to maximum
+ *
+ *  Axis 1 and axis 2 are the first and the second axis of the plane, e.g. X and Z
+ *  for the XZ plane. The lines are only generated again when a property changes.
+ **/
+GLGridItem::GLGridItem(QQuickItem *parent) :
+    GLItem(parent),
+    m_minimum(QVector3D(0.0, 0.0, 0.0)),
+    m_maximum(QVector3D(10.0, 10.0, 10.0)),
+    m_lineWidthAxis1(2.0),
+    m_lineWidthAxis1Min(0.5),
+    m_lineWidthAxis2(2.0),
+    m_lineWidthAxis2Min(0.5),
+    m_colorAxis1(QColor("#333")),
+    m_colorAxis2(QColor("#333")),
+    m_colorAxis1Min(QColor("#111")),
+    m_colorAxis2Min(QColor("#111")),
+    m_intervalAxis1(1.0),
+    m_intervalAxis1Min(0.2),
+    m_intervalAxis2(1.0),
+    m_intervalAxis2Min(0.2),
+    m_enableAxis1(true),
+    m_enableAxis2(true),
+    m_enableAxis1Min(true),
+    m_enableAxis2Min(true),
+    m_alignToOrigin(true),
+    m_plane(QString("XY")),
+    m_colorAxis2Set(false),
+    m_colorAxis2MinSet(false)
+{
+    connect(this, &GLGridItem::minimumChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::maximumChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::lineWidthAxis1Changed,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::lineWidthAxis1MinChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::lineWidthAxis2Changed,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::lineWidthAxis2MinChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::colorAxis1Changed,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::colorAxis2Changed,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::colorAxis1MinChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::colorAxis2MinChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::intervalAxis1Changed,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::intervalAxis1MinChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::intervalAxis2Changed,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::intervalAxis2MinChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::enableAxis1Changed,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::enableAxis2Changed,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::enableAxis1MinChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::enableAxis2MinChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::alignToOriginChanged,
+            this, &GLGridItem::needsUpdate);
+    connect(this, &GLGridItem::planeChanged,
+            this, &GLGridItem::needsUpdate);
+}
+
+void GLGridItem::paint(GLView *glView)
+{
+    const QVector3D size = m_maximum - m_minimum;
+    const GridLines disabledLines = { false, 0.0, QColor(), 0.0 };
+    const GridLines axis1Lines = { m_enableAxis1, m_intervalAxis1, m_colorAxis1, m_lineWidthAxis1 };
+    const GridLines axis1MinLines = { m_enableAxis1Min, m_intervalAxis1Min, m_colorAxis1Min, m_lineWidthAxis1Min };
+    const GridLines axis2Lines = { m_enableAxis2, m_intervalAxis2, m_colorAxis2, m_lineWidthAxis2 };
+    const GridLines axis2MinLines = { m_enableAxis2Min, m_intervalAxis2Min, m_colorAxis2Min, m_lineWidthAxis2Min };
+    GridLines lines[3] = { disabledLines, disabledLines, disabledLines };      // lines at positions of x, y and z
+    GridLines minLines[3] = { disabledLines, disabledLines, disabledLines };
+    QVector3D spans[3];     // end points of the lines at position 0
+
+    if (m_plane == QLatin1String("XY"))
+    {
+        lines[0] = axis1Lines;
+        minLines[0] = axis1MinLines;
+        lines[1] = axis2Lines;
+        minLines[1] = axis2MinLines;
+        spans[0] = QVector3D(0.0, size.y(), 0.0);
+        spans[1] = QVector3D(size.x(), 0.0, 0.0);
+    }
+    else if (m_plane == QLatin1String("XZ"))
+    {
+        lines[0] = axis1Lines;
+        minLines[0] = axis1MinLines;
+        lines[2] = axis2Lines;
+        minLines[2] = axis2MinLines;
+        spans[0] = QVector3D(0.0, 0.0, size.z());
+        spans[2] = QVector3D(size.x(), 0.0, 0.0);
+    }
+    else if (m_plane == QLatin1String("YZ"))
+    {
+        lines[1] = axis1Lines;
+        minLines[1] = axis1MinLines;
+        lines[2] = axis2Lines;
+        minLines[2] = axis2MinLines;
+        spans[1] = QVector3D(0.0, 0.0, size.z());
+        spans[2] = QVector3D(0.0, size.y(), 0.0);
+    }
+
+    glView->prepare(this);
+    glView->reset();
+    glView->translate(m_minimum);
+    glView->beginUnion();
+
+    // minor lines first, the major lines are drawn on top
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        paintLines(glView, axis, minLines[axis], spans[axis], size[axis]);
+    }
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        paintLines(glView, axis, lines[axis], spans[axis], size[axis]);
+    }
+
+    glView->endUnion();
+}
+
+void GLGridItem::selectDrawable(void *pointer)
+{
+    Q_UNUSED(pointer)
+}
+
+void GLGridItem::setColorAxis1(QColor arg)
+{
+    if (m_colorAxis1 != arg) {
+        m_colorAxis1 = arg;
+        emit colorAxis1Changed(arg);
+    }
+
+    if (!m_colorAxis2Set && (m_colorAxis2 != arg)) {
+        m_colorAxis2 = arg;
+        emit colorAxis2Changed(arg);
+    }
+}
+
+void GLGridItem::setColorAxis2(QColor arg)
+{
+    m_colorAxis2Set = true;
+
+    if (m_colorAxis2 != arg) {
+        m_colorAxis2 = arg;
+        emit colorAxis2Changed(arg);
+    }
+}
+
+void GLGridItem::setColorAxis1Min(QColor arg)
+{
+    if (m_colorAxis1Min != arg) {
+        m_colorAxis1Min = arg;
+        emit colorAxis1MinChanged(arg);
+    }
+
+    if (!m_colorAxis2MinSet && (m_colorAxis2Min != arg)) {
+        m_colorAxis2Min = arg;
+        emit colorAxis2MinChanged(arg);
+    }
+}
+
+void GLGridItem::setColorAxis2Min(QColor arg)
+{
+    m_colorAxis2MinSet = true;
+
+    if (m_colorAxis2Min != arg) {
+        m_colorAxis2Min = arg;
+        emit colorAxis2MinChanged(arg);
+    }
+}
+
+/** Adds the lines crossing the axis from position 0 to length in steps of the interval */
+void GLGridItem::paintLines(GLView *glView, int axis, const GridLines &lines, const QVector3D &span, float length)
+{
+    float position;
+
+    if (!lines.enabled || (lines.interval <= 0.0))    // a zero interval would never end
+    {
+        return;
+    }
+
+    position = m_alignToOrigin ? std::fmod(std::fabs(m_minimum[axis]), lines.interval) : 0.0;
+
+    glView->color(lines.color);
+    glView->lineWidth(lines.lineWidth);
+    glView->beginUnion();
+    while (position <= length)
+    {
+        QVector3D start(0.0, 0.0, 0.0);
+        QVector3D end = span;
+
+        start[axis] = position;
+        end[axis] = position;
+        glView->lineFromTo(start, end);
+        position += lines.interval;
+    }
+    glView->endUnion();
+}
+}; // namespace qtquickvcp
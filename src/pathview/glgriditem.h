@@ -0,0 +1,352 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#ifndef GLGRIDITEM_H
+#define GLGRIDITEM_H
+
+#include "glitem.h"
+
+namespace qtquickvcp {
+
+class GLGridItem : public GLItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QVector3D minimum READ minimum WRITE setMinimum NOTIFY minimumChanged)
+    Q_PROPERTY(QVector3D maximum READ maximum WRITE setMaximum NOTIFY maximumChanged)
+    Q_PROPERTY(float lineWidthAxis1 READ lineWidthAxis1 WRITE setLineWidthAxis1 NOTIFY lineWidthAxis1Changed)
+    Q_PROPERTY(float lineWidthAxis1Min READ lineWidthAxis1Min WRITE setLineWidthAxis1Min NOTIFY lineWidthAxis1MinChanged)
+    Q_PROPERTY(float lineWidthAxis2 READ lineWidthAxis2 WRITE setLineWidthAxis2 NOTIFY lineWidthAxis2Changed)
+    Q_PROPERTY(float lineWidthAxis2Min READ lineWidthAxis2Min WRITE setLineWidthAxis2Min NOTIFY lineWidthAxis2MinChanged)
+    Q_PROPERTY(QColor colorAxis1 READ colorAxis1 WRITE setColorAxis1 NOTIFY colorAxis1Changed)
+    Q_PROPERTY(QColor colorAxis2 READ colorAxis2 WRITE setColorAxis2 NOTIFY colorAxis2Changed)
+    Q_PROPERTY(QColor colorAxis1Min READ colorAxis1Min WRITE setColorAxis1Min NOTIFY colorAxis1MinChanged)
+    Q_PROPERTY(QColor colorAxis2Min READ colorAxis2Min WRITE setColorAxis2Min NOTIFY colorAxis2MinChanged)
+    Q_PROPERTY(float intervalAxis1 READ intervalAxis1 WRITE setIntervalAxis1 NOTIFY intervalAxis1Changed)
+    Q_PROPERTY(float intervalAxis1Min READ intervalAxis1Min WRITE setIntervalAxis1Min NOTIFY intervalAxis1MinChanged)
+    Q_PROPERTY(float intervalAxis2 READ intervalAxis2 WRITE setIntervalAxis2 NOTIFY intervalAxis2Changed)
+    Q_PROPERTY(float intervalAxis2Min READ intervalAxis2Min WRITE setIntervalAxis2Min NOTIFY intervalAxis2MinChanged)
+    Q_PROPERTY(bool enableAxis1 READ enableAxis1 WRITE setEnableAxis1 NOTIFY enableAxis1Changed)
+    Q_PROPERTY(bool enableAxis2 READ enableAxis2 WRITE setEnableAxis2 NOTIFY enableAxis2Changed)
+    Q_PROPERTY(bool enableAxis1Min READ enableAxis1Min WRITE setEnableAxis1Min NOTIFY enableAxis1MinChanged)
+    Q_PROPERTY(bool enableAxis2Min READ enableAxis2Min WRITE setEnableAxis2Min NOTIFY enableAxis2MinChanged)
+    Q_PROPERTY(bool alignToOrigin READ alignToOrigin WRITE setAlignToOrigin NOTIFY alignToOriginChanged)
+    Q_PROPERTY(QString plane READ plane WRITE setPlane NOTIFY planeChanged)
+
+public:
+    explicit GLGridItem(QQuickItem *parent = 0);
+
+    virtual void paint(GLView *glView);
+
+    QVector3D minimum() const
+    {
+        return m_minimum;
+    }
+
+    QVector3D maximum() const
+    {
+        return m_maximum;
+    }
+
+    float lineWidthAxis1() const
+    {
+        return m_lineWidthAxis1;
+    }
+
+    float lineWidthAxis1Min() const
+    {
+        return m_lineWidthAxis1Min;
+    }
+
+    float lineWidthAxis2() const
+    {
+        return m_lineWidthAxis2;
+    }
+
+    float lineWidthAxis2Min() const
+    {
+        return m_lineWidthAxis2Min;
+    }
+
+    QColor colorAxis1() const
+    {
+        return m_colorAxis1;
+    }
+
+    QColor colorAxis2() const
+    {
+        return m_colorAxis2;
+    }
+
+    QColor colorAxis1Min() const
+    {
+        return m_colorAxis1Min;
+    }
+
+    QColor colorAxis2Min() const
+    {
+        return m_colorAxis2Min;
+    }
+
+    float intervalAxis1() const
+    {
+        return m_intervalAxis1;
+    }
+
+    float intervalAxis1Min() const
+    {
+        return m_intervalAxis1Min;
+    }
+
+    float intervalAxis2() const
+    {
+        return m_intervalAxis2;
+    }
+
+    float intervalAxis2Min() const
+    {
+        return m_intervalAxis2Min;
+    }
+
+    bool enableAxis1() const
+    {
+        return m_enableAxis1;
+    }
+
+    bool enableAxis2() const
+    {
+        return m_enableAxis2;
+    }
+
+    bool enableAxis1Min() const
+    {
+        return m_enableAxis1Min;
+    }
+
+    bool enableAxis2Min() const
+    {
+        return m_enableAxis2Min;
+    }
+
+    bool alignToOrigin() const
+    {
+        return m_alignToOrigin;
+    }
+
+    QString plane() const
+    {
+        return m_plane;
+    }
+
+signals:
+    void minimumChanged(QVector3D arg);
+    void maximumChanged(QVector3D arg);
+    void lineWidthAxis1Changed(float arg);
+    void lineWidthAxis1MinChanged(float arg);
+    void lineWidthAxis2Changed(float arg);
+    void lineWidthAxis2MinChanged(float arg);
+    void colorAxis1Changed(QColor arg);
+    void colorAxis2Changed(QColor arg);
+    void colorAxis1MinChanged(QColor arg);
+    void colorAxis2MinChanged(QColor arg);
+    void intervalAxis1Changed(float arg);
+    void intervalAxis1MinChanged(float arg);
+    void intervalAxis2Changed(float arg);
+    void intervalAxis2MinChanged(float arg);
+    void enableAxis1Changed(bool arg);
+    void enableAxis2Changed(bool arg);
+    void enableAxis1MinChanged(bool arg);
+    void enableAxis2MinChanged(bool arg);
+    void alignToOriginChanged(bool arg);
+    void planeChanged(QString arg);
+
+public slots:
+    virtual void selectDrawable(void *pointer);
+
+    void setColorAxis1(QColor arg);
+    void setColorAxis2(QColor arg);
+    void setColorAxis1Min(QColor arg);
+    void setColorAxis2Min(QColor arg);
+
+    void setMinimum(QVector3D arg)
+    {
+        if (m_minimum != arg) {
+            m_minimum = arg;
+            emit minimumChanged(arg);
+        }
+    }
+
+    void setMaximum(QVector3D arg)
+    {
+        if (m_maximum != arg) {
+            m_maximum = arg;
+            emit maximumChanged(arg);
+        }
+    }
+
+    void setLineWidthAxis1(float arg)
+    {
+        if (m_lineWidthAxis1 != arg) {
+            m_lineWidthAxis1 = arg;
+            emit lineWidthAxis1Changed(arg);
+        }
+    }
+
+    void setLineWidthAxis1Min(float arg)
+    {
+        if (m_lineWidthAxis1Min != arg) {
+            m_lineWidthAxis1Min = arg;
+            emit lineWidthAxis1MinChanged(arg);
+        }
+    }
+
+    void setLineWidthAxis2(float arg)
+    {
+        if (m_lineWidthAxis2 != arg) {
+            m_lineWidthAxis2 = arg;
+            emit lineWidthAxis2Changed(arg);
+        }
+    }
+
+    void setLineWidthAxis2Min(float arg)
+    {
+        if (m_lineWidthAxis2Min != arg) {
+            m_lineWidthAxis2Min = arg;
+            emit lineWidthAxis2MinChanged(arg);
+        }
+    }
+
+    void setIntervalAxis1(float arg)
+    {
+        if (m_intervalAxis1 != arg) {
+            m_intervalAxis1 = arg;
+            emit intervalAxis1Changed(arg);
+        }
+    }
+
+    void setIntervalAxis1Min(float arg)
+    {
+        if (m_intervalAxis1Min != arg) {
+            m_intervalAxis1Min = arg;
+            emit intervalAxis1MinChanged(arg);
+        }
+    }
+
+    void setIntervalAxis2(float arg)
+    {
+        if (m_intervalAxis2 != arg) {
+            m_intervalAxis2 = arg;
+            emit intervalAxis2Changed(arg);
+        }
+    }
+
+    void setIntervalAxis2Min(float arg)
+    {
+        if (m_intervalAxis2Min != arg) {
+            m_intervalAxis2Min = arg;
+            emit intervalAxis2MinChanged(arg);
+        }
+    }
+
+    void setEnableAxis1(bool arg)
+    {
+        if (m_enableAxis1 != arg) {
+            m_enableAxis1 = arg;
+            emit enableAxis1Changed(arg);
+        }
+    }
+
+    void setEnableAxis2(bool arg)
+    {
+        if (m_enableAxis2 != arg) {
+            m_enableAxis2 = arg;
+            emit enableAxis2Changed(arg);
+        }
+    }
+
+    void setEnableAxis1Min(bool arg)
+    {
+        if (m_enableAxis1Min != arg) {
+            m_enableAxis1Min = arg;
+            emit enableAxis1MinChanged(arg);
+        }
+    }
+
+    void setEnableAxis2Min(bool arg)
+    {
+        if (m_enableAxis2Min != arg) {
+            m_enableAxis2Min = arg;
+            emit enableAxis2MinChanged(arg);
+        }
+    }
+
+    void setAlignToOrigin(bool arg)
+    {
+        if (m_alignToOrigin != arg) {
+            m_alignToOrigin = arg;
+            emit alignToOriginChanged(arg);
+        }
+    }
+
+    void setPlane(QString arg)
+    {
+        if (m_plane != arg) {
+            m_plane = arg;
+            emit planeChanged(arg);
+        }
+    }
+
+private:
+    QVector3D m_minimum;
+    QVector3D m_maximum;
+    float m_lineWidthAxis1;
+    float m_lineWidthAxis1Min;
+    float m_lineWidthAxis2;
+    float m_lineWidthAxis2Min;
+    QColor m_colorAxis1;
+    QColor m_colorAxis2;
+    QColor m_colorAxis1Min;
+    QColor m_colorAxis2Min;
+    float m_intervalAxis1;
+    float m_intervalAxis1Min;
+    float m_intervalAxis2;
+    float m_intervalAxis2Min;
+    bool m_enableAxis1;
+    bool m_enableAxis2;
+    bool m_enableAxis1Min;
+    bool m_enableAxis2Min;
+    bool m_alignToOrigin;
+    QString m_plane;
+    bool m_colorAxis2Set;       // otherwise the color of axis 2 follows axis 1
+    bool m_colorAxis2MinSet;
+
+    typedef struct {
+        bool enabled;
+        float interval;
+        QColor color;
+        float lineWidth;
+    } GridLines;
+
+    void paintLines(GLView *glView, int axis, const GridLines &lines, const QVector3D &span, float length);
+}; // class GLGridItem
+} // namespace qtquickvcp
+
+#endif // GLGRIDITEM_H
@@ -22,6 +22,7 @@
 
 #include "glpathitem.h"
 #include <QtCore/qmath.h>
+#include <QtConcurrent/QtConcurrentRun>
 #include <cmath>
 #include "debughelper.h"
 
@@ -45,10 +46,20 @@ GLPathItem::GLPathItem(QQuickItem *parent) :
     m_activeColor(QColor(Qt::red)),
     m_lineWidth(1.0),
     m_traverseLineStippleLength(1.0),
+    m_currentRow(-1),
     m_needsFullUpdate(true),
+    m_needsRebuild(false),
+    m_paintedPathItems(0),
     m_minimumExtents(QVector3D(0, 0, 0)),
-    m_maximumExtents(QVector3D(0, 0, 0))
+    m_maximumExtents(QVector3D(0, 0, 0)),
+    m_queuedPreviewItems(0),
+    m_availablePreviewItems(0),
+    m_finishPending(false),
+    m_processing(false)
 {
+    connect(&m_processWatcher, &QFutureWatcher<void>::finished,
+            this, &GLPathItem::mergeProcessedPart);
+
     connect(this, &GLPathItem::visibleChanged,
             this, &GLPathItem::triggerFullUpdate);
     connect(this, &GLPathItem::positionChanged,
@@ -65,74 +76,54 @@ GLPathItem::GLPathItem(QQuickItem *parent) :
             this, &GLPathItem::triggerFullUpdate);
     connect(this, &GLPathItem::lineWidthChanged,
             this, &GLPathItem::triggerFullUpdate);
+
+    // colors are applied through the line palette without rebuilding the path
+    connect(this, &GLPathItem::arcFeedColorChanged, this, &GLPathItem::needsUpdate);
+    connect(this, &GLPathItem::straightFeedColorChanged, this, &GLPathItem::needsUpdate);
+    connect(this, &GLPathItem::traverseColorChanged, this, &GLPathItem::needsUpdate);
+    connect(this, &GLPathItem::backplotArcFeedColorChanged, this, &GLPathItem::needsUpdate);
+    connect(this, &GLPathItem::backplotStraightFeedColorChanged, this, &GLPathItem::needsUpdate);
+    connect(this, &GLPathItem::backplotTraverseColorChanged, this, &GLPathItem::needsUpdate);
+    connect(this, &GLPathItem::selectedColorChanged, this, &GLPathItem::needsUpdate);
+    connect(this, &GLPathItem::activeColorChanged, this, &GLPathItem::needsUpdate);
 }
 
 GLPathItem::~GLPathItem()
 {
+    m_processWatcher.waitForFinished();
+    qDeleteAll(m_processedPart.pathItems);
     qDeleteAll(m_previewPathItems);
 }
 
 void GLPathItem::paint(GLView *glView)
 {
+    glView->updatePalette(this, linePalette());
+
     if (m_needsFullUpdate)
     {
         glView->prepare(this);
         glView->reset();
-        glView->lineWidth(m_lineWidth);
-        glView->beginUnion();
-
-        for (int i = 0; i < m_previewPathItems.size(); ++i)
-        {
-            void* drawablePointer = nullptr;
-            PathItem *pathItem = m_previewPathItems.at(i);
-            if (pathItem->pathType == Line)
-            {
-                LinePathItem *linePathItem = static_cast<LinePathItem*>(pathItem);
-                if (linePathItem->movementType == FeedMove)
-                {
-                    glView->color(m_straightFeedColor);
-                }
-                else
-                {
-                    glView->color(m_traverseColor);
-                    glView->lineStipple(true, m_traverseLineStippleLength);
-                }
-                glView->translate(linePathItem->position);
-                drawablePointer = glView->line(linePathItem->lineVector);
-            }
-            else if (pathItem->pathType == Arc)
-            {
-                ArcPathItem *arcPathItem = static_cast<ArcPathItem*>(pathItem);
-                glView->color(m_arcFeedColor);
-                glView->translate(arcPathItem->position);
-                if (arcPathItem->rotationPlane == XZPlane) {
-                    glView->rotate(90, 1, 0, 0);
-                }
-                else if  (arcPathItem->rotationPlane == YZPlane) {
-                    glView->rotate(-90, 0, 1, 0);
-                }
-                drawablePointer = glView->arc(arcPathItem->center.x(),
-                                              arcPathItem->center.y(),
-                                              arcPathItem->radius,
-                                              arcPathItem->startAngle,
-                                              arcPathItem->endAngle,
-                                              arcPathItem->anticlockwise,
-                                              arcPathItem->helixOffset);
-            }
-
-            if (drawablePointer != nullptr)
-            {
-                pathItem->drawablePointer = drawablePointer;
-                m_drawablePathMap.insert(drawablePointer, pathItem);
-            }
-        }
-
-        glView->endUnion();
+        glView->streamLines(this, m_processing);    // the levels of detail are created by the final rebuild
+        m_paintedPathItems = 0;
+        paintPathItems(glView);
 
         m_needsFullUpdate = false;
+        m_needsRebuild = false;
     }
     else
     {
+        if (m_paintedPathItems < m_previewPathItems.size())    // streamed path items are appended
+        {
+            glView->prepare(this);
+            paintPathItems(glView);
+        }
+
+        if (m_needsRebuild)
+        {
+            glView->rebuild(this);
+            m_needsRebuild = false;
+        }
+
         for (int i = 0; i < m_modifiedPathItems.size(); ++i)
         {
             PathItem *pathItem;
@@ -140,49 +131,93 @@ void GLPathItem::paint(GLView *glView)
             pathItem = m_modifiedPathItems.at(i);
             if (pathItem != nullptr)
             {
-                QColor color;
-                if (m_model->data(pathItem->modelIndex, GCodeProgramModel::SelectedRole).toBool()) {
-                    color = m_selectedColor;
+                PathState state;
+                if (m_model->data(m_model->index(pathItem->row), GCodeProgramModel::SelectedRole).toBool()) {
+                    state = SelectedState;
                 }
-                else if (m_model->data(pathItem->modelIndex, GCodeProgramModel::ActiveRole).toBool())
+                else if (m_model->data(m_model->index(pathItem->row), GCodeProgramModel::ActiveRole).toBool())
                 {
-                    color = m_activeColor;
+                    state = ActiveState;
                 }
-                else if (m_model->data(pathItem->modelIndex, GCodeProgramModel::ExecutedRole).toBool())
+                else if (m_model->data(m_model->index(pathItem->row), GCodeProgramModel::ExecutedRole).toBool())
                 {
-                    if (pathItem->movementType == FeedMove) {
-                        if (pathItem->pathType == Arc) {
-                            color = m_backplotArcFeedColor;
-                        }
-                        else {
-                            color = m_backplotStraightFeedColor;
-                        }
-                    }
-                    else {
-                        color = m_backplotTraverseColor;
-                    }
+                    state = ExecutedState;
                 }
                 else
                 {
-                    if (pathItem->movementType == FeedMove) {
-                        if (pathItem->pathType == Arc) {
-                            color = m_arcFeedColor;
-                        }
-                        else {
-                            color = m_straightFeedColor;
-                        }
-                    }
-                    else {
-                        color = m_traverseColor;
-                    }
+                    state = NormalState;
                 }
-                glView->updateColor(pathItem->drawablePointer, color);
+                glView->updateState(pathItem->drawablePointer, lineState(pathItem, state));
             }
         }
         m_modifiedPathItems.clear();
     }
 }
 
+/** Passes the path items not yet painted to the GL view
+ *
+ *  The GUI thread is blocked while the items are painted, so a large path is
+ *  passed in parts over several synchronizations.
+ **/
+void GLPathItem::paintPathItems(GLView *glView)
+{
+    const int maximumPartSize = 20000;
+    const int last = qMin(m_previewPathItems.size(), m_paintedPathItems + maximumPartSize);
+
+    glView->lineWidth(m_lineWidth);
+    glView->beginUnion();
+
+    for (int i = m_paintedPathItems; i < last; ++i)
+    {
+        void* drawablePointer = nullptr;
+        PathItem *pathItem = m_previewPathItems.at(i);
+        if (pathItem->pathType == Line)
+        {
+            LinePathItem *linePathItem = static_cast<LinePathItem*>(pathItem);
+            if (linePathItem->movementType == TraverseMove)
+            {
+                glView->lineStipple(true, m_traverseLineStippleLength);
+            }
+            glView->lineState(lineState(linePathItem, NormalState));
+            glView->translate(linePathItem->position);
+            drawablePointer = glView->line(linePathItem->lineVector);
+        }
+        else if (pathItem->pathType == Arc)
+        {
+            ArcPathItem *arcPathItem = static_cast<ArcPathItem*>(pathItem);
+            glView->lineState(lineState(arcPathItem, NormalState));
+            glView->translate(arcPathItem->position);
+            if (arcPathItem->rotationPlane == XZPlane) {
+                glView->rotate(90, 1, 0, 0);
+            }
+            else if  (arcPathItem->rotationPlane == YZPlane) {
+                glView->rotate(-90, 0, 1, 0);
+            }
+            drawablePointer = glView->arc(arcPathItem->center.x(),
+                                          arcPathItem->center.y(),
+                                          arcPathItem->radius,
+                                          arcPathItem->startAngle,
+                                          arcPathItem->endAngle,
+                                          arcPathItem->anticlockwise,
+                                          arcPathItem->helixOffset);
+        }
+
+        if (drawablePointer != nullptr)
+        {
+            pathItem->drawablePointer = drawablePointer;
+            m_drawablePathMap.insert(drawablePointer, pathItem);
+        }
+    }
+
+    glView->endUnion();
+
+    m_paintedPathItems = last;
+    if (m_paintedPathItems < m_previewPathItems.size())
+    {
+        emit needsUpdate();     // paint the next part with the next synchronization
+    }
+}
+
 GCodeProgramModel *GLPathItem::model() const
 {
     return m_model;
@@ -213,6 +248,11 @@ QVector3D GLPathItem::maximumExtents() const
     return m_maximumExtents;
 }
 
+bool GLPathItem::processing() const
+{
+    return m_processing;
+}
+
 float GLPathItem::lineWidth() const
 {
     return m_lineWidth;
@@ -261,7 +301,7 @@ void GLPathItem::selectDrawable(void *pointer)
     mappedPathItem = m_drawablePathMap.value(pointer, nullptr);
     if (mappedPathItem != nullptr)
     {
-        mappedModelIndex = mappedPathItem->modelIndex;
+        mappedModelIndex = m_model->index(mappedPathItem->row);
         m_model->setData(mappedModelIndex, true, GCodeProgramModel::SelectedRole);
     }
 
@@ -270,7 +310,7 @@ void GLPathItem::selectDrawable(void *pointer)
         mappedPathItem = m_drawablePathMap.value(m_previousSelectedDrawable);
         if (mappedPathItem != nullptr)
         {
-            mappedModelIndex = mappedPathItem->modelIndex;
+            mappedModelIndex = m_model->index(mappedPathItem->row);
             m_model->setData(mappedModelIndex, false, GCodeProgramModel::SelectedRole);
         }
 
@@ -288,6 +328,12 @@ void GLPathItem::setModel(GCodeProgramModel *arg)
         {
             connect(m_model, SIGNAL(modelReset()),
                     this, SLOT(drawPath()));
+            connect(m_model, SIGNAL(previewStarted()),
+                    this, SLOT(startPath()));
+            connect(m_model, SIGNAL(previewItemsAdded(int,int)),
+                    this, SLOT(appendPath(int,int)));
+            connect(m_model, SIGNAL(previewFinished()),
+                    this, SLOT(finishPath()));
             connect(m_model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)),
                     this, SLOT(modelDataChanged(QModelIndex,QModelIndex,QVector<int>)));
 
@@ -379,6 +425,37 @@ void GLPathItem::setBackplotTraverseColor(QColor arg)
     }
 }
 
+/** Returns the palette entry of the path item in the given state */
+int GLPathItem::lineState(const PathItem *pathItem, PathState state) const
+{
+    int group;
+
+    if (pathItem->movementType == TraverseMove) {
+        group = 2;
+    }
+    else if (pathItem->pathType == Arc) {
+        group = 1;
+    }
+    else {
+        group = 0;
+    }
+
+    return 1 + group * PathStateCount + state;  // entry 0 is reserved for the vertex color
+}
+
+/** Returns the colors of all line states, ordered as returned by lineState */
+QList<QColor> GLPathItem::linePalette() const
+{
+    QList<QColor> palette;
+
+    palette << QColor()
+            << m_straightFeedColor << m_backplotStraightFeedColor << m_activeColor << m_selectedColor
+            << m_arcFeedColor << m_backplotArcFeedColor << m_activeColor << m_selectedColor
+            << m_traverseColor << m_backplotTraverseColor << m_activeColor << m_selectedColor;
+
+    return palette;
+}
+
 void GLPathItem::resetActiveOffsets()
 {
     Position clearOffset;
@@ -440,27 +517,30 @@ void GLPathItem::resetExtents()
     m_extentsUpdated = false;
 }
 
+/** Extends the extents of the processed part, called from the worker */
 void GLPathItem::updateExtents(const QVector3D &vector)
 {
-    if ((vector.x() < m_minimumExtents.x()) || !m_extentsUpdated) {
-        m_minimumExtents.setX(vector.x());
+    PathPart &part = m_processedPart;
+
+    if ((vector.x() < part.minimumExtents.x()) || !part.extentsUpdated) {
+        part.minimumExtents.setX(vector.x());
     }
-    if ((vector.y() < m_minimumExtents.y()) || !m_extentsUpdated) {
-        m_minimumExtents.setY(vector.y());
+    if ((vector.y() < part.minimumExtents.y()) || !part.extentsUpdated) {
+        part.minimumExtents.setY(vector.y());
     }
-    if ((vector.z() < m_minimumExtents.z()) || !m_extentsUpdated) {
-        m_minimumExtents.setZ(vector.z());
+    if ((vector.z() < part.minimumExtents.z()) || !part.extentsUpdated) {
+        part.minimumExtents.setZ(vector.z());
     }
-    if ((vector.x() > m_maximumExtents.x()) || !m_extentsUpdated) {
-        m_maximumExtents.setX(vector.x());
+    if ((vector.x() > part.maximumExtents.x()) || !part.extentsUpdated) {
+        part.maximumExtents.setX(vector.x());
     }
-    if ((vector.y() > m_maximumExtents.y()) || !m_extentsUpdated) {
-        m_maximumExtents.setY(vector.y());
+    if ((vector.y() > part.maximumExtents.y()) || !part.extentsUpdated) {
+        part.maximumExtents.setY(vector.y());
     }
-    if ((vector.z() > m_maximumExtents.z()) || !m_extentsUpdated) {
-        m_maximumExtents.setZ(vector.z());
+    if ((vector.z() > part.maximumExtents.z()) || !part.extentsUpdated) {
+        part.maximumExtents.setZ(vector.z());
     }
-    m_extentsUpdated = true;
+    part.extentsUpdated = true;
 }
 
 void GLPathItem::releaseExtents()
@@ -469,19 +549,30 @@ void GLPathItem::releaseExtents()
     emit maximumExtentsChanged(m_maximumExtents);
 }
 
-void GLPathItem::processPreview(const Preview &preview)
+void GLPathItem::processPreview(const GCodePreviewStore &previewStore, int index)
 {
-    switch (preview.type())
+    machinetalk::Position position;
+
+    switch (previewStore.type(index))
     {
     case PV_STRAIGHT_PROBE:  /*nothing*/ return;
     case PV_RIGID_TAP:  /*nothing*/ return;
-    case PV_STRAIGHT_FEED: processStraightMove(preview, FeedMove); return;
-    case PV_ARC_FEED: processArcFeed(preview); return;
-    case PV_STRAIGHT_TRAVERSE: processStraightMove(preview, TraverseMove); return;
-    case PV_SET_G5X_OFFSET: processSetG5xOffset(preview); return;
-    case PV_SET_G92_OFFSET: processSetG92Offset(preview); return;
+    case PV_STRAIGHT_FEED:
+        previewStore.position(index, &position);
+        processStraightMove(position, FeedMove);
+        return;
+    case PV_ARC_FEED:
+        previewStore.position(index, &position);
+        processArcFeed(position, previewStore.arc(index));
+        return;
+    case PV_STRAIGHT_TRAVERSE:
+        previewStore.position(index, &position);
+        processStraightMove(position, TraverseMove);
+        return;
+    case PV_SET_G5X_OFFSET: processSetG5xOffset(previewStore.operation(index)); return;
+    case PV_SET_G92_OFFSET: processSetG92Offset(previewStore.operation(index)); return;
     case PV_SET_XY_ROTATION: /*nothing*/ return;
-    case PV_SELECT_PLANE: processSelectPlane(preview); return;
+    case PV_SELECT_PLANE: processSelectPlane(previewStore.operation(index)); return;
     case PV_SET_TRAVERSE_RATE: /*nothing*/ return;
     case PV_SET_FEED_RATE: /*nothing*/ return;
     case PV_CHANGE_TOOL: /*nothing*/ return;
@@ -489,7 +580,7 @@ void GLPathItem::processPreview(const Preview &preview)
     case PV_DWELL: /*nothing*/ return;
     case PV_MESSAGE: /*nothing*/ return;
     case PV_COMMENT: /*nothing*/ return;
-    case PV_USE_TOOL_OFFSET: processUseToolOffset(preview); return;
+    case PV_USE_TOOL_OFFSET: processUseToolOffset(previewStore.operation(index)); return;
     case PV_SET_PARAMS: /*nothing*/ return;
     case PV_SET_FEED_MODE: /*nothing*/ return;
     case PV_SOURCE_CONTEXT: /*nothing*/ return;
@@ -498,7 +589,7 @@ void GLPathItem::processPreview(const Preview &preview)
     }
 }
 
-void GLPathItem::processStraightMove(const Preview &preview, MovementType movementType)
+void GLPathItem::processStraightMove(const machinetalk::Position &position, MovementType movementType)
 {
 #ifdef QT_DEBUG
     if (movementType == FeedMove)
@@ -518,23 +609,22 @@ void GLPathItem::processStraightMove(const Preview &preview, MovementType moveme
 
     linePathItem = new LinePathItem();
     currentVector = positionToVector3D(m_currentPosition);
-    newPosition = calculateNewPosition(preview.pos());
+    newPosition = calculateNewPosition(position);
     newVector = positionToVector3D(newPosition);
 
     linePathItem->position = currentVector;
     linePathItem->lineVector = newVector - currentVector;
     linePathItem->movementType = movementType;
-    linePathItem->modelIndex = m_currentModelIndex;
-    m_previewPathItems.append(linePathItem);
-    m_modelPathMap.insert(m_currentModelIndex, linePathItem);   // mapping model index to the item
+    linePathItem->row = m_currentRow;
+    m_processedPart.pathItems.append(linePathItem);
 
     m_currentPosition = newPosition;
-    m_relativePosition = preview.pos();
+    m_relativePosition = position;
 
     updateExtents(newVector);
 }
 
-void GLPathItem::processArcFeed(const Preview &preview)
+void GLPathItem::processArcFeed(const machinetalk::Position &position, const GCodePreviewStore::Arc &arc)
 {
 #ifdef QT_DEBUG
     qDebug() << "arc feed";
@@ -556,14 +646,14 @@ void GLPathItem::processArcFeed(const Preview &preview)
     ArcPathItem *arcPathItem;
 
     currentVector = positionToVector3D(m_currentPosition);
-    newPosition = calculateNewPosition(preview.pos());
+    newPosition = calculateNewPosition(position);
 
     if (m_activePlane == XYPlane)
     {
         arcPathItem = new ArcPathItem();
-        newPosition.x = preview.first_end();
-        newPosition.y = preview.second_end();
-        newPosition.z = preview.axis_end_point();
+        newPosition.x = arc.firstEnd;
+        newPosition.y = arc.secondEnd;
+        newPosition.z = arc.axisEndPoint;
         newVector = positionToVector3D(newPosition);
 
         startPoint.setX(currentVector.x());
@@ -574,9 +664,9 @@ void GLPathItem::processArcFeed(const Preview &preview)
     else if (m_activePlane == YZPlane)
     {
         arcPathItem = new ArcPathItem();
-        newPosition.y = preview.first_end();
-        newPosition.z = preview.second_end();
-        newPosition.x = preview.axis_end_point();
+        newPosition.y = arc.firstEnd;
+        newPosition.z = arc.secondEnd;
+        newPosition.x = arc.axisEndPoint;
         newVector = positionToVector3D(newPosition);
 
         startPoint.setX(currentVector.y());
@@ -587,9 +677,9 @@ void GLPathItem::processArcFeed(const Preview &preview)
     else if (m_activePlane == XZPlane)
     {
         arcPathItem = new ArcPathItem();
-        newPosition.x = preview.first_end();
-        newPosition.z = preview.second_end();
-        newPosition.y = preview.axis_end_point();
+        newPosition.x = arc.firstEnd;
+        newPosition.z = arc.secondEnd;
+        newPosition.y = arc.axisEndPoint;
         newVector = positionToVector3D(newPosition);
 
         startPoint.setX(currentVector.x());
@@ -602,21 +692,21 @@ void GLPathItem::processArcFeed(const Preview &preview)
         return; // not supported
     }
 
-    endPoint.setX(static_cast<float>(preview.first_end()));
-    endPoint.setY(static_cast<float>(preview.second_end()));
-    centerPoint.setX(static_cast<float>(preview.first_axis()));
-    centerPoint.setY(static_cast<float>(preview.second_axis()));
+    endPoint.setX(static_cast<float>(arc.firstEnd));
+    endPoint.setY(static_cast<float>(arc.secondEnd));
+    centerPoint.setX(static_cast<float>(arc.firstAxis));
+    centerPoint.setY(static_cast<float>(arc.secondAxis));
     startVector = startPoint - centerPoint;
     endVector = endPoint - centerPoint;
 
     startAngle = std::atan2(startVector.y(), startVector.x());
     endAngle = std::atan2(endVector.y(), endVector.x());
-    anticlockwise = preview.rotation() >= 0;
+    anticlockwise = arc.rotation >= 0;
     if (anticlockwise) {
-        startAngle += 2.0f * PI_F * (std::fabs(static_cast<float>(preview.rotation())) - 1.0f);  // for rotation > 1 increase the endAngle
+        startAngle += 2.0f * PI_F * (std::fabs(static_cast<float>(arc.rotation)) - 1.0f);  // for rotation > 1 increase the endAngle
     }
     else {
-        endAngle -= 2.0f * PI_F * (std::fabs(static_cast<float>(preview.rotation())) - 1.0f);  // for rotation > 1 decrease the startAngle
+        endAngle -= 2.0f * PI_F * (std::fabs(static_cast<float>(arc.rotation)) - 1.0f);  // for rotation > 1 decrease the startAngle
     }
 
     radius = centerPoint.distanceToPoint(startPoint);
@@ -721,12 +811,11 @@ void GLPathItem::processArcFeed(const Preview &preview)
     arcPathItem->endAngle = endAngle;
     arcPathItem->anticlockwise = anticlockwise;
     arcPathItem->movementType = FeedMove;
-    arcPathItem->modelIndex = m_currentModelIndex;
-    m_previewPathItems.append(arcPathItem);
-    m_modelPathMap.insertMulti(m_currentModelIndex, arcPathItem);   // mapping model index to the item
+    arcPathItem->row = m_currentRow;
+    m_processedPart.pathItems.append(arcPathItem);
 
     m_currentPosition = newPosition;
-    m_relativePosition = preview.pos();
+    m_relativePosition = position;
 }
 
 void GLPathItem::processSetG5xOffset(const Preview &preview)
@@ -887,14 +976,30 @@ QVector3D GLPathItem::positionToVector3D(const GLPathItem::Position &position) c
 
 void GLPathItem::drawPath()
 {
-
     if (m_model == nullptr)
     {
         return;
     }
 
+    startPath();
+    appendPath(0, m_model->previewStore().size());
+    finishPath();
+}
+
+/** Clears the path and the interpreter state for a new preview */
+void GLPathItem::startPath()
+{
+    m_processWatcher.waitForFinished(); // the worker uses the interpreter state
+    qDeleteAll(m_processedPart.pathItems);
+    m_processedPart = PathPart();
+    m_queuedPreviewItems = 0;
+    m_availablePreviewItems = 0;
+    m_finishPending = false;
+    setProcessing(true);
+
     qDeleteAll(m_previewPathItems); // clear the list of preview path items
     m_previewPathItems.clear();
+    m_modifiedPathItems.clear();
     resetActiveOffsets(); // clear the offsets
     resetActivePlane();
     resetCurrentPosition();  // reset current position
@@ -905,34 +1010,145 @@ void GLPathItem::drawPath()
     m_drawablePathMap.clear();
     m_previousSelectedDrawable = nullptr;
 
-    QLinkedList<GCodeProgramModel::PreviewItem> previewItems = m_model->previewItems();
-    QLinkedListIterator<GCodeProgramModel::PreviewItem> i(previewItems);
-    while (i.hasNext())
+    m_needsFullUpdate = true;
+    emit needsUpdate();
+
+    releaseExtents();
+}
+
+/** Queues a part of the preview for processing, the interpreter state is kept between the parts */
+void GLPathItem::appendPath(int first, int count)
+{
+    m_availablePreviewItems = qMax(m_availablePreviewItems, first + count);
+    processNextPart();
+}
+
+/** Rebuilds the streamed geometry once all parts are processed to create the levels of detail */
+void GLPathItem::finishPath()
+{
+    m_finishPending = true;
+    finishPathWhenProcessed();
+}
+
+void GLPathItem::finishPathWhenProcessed()
+{
+    if (!m_finishPending || m_processWatcher.isRunning() || (m_queuedPreviewItems < m_availablePreviewItems))
     {
-        GCodeProgramModel::PreviewItem item = i.next();
-        m_currentModelIndex = item.modelIndex;
-        processPreview(item.previewItem);
+        return;
     }
 
-    m_needsFullUpdate = true;
+    m_finishPending = false;
+    m_needsRebuild = true;
     emit needsUpdate();
+    setProcessing(false);
+}
 
-    releaseExtents();
+void GLPathItem::setProcessing(bool processing)
+{
+    if (m_processing == processing)
+    {
+        return;
+    }
+
+    m_processing = processing;
+    emit processingChanged(processing);
+}
+
+/** Passes the next part of the preview to the worker thread
+ *
+ *  The parts are processed one after another since every move starts at the
+ *  end of the previous one. Limiting the part size keeps the GUI thread
+ *  responsive when a new preview has to wait for the running part.
+ **/
+void GLPathItem::processNextPart()
+{
+    const int maximumPartSize = 20000;
+
+    if ((m_model == nullptr) || m_processWatcher.isRunning() || (m_queuedPreviewItems >= m_availablePreviewItems))
+    {
+        return;
+    }
+
+    const int count = qMin(maximumPartSize, m_availablePreviewItems - m_queuedPreviewItems);
+    const GCodePreviewStore previewStore = m_model->previewStore();  // shares the data with the model
+    const int first = m_queuedPreviewItems;
+    m_queuedPreviewItems += count;
+
+    m_processWatcher.setFuture(QtConcurrent::run(this, &GLPathItem::processPreviewItems, previewStore, first, count));
+}
+
+/** Runs on the worker thread, the path items are collected in the processed part */
+void GLPathItem::processPreviewItems(const GCodePreviewStore &previewStore, int first, int count)
+{
+    for (int i = first; i < (first + count); ++i)
+    {
+        m_currentRow = previewStore.row(i);
+        processPreview(previewStore, i);
+    }
+}
+
+/** Swaps the processed part into the path items painted by the render thread */
+void GLPathItem::mergeProcessedPart()
+{
+    if (m_processWatcher.isRunning())
+    {
+        return;
+    }
+
+    PathPart part = m_processedPart;
+    m_processedPart = PathPart();
+
+    for (int i = 0; i < part.pathItems.size(); ++i)
+    {
+        PathItem *pathItem = part.pathItems.at(i);
+        m_previewPathItems.append(pathItem);
+        m_modelPathMap.insert(pathItem->row, pathItem);   // mapping model row to the item
+    }
+
+    if (part.extentsUpdated)
+    {
+        if (!m_extentsUpdated)
+        {
+            m_minimumExtents = part.minimumExtents;
+            m_maximumExtents = part.maximumExtents;
+        }
+        else
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                m_minimumExtents[axis] = qMin(m_minimumExtents[axis], part.minimumExtents[axis]);
+                m_maximumExtents[axis] = qMax(m_maximumExtents[axis], part.maximumExtents[axis]);
+            }
+        }
+        m_extentsUpdated = true;
+        releaseExtents();
+    }
+
+    if (!part.pathItems.isEmpty())
+    {
+        emit needsUpdate();
+    }
+
+    processNextPart();
+    finishPathWhenProcessed();
 }
 
 void GLPathItem::modelDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
 {
-    Q_UNUSED(bottomRight) // we only change one item at a time
     if (roles.contains(GCodeProgramModel::SelectedRole)
         || roles.contains(GCodeProgramModel::ActiveRole)
         || roles.contains(GCodeProgramModel::ExecutedRole))
     {
-        QList<PathItem*> pathItemList;
+        const int modifiedCount = m_modifiedPathItems.size();
+
+        // the states of the whole range are uploaded with a single buffer update in paint
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row)
+        {
+            m_modifiedPathItems.append(m_modelPathMap.values(row));
+        }
 
-        pathItemList = m_modelPathMap.values(topLeft);
-        if (!pathItemList.isEmpty())
+        if (m_modifiedPathItems.size() > modifiedCount)
         {
-            m_modifiedPathItems.append(pathItemList);
             emit needsUpdate();
         }
     }
@@ -23,6 +23,7 @@
 #ifndef GLPATHITEM_H
 #define GLPATHITEM_H
 
+#include <QFutureWatcher>
 #include "glitem.h"
 #include "gcodeprogrammodel.h"
 #include <machinetalk/protobuf/preview.pb.h>
@@ -45,6 +46,7 @@ class GLPathItem : public GLItem
     Q_PROPERTY(QVector3D maximumExtents READ maximumExtents NOTIFY maximumExtentsChanged)
     Q_PROPERTY(float lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
     Q_PROPERTY(float traverseLineStippleLength READ traverseLineStippleLength WRITE setTraverseLineStippleLength NOTIFY traverseLineStippleLengthChanged)
+    Q_PROPERTY(bool processing READ processing NOTIFY processingChanged)
 
 public:
     explicit GLPathItem(QQuickItem *parent = 0);
@@ -65,6 +67,7 @@ public:
     QVector3D maximumExtents() const;
     float lineWidth() const;
     float traverseLineStippleLength() const;
+    bool processing() const;
 
 public slots:
     virtual void selectDrawable(void *pointer);
@@ -111,6 +114,15 @@ private:
         TraverseMove
     };
 
+    // states of a path item, resolved to colors by the line shader
+    enum PathState {
+        NormalState = 0,
+        ExecutedState = 1,
+        ActiveState = 2,
+        SelectedState = 3,
+        PathStateCount = 4
+    };
+
     enum Plane {
         XYPlane,
         XZPlane,
@@ -125,12 +137,13 @@ private:
         PathItem():
             pathType(Line),
             movementType(FeedMove),
+            row(-1),
             drawablePointer(nullptr){}
 
         PathType pathType;
         MovementType movementType;
         QVector3D position;
-        QModelIndex modelIndex;
+        int row;    // row of the line in the model
         void *drawablePointer;
     };
 
@@ -166,6 +179,18 @@ private:
         Plane rotationPlane;
     };
 
+    // path items of a part of the preview, processed on a worker thread
+    class PathPart {
+    public:
+        PathPart():
+            extentsUpdated(false) {}
+
+        QList<PathItem*> pathItems;
+        QVector3D minimumExtents;
+        QVector3D maximumExtents;
+        bool extentsUpdated;
+    };
+
     GCodeProgramModel * m_model;
     QColor m_arcFeedColor;
     QColor m_straightFeedColor;
@@ -183,18 +208,29 @@ private:
     Position m_currentPosition;  // current absolute position (with offsets)
     Plane m_activePlane;
     QList<PathItem*> m_previewPathItems;
-    QModelIndex m_currentModelIndex;
-    QMultiMap<QModelIndex, PathItem*> m_modelPathMap;  // for mapping the model to internal items
+    int m_currentRow;
+    QMultiHash<int, PathItem*> m_modelPathMap;  // for mapping the model rows to internal items
     QMap<void*, PathItem*> m_drawablePathMap;  // for mapping GL views drawables to internal items
     void* m_previousSelectedDrawable;
 
     bool m_needsFullUpdate;
+    bool m_needsRebuild;
+    int m_paintedPathItems;     // path items passed to the GL view
     QList<PathItem*> m_modifiedPathItems;
 
     QVector3D m_minimumExtents;
     QVector3D m_maximumExtents;
     bool m_extentsUpdated;
 
+    // the interpreter state and the processed part are owned by the worker while it is running
+    QFutureWatcher<void> m_processWatcher;
+    PathPart m_processedPart;
+    int m_queuedPreviewItems;       // preview items passed to the worker
+    int m_availablePreviewItems;    // preview items announced by the model
+    bool m_finishPending;
+    bool m_processing;              // a path is being processed and not yet passed to the GL view
+
+    void setProcessing(bool processing);
     void resetActiveOffsets();
     void resetCurrentPosition();
     void resetRelativePosition();
@@ -202,19 +238,29 @@ private:
     void resetExtents();
     void updateExtents(const QVector3D &vector);
     void releaseExtents();
-    void processPreview(const machinetalk::Preview &preview);
-    void processStraightMove(const machinetalk::Preview &preview, MovementType movementType);
-    void processArcFeed(const machinetalk::Preview &preview);
+    void paintPathItems(GLView *glView);
+    void processNextPart();
+    void processPreviewItems(const GCodePreviewStore &previewStore, int first, int count);
+    void finishPathWhenProcessed();
+    void processPreview(const GCodePreviewStore &previewStore, int index);
+    void processStraightMove(const machinetalk::Position &position, MovementType movementType);
+    void processArcFeed(const machinetalk::Position &position, const GCodePreviewStore::Arc &arc);
     void processSetG5xOffset(const machinetalk::Preview &preview);
     void processSetG92Offset(const machinetalk::Preview &preview);
     void processUseToolOffset(const machinetalk::Preview &preview);
     void processSelectPlane(const machinetalk::Preview &preview);
+    int lineState(const PathItem *pathItem, PathState state) const;
+    QList<QColor> linePalette() const;
     Position previewPositionToPosition(const machinetalk::Position &position) const;
     Position calculateNewPosition(const machinetalk::Position &newPosition) const;
     QVector3D positionToVector3D(const Position &position) const;
 
 private slots:
     void drawPath();
+    void startPath();
+    void appendPath(int first, int count);
+    void finishPath();
+    void mergeProcessedPart();
     void modelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles);
     void triggerFullUpdate();
 
@@ -233,6 +279,7 @@ signals:
     void backplotTraverseColorChanged(QColor arg);
     void lineWidthChanged(float lineWidth);
     void traverseLineStippleLengthChanged(float traverseLineStippleLength);
+    void processingChanged(bool processing);
 }; // class GLPathItem
 } // namespace qtquickvcp
 
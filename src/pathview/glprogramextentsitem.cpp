@@ -0,0 +1,303 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#include "glprogramextentsitem.h"
+
+namespace qtquickvcp {
+
+/** Dimension lines and labels of the program extents along the visible axes
+ *
+ *  The labels of the limits are drawn in the limit color when the program
+ *  exceeds the limits of the machine.
+ **/
+GLProgramExtentsItem::GLProgramExtentsItem(QQuickItem *parent) :
+    GLItem(parent),
+    m_axes(3),
+    m_maximum(QVector3D(2.0, 3.0, 2.5)),
+    m_minimum(QVector3D(1.0, 0.8, 0.0)),
+    m_size(QVector3D(1.0, 2.2, 2.5)),
+    m_center(QVector3D(1.5, 1.9, 1.25)),
+    m_valid(true),
+    m_limitMaximum(QVector3D(1.5, 3.0, 2.5)),
+    m_limitMinimum(QVector3D(0.0, 0.0, 0.0)),
+    m_lineWidth(1.0),
+    m_color(QColor(Qt::magenta)),
+    m_limitColor(QColor(Qt::red)),
+    m_textSize(0.5),
+    m_prefix(QString()),
+    m_suffix(QString()),
+    m_decimals(2),
+    m_scaleFactor(1.0),
+    m_viewMode(QString("Perspective"))
+{
+    connect(this, &GLProgramExtentsItem::axesChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::maximumChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::minimumChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::limitMaximumChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::limitMinimumChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::lineWidthChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::colorChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::limitColorChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::textSizeChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::prefixChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::suffixChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::decimalsChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::scaleFactorChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+    connect(this, &GLProgramExtentsItem::viewModeChanged,
+            this, &GLProgramExtentsItem::needsUpdate);
+}
+
+void GLProgramExtentsItem::paint(GLView *glView)
+{
+    const float lineEnding = m_textSize / 2.0;
+    const float lineOffset = m_textSize;
+    const float textOffset = m_textSize / 4.0;
+    bool xAxisVisible = true;
+    bool yAxisVisible = true;
+    bool zAxisVisible = true;
+    float xAxisRotation = 0.0;
+    float yAxisRotation = 0.0;
+    float zAxisRotation = 0.0;
+    QVector3D xAxisOffset(0.0, 0.0, 0.0);
+    QVector3D yAxisOffset(0.0, 0.0, 0.0);
+    QVector3D zAxisOffset(0.0, 0.0, 0.0);
+
+    if (m_viewMode == QLatin1String("Top"))
+    {
+        zAxisVisible = false;
+        xAxisOffset = QVector3D(m_minimum.x(), m_minimum.y() - lineOffset, m_minimum.z());
+        yAxisOffset = QVector3D(m_minimum.x() - lineOffset, m_minimum.y(), m_minimum.z());
+    }
+    else if (m_viewMode == QLatin1String("RotatedTop"))
+    {
+        zAxisVisible = false;
+        yAxisRotation = 180.0;
+        xAxisOffset = QVector3D(m_minimum.x(), m_minimum.y() - lineOffset, m_minimum.z());
+        yAxisOffset = QVector3D(m_maximum.x() + lineOffset, m_minimum.y(), m_minimum.z());
+    }
+    else if (m_viewMode == QLatin1String("Front"))
+    {
+        yAxisVisible = false;
+        xAxisRotation = 90.0;
+        xAxisOffset = QVector3D(m_minimum.x(), 0.0, m_minimum.z() - lineOffset);
+        zAxisOffset = QVector3D(m_minimum.x() - lineOffset, m_minimum.y() - lineOffset, m_minimum.z());
+    }
+    else if (m_viewMode == QLatin1String("Side"))
+    {
+        yAxisRotation = -90.0;
+        zAxisRotation = 90.0;
+        yAxisOffset = QVector3D(0.0, m_minimum.y(), m_minimum.z() - lineOffset);
+        zAxisOffset = QVector3D(m_minimum.x() - lineOffset, m_minimum.y() - lineOffset, m_minimum.z());
+    }
+    else if (m_viewMode == QLatin1String("Perspective"))
+    {
+        xAxisOffset = QVector3D(m_minimum.x(), m_minimum.y() - lineOffset, m_minimum.z());
+        yAxisOffset = QVector3D(m_minimum.x() - lineOffset, m_minimum.y(), m_minimum.z());
+        zAxisOffset = QVector3D(m_minimum.x() - lineOffset, m_minimum.y() - lineOffset, m_minimum.z());
+    }
+
+    glView->prepare(this);
+    glView->reset();
+
+    if (!m_valid)
+    {
+        return;
+    }
+
+    glView->color(m_color);
+    glView->lineWidth(m_lineWidth);
+    glView->beginUnion();
+
+    if (xAxisVisible)
+    {
+        glView->translate(xAxisOffset);
+        glView->rotate(xAxisRotation, 1.0, 0.0, 0.0);
+        glView->beginUnion();
+        glView->translate(0.0, lineEnding / 2.0, 0.0);
+        glView->line(0.0, -lineEnding, 0.0);
+        glView->line(m_size.x(), 0.0, 0.0);
+        glView->translate(m_size.x(), lineEnding / 2.0, 0.0);
+        glView->line(0.0, -lineEnding, 0.0);
+
+        glView->translate(m_size.x() / 2.0, -textOffset - m_textSize, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->text(format(m_size.x()), GLView::AlignCenter);
+
+        if (m_limitMaximum.x() < m_maximum.x())
+        {
+            glView->color(m_limitColor);
+        }
+        glView->translate(m_size.x() + m_textSize / 2.0, -textOffset - lineEnding / 2.0, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->rotate(90.0, 0.0, 0.0, 1.0);
+        glView->text(format(m_minimum.x() + m_size.x()), GLView::AlignRight);
+
+        if (m_limitMinimum.x() > m_minimum.x())
+        {
+            glView->color(m_limitColor);
+        }
+        glView->translate(m_textSize / 2.0, -textOffset - lineEnding / 2.0, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->rotate(90.0, 0.0, 0.0, 1.0);
+        glView->text(format(m_minimum.x()), GLView::AlignRight);
+        glView->endUnion();
+    }
+
+    if ((m_axes > 1) && yAxisVisible)
+    {
+        glView->translate(yAxisOffset);
+        glView->rotate(yAxisRotation, 0.0, 1.0, 0.0);
+        glView->rotate(90.0, 0.0, 0.0, 1.0);
+        glView->beginUnion();
+        glView->translate(0.0, lineEnding / 2.0, 0.0);
+        glView->line(0.0, -lineEnding, 0.0);
+        glView->line(m_size.y(), 0.0, 0.0);
+        glView->translate(m_size.y(), lineEnding / 2.0, 0.0);
+        glView->line(0.0, -lineEnding, 0.0);
+
+        glView->translate(m_size.y() / 2.0, textOffset, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->text(format(m_size.y()), GLView::AlignCenter);
+
+        if (m_limitMaximum.y() < m_maximum.y())
+        {
+            glView->color(m_limitColor);
+        }
+        glView->translate(m_size.y() - m_textSize / 2.0, textOffset + lineEnding / 2.0, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->rotate(-90.0, 0.0, 0.0, 1.0);
+        glView->text(format(m_minimum.y() + m_size.y()), GLView::AlignRight);
+
+        if (m_limitMinimum.y() > m_minimum.y())
+        {
+            glView->color(m_limitColor);
+        }
+        glView->translate(-m_textSize / 2.0, textOffset + lineEnding / 2.0, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->rotate(-90.0, 0.0, 0.0, 1.0);
+        glView->text(format(m_minimum.y()), GLView::AlignRight);
+        glView->endUnion();
+    }
+
+    if ((m_axes > 2) && zAxisVisible)
+    {
+        glView->translate(zAxisOffset);
+        glView->rotate(zAxisRotation, 0.0, 0.0, 1.0);
+        glView->rotate(-90.0, 0.0, 1.0, 0.0);
+        glView->rotate(-90.0, 1.0, 0.0, 0.0);
+        glView->beginUnion();
+        glView->translate(0.0, lineEnding / 2.0, 0.0);
+        glView->line(0.0, -lineEnding, 0.0);
+        glView->line(m_size.z(), 0.0, 0.0);
+        glView->translate(m_size.z(), lineEnding / 2.0, 0.0);
+        glView->line(0.0, -lineEnding, 0.0);
+
+        glView->translate(m_size.z() / 2.0, -textOffset - m_textSize, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->text(format(m_size.z()), GLView::AlignCenter);
+
+        if (m_limitMaximum.z() < m_maximum.z())
+        {
+            glView->color(m_limitColor);
+        }
+        glView->translate(m_size.z() - m_textSize / 2.0, -textOffset - lineEnding / 2.0, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->rotate(-90.0, 0.0, 0.0, 1.0);
+        glView->text(format(m_minimum.z() + m_size.z()), GLView::AlignLeft);
+
+        if (m_limitMinimum.z() > m_minimum.z())
+        {
+            glView->color(m_limitColor);
+        }
+        glView->translate(-m_textSize / 2.0, -textOffset - lineEnding / 2.0, 0.0);
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->rotate(-90.0, 0.0, 0.0, 1.0);
+        glView->text(format(m_minimum.z()), GLView::AlignLeft);
+        glView->endUnion();
+    }
+
+    glView->endUnion();
+}
+
+void GLProgramExtentsItem::selectDrawable(void *pointer)
+{
+    Q_UNUSED(pointer)
+}
+
+void GLProgramExtentsItem::setMaximum(QVector3D arg)
+{
+    if (m_maximum != arg) {
+        m_maximum = arg;
+        emit maximumChanged(arg);
+        updateSize();
+    }
+}
+
+void GLProgramExtentsItem::setMinimum(QVector3D arg)
+{
+    if (m_minimum != arg) {
+        m_minimum = arg;
+        emit minimumChanged(arg);
+        updateSize();
+    }
+}
+
+void GLProgramExtentsItem::updateSize()
+{
+    const QVector3D size = m_maximum - m_minimum;
+    const QVector3D center = (m_minimum + m_maximum) * 0.5;
+    const bool valid = (m_minimum != m_maximum);
+
+    if (m_size != size) {
+        m_size = size;
+        emit sizeChanged(size);
+    }
+
+    if (m_center != center) {
+        m_center = center;
+        emit centerChanged(center);
+    }
+
+    if (m_valid != valid) {
+        m_valid = valid;
+        emit validChanged(valid);
+    }
+}
+
+QString GLProgramExtentsItem::format(float number) const
+{
+    return m_prefix + QString::number(number * m_scaleFactor, 'f', m_decimals) + m_suffix;
+}
+}; // namespace qtquickvcp
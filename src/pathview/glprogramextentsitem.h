@@ -0,0 +1,286 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#ifndef GLPROGRAMEXTENTSITEM_H
+#define GLPROGRAMEXTENTSITEM_H
+
+#include "glitem.h"
+
+namespace qtquickvcp {
+
+class GLProgramExtentsItem : public GLItem
+{
+    Q_OBJECT
+    Q_PROPERTY(int axes READ axes WRITE setAxes NOTIFY axesChanged)
+    Q_PROPERTY(QVector3D maximum READ maximum WRITE setMaximum NOTIFY maximumChanged)
+    Q_PROPERTY(QVector3D minimum READ minimum WRITE setMinimum NOTIFY minimumChanged)
+    Q_PROPERTY(QVector3D size READ size NOTIFY sizeChanged)
+    Q_PROPERTY(QVector3D center READ center NOTIFY centerChanged)
+    Q_PROPERTY(bool valid READ isValid NOTIFY validChanged)
+    Q_PROPERTY(QVector3D limitMaximum READ limitMaximum WRITE setLimitMaximum NOTIFY limitMaximumChanged)
+    Q_PROPERTY(QVector3D limitMinimum READ limitMinimum WRITE setLimitMinimum NOTIFY limitMinimumChanged)
+    Q_PROPERTY(float lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor limitColor READ limitColor WRITE setLimitColor NOTIFY limitColorChanged)
+    Q_PROPERTY(float textSize READ textSize WRITE setTextSize NOTIFY textSizeChanged)
+    Q_PROPERTY(QString prefix READ prefix WRITE setPrefix NOTIFY prefixChanged)
+    Q_PROPERTY(QString suffix READ suffix WRITE setSuffix NOTIFY suffixChanged)
+    Q_PROPERTY(int decimals READ decimals WRITE setDecimals NOTIFY decimalsChanged)
+    Q_PROPERTY(float scaleFactor READ scaleFactor WRITE setScaleFactor NOTIFY scaleFactorChanged)
+    Q_PROPERTY(QString viewMode READ viewMode WRITE setViewMode NOTIFY viewModeChanged)
+
+public:
+    explicit GLProgramExtentsItem(QQuickItem *parent = 0);
+
+    virtual void paint(GLView *glView);
+
+    int axes() const
+    {
+        return m_axes;
+    }
+
+    QVector3D maximum() const
+    {
+        return m_maximum;
+    }
+
+    QVector3D minimum() const
+    {
+        return m_minimum;
+    }
+
+    QVector3D size() const
+    {
+        return m_size;
+    }
+
+    QVector3D center() const
+    {
+        return m_center;
+    }
+
+    bool isValid() const
+    {
+        return m_valid;
+    }
+
+    QVector3D limitMaximum() const
+    {
+        return m_limitMaximum;
+    }
+
+    QVector3D limitMinimum() const
+    {
+        return m_limitMinimum;
+    }
+
+    float lineWidth() const
+    {
+        return m_lineWidth;
+    }
+
+    QColor color() const
+    {
+        return m_color;
+    }
+
+    QColor limitColor() const
+    {
+        return m_limitColor;
+    }
+
+    float textSize() const
+    {
+        return m_textSize;
+    }
+
+    QString prefix() const
+    {
+        return m_prefix;
+    }
+
+    QString suffix() const
+    {
+        return m_suffix;
+    }
+
+    int decimals() const
+    {
+        return m_decimals;
+    }
+
+    float scaleFactor() const
+    {
+        return m_scaleFactor;
+    }
+
+    QString viewMode() const
+    {
+        return m_viewMode;
+    }
+
+signals:
+    void axesChanged(int arg);
+    void maximumChanged(QVector3D arg);
+    void minimumChanged(QVector3D arg);
+    void sizeChanged(QVector3D arg);
+    void centerChanged(QVector3D arg);
+    void validChanged(bool arg);
+    void limitMaximumChanged(QVector3D arg);
+    void limitMinimumChanged(QVector3D arg);
+    void lineWidthChanged(float arg);
+    void colorChanged(QColor arg);
+    void limitColorChanged(QColor arg);
+    void textSizeChanged(float arg);
+    void prefixChanged(QString arg);
+    void suffixChanged(QString arg);
+    void decimalsChanged(int arg);
+    void scaleFactorChanged(float arg);
+    void viewModeChanged(QString arg);
+
+public slots:
+    virtual void selectDrawable(void *pointer);
+
+    void setMaximum(QVector3D arg);
+    void setMinimum(QVector3D arg);
+
+    void setAxes(int arg)
+    {
+        if (m_axes != arg) {
+            m_axes = arg;
+            emit axesChanged(arg);
+        }
+    }
+
+    void setLimitMaximum(QVector3D arg)
+    {
+        if (m_limitMaximum != arg) {
+            m_limitMaximum = arg;
+            emit limitMaximumChanged(arg);
+        }
+    }
+
+    void setLimitMinimum(QVector3D arg)
+    {
+        if (m_limitMinimum != arg) {
+            m_limitMinimum = arg;
+            emit limitMinimumChanged(arg);
+        }
+    }
+
+    void setLineWidth(float arg)
+    {
+        if (m_lineWidth != arg) {
+            m_lineWidth = arg;
+            emit lineWidthChanged(arg);
+        }
+    }
+
+    void setColor(QColor arg)
+    {
+        if (m_color != arg) {
+            m_color = arg;
+            emit colorChanged(arg);
+        }
+    }
+
+    void setLimitColor(QColor arg)
+    {
+        if (m_limitColor != arg) {
+            m_limitColor = arg;
+            emit limitColorChanged(arg);
+        }
+    }
+
+    void setTextSize(float arg)
+    {
+        if (m_textSize != arg) {
+            m_textSize = arg;
+            emit textSizeChanged(arg);
+        }
+    }
+
+    void setPrefix(QString arg)
+    {
+        if (m_prefix != arg) {
+            m_prefix = arg;
+            emit prefixChanged(arg);
+        }
+    }
+
+    void setSuffix(QString arg)
+    {
+        if (m_suffix != arg) {
+            m_suffix = arg;
+            emit suffixChanged(arg);
+        }
+    }
+
+    void setDecimals(int arg)
+    {
+        if (m_decimals != arg) {
+            m_decimals = arg;
+            emit decimalsChanged(arg);
+        }
+    }
+
+    void setScaleFactor(float arg)
+    {
+        if (m_scaleFactor != arg) {
+            m_scaleFactor = arg;
+            emit scaleFactorChanged(arg);
+        }
+    }
+
+    void setViewMode(QString arg)
+    {
+        if (m_viewMode != arg) {
+            m_viewMode = arg;
+            emit viewModeChanged(arg);
+        }
+    }
+
+private:
+    int m_axes;
+    QVector3D m_maximum;
+    QVector3D m_minimum;
+    QVector3D m_size;
+    QVector3D m_center;
+    bool m_valid;
+    QVector3D m_limitMaximum;
+    QVector3D m_limitMinimum;
+    float m_lineWidth;
+    QColor m_color;
+    QColor m_limitColor;
+    float m_textSize;
+    QString m_prefix;
+    QString m_suffix;
+    int m_decimals;
+    float m_scaleFactor;
+    QString m_viewMode;
+
+    void updateSize();
+    QString format(float number) const;
+}; // class GLProgramExtentsItem
+} // namespace qtquickvcp
+
+#endif // GLPROGRAMEXTENTSITEM_H
@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#include "glprogramoffsetsitem.h"
+
+namespace qtquickvcp {
+
+/** Labeled lines from the machine origin to the active G5x and G92 offsets
+ *
+ *  The offsets are value types, the lines are only generated again when an
+ *  offset really changed and not on every update of the status.
+ **/
+GLProgramOffsetsItem::GLProgramOffsetsItem(QQuickItem *parent) :
+    GLItem(parent),
+    m_textSize(14.0),
+    m_color(QColor(Qt::cyan)),
+    m_lineWidth(2.0),
+    m_g5xNames(QStringList() << "G54" << "G55" << "G56" << "G57" << "G58" << "G59" << "G59.1" << "G59.2" << "G59.3"),
+    m_g5xIndex(1),
+    m_g5xOffset(QVector3D(0.0, 0.0, 0.0)),
+    m_g92Offset(QVector3D(0.0, 0.0, 0.0)),
+    m_viewMode(QString("Perspective"))
+{
+    connect(this, &GLProgramOffsetsItem::textSizeChanged,
+            this, &GLProgramOffsetsItem::needsUpdate);
+    connect(this, &GLProgramOffsetsItem::colorChanged,
+            this, &GLProgramOffsetsItem::needsUpdate);
+    connect(this, &GLProgramOffsetsItem::lineWidthChanged,
+            this, &GLProgramOffsetsItem::needsUpdate);
+    connect(this, &GLProgramOffsetsItem::g5xNamesChanged,
+            this, &GLProgramOffsetsItem::needsUpdate);
+    connect(this, &GLProgramOffsetsItem::g5xIndexChanged,
+            this, &GLProgramOffsetsItem::needsUpdate);
+    connect(this, &GLProgramOffsetsItem::g5xOffsetChanged,
+            this, &GLProgramOffsetsItem::needsUpdate);
+    connect(this, &GLProgramOffsetsItem::g92OffsetChanged,
+            this, &GLProgramOffsetsItem::needsUpdate);
+    connect(this, &GLProgramOffsetsItem::viewModeChanged,
+            this, &GLProgramOffsetsItem::needsUpdate);
+}
+
+void GLProgramOffsetsItem::paint(GLView *glView)
+{
+    const bool textRotated = (m_viewMode == QLatin1String("Top")) || (m_viewMode == QLatin1String("RotatedTop"));
+
+    glView->prepare(this);
+    glView->reset();
+
+    glView->color(m_color);
+    glView->lineWidth(m_lineWidth);
+    glView->beginUnion();
+
+    if (!m_g5xOffset.isNull())
+    {
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        if (!textRotated)
+        {
+            glView->rotate(90.0, 1.0, 0.0, 0.0);
+        }
+        glView->text(m_g5xNames.value(m_g5xIndex - 1),
+                     (m_g5xOffset.x() < 0.0) ? GLView::AlignRight : GLView::AlignLeft);
+
+        glView->lineFromTo(QVector3D(0.0, 0.0, 0.0), m_g5xOffset);
+    }
+
+    if (!m_g92Offset.isNull())
+    {
+        glView->translate(m_g5xOffset);
+
+        glView->beginUnion();
+        if (!textRotated)
+        {
+            glView->rotate(90.0, 1.0, 0.0, 0.0);
+        }
+        glView->scale(m_textSize, m_textSize, m_textSize);
+        glView->text(QStringLiteral("G92"),
+                     (m_g92Offset.x() < 0.0) ? GLView::AlignRight : GLView::AlignLeft);
+
+        glView->lineTo(m_g92Offset);
+        glView->endUnion();
+    }
+
+    glView->endUnion();
+}
+
+void GLProgramOffsetsItem::selectDrawable(void *pointer)
+{
+    Q_UNUSED(pointer)
+}
+}; // namespace qtquickvcp
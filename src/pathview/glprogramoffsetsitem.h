@@ -0,0 +1,177 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+
+#ifndef GLPROGRAMOFFSETSITEM_H
+#define GLPROGRAMOFFSETSITEM_H
+
+#include <QStringList>
+#include "glitem.h"
+
+namespace qtquickvcp {
+
+class GLProgramOffsetsItem : public GLItem
+{
+    Q_OBJECT
+    Q_PROPERTY(float textSize READ textSize WRITE setTextSize NOTIFY textSizeChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(float lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(QStringList g5xNames READ g5xNames WRITE setG5xNames NOTIFY g5xNamesChanged)
+    Q_PROPERTY(int g5xIndex READ g5xIndex WRITE setG5xIndex NOTIFY g5xIndexChanged)
+    Q_PROPERTY(QVector3D g5xOffset READ g5xOffset WRITE setG5xOffset NOTIFY g5xOffsetChanged)
+    Q_PROPERTY(QVector3D g92Offset READ g92Offset WRITE setG92Offset NOTIFY g92OffsetChanged)
+    Q_PROPERTY(QString viewMode READ viewMode WRITE setViewMode NOTIFY viewModeChanged)
+
+public:
+    explicit GLProgramOffsetsItem(QQuickItem *parent = 0);
+
+    virtual void paint(GLView *glView);
+
+    float textSize() const
+    {
+        return m_textSize;
+    }
+
+    QColor color() const
+    {
+        return m_color;
+    }
+
+    float lineWidth() const
+    {
+        return m_lineWidth;
+    }
+
+    QStringList g5xNames() const
+    {
+        return m_g5xNames;
+    }
+
+    int g5xIndex() const
+    {
+        return m_g5xIndex;
+    }
+
+    QVector3D g5xOffset() const
+    {
+        return m_g5xOffset;
+    }
+
+    QVector3D g92Offset() const
+    {
+        return m_g92Offset;
+    }
+
+    QString viewMode() const
+    {
+        return m_viewMode;
+    }
+
+signals:
+    void textSizeChanged(float arg);
+    void colorChanged(QColor arg);
+    void lineWidthChanged(float arg);
+    void g5xNamesChanged(QStringList arg);
+    void g5xIndexChanged(int arg);
+    void g5xOffsetChanged(QVector3D arg);
+    void g92OffsetChanged(QVector3D arg);
+    void viewModeChanged(QString arg);
+
+public slots:
+    virtual void selectDrawable(void *pointer);
+
+    void setTextSize(float arg)
+    {
+        if (m_textSize != arg) {
+            m_textSize = arg;
+            emit textSizeChanged(arg);
+        }
+    }
+
+    void setColor(QColor arg)
+    {
+        if (m_color != arg) {
+            m_color = arg;
+            emit colorChanged(arg);
+        }
+    }
+
+    void setLineWidth(float arg)
+    {
+        if (m_lineWidth != arg) {
+            m_lineWidth = arg;
+            emit lineWidthChanged(arg);
+        }
+    }
+
+    void setG5xNames(QStringList arg)
+    {
+        if (m_g5xNames != arg) {
+            m_g5xNames = arg;
+            emit g5xNamesChanged(arg);
+        }
+    }
+
+    void setG5xIndex(int arg)
+    {
+        if (m_g5xIndex != arg) {
+            m_g5xIndex = arg;
+            emit g5xIndexChanged(arg);
+        }
+    }
+
+    void setG5xOffset(QVector3D arg)
+    {
+        if (m_g5xOffset != arg) {
+            m_g5xOffset = arg;
+            emit g5xOffsetChanged(arg);
+        }
+    }
+
+    void setG92Offset(QVector3D arg)
+    {
+        if (m_g92Offset != arg) {
+            m_g92Offset = arg;
+            emit g92OffsetChanged(arg);
+        }
+    }
+
+    void setViewMode(QString arg)
+    {
+        if (m_viewMode != arg) {
+            m_viewMode = arg;
+            emit viewModeChanged(arg);
+        }
+    }
+
+private:
+    float m_textSize;
+    QColor m_color;
+    float m_lineWidth;
+    QStringList m_g5xNames;
+    int m_g5xIndex;
+    QVector3D m_g5xOffset;
+    QVector3D m_g92Offset;
+    QString m_viewMode;
+}; // class GLProgramOffsetsItem
+} // namespace qtquickvcp
+
+#endif // GLPROGRAMOFFSETSITEM_H
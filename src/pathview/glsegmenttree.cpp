@@ -0,0 +1,292 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include "glsegmenttree.h"
+#include <algorithm>
+
+namespace qtquickvcp {
+
+static const int MaxSegmentsPerLeaf = 8;
+static const float MinimumW = 1e-6f;
+
+/** Bounding volume hierarchy over line segments in world space
+ *
+ *  The tree does not copy the vertex data, the positions passed to
+ *  pick must be the same as the ones the tree was built with. Segment i
+ *  is formed by the vertices 2i and 2i+1 like in a GL_LINES buffer.
+ **/
+GLSegmentTree::GLSegmentTree()
+{
+}
+
+void GLSegmentTree::build(const float *positions, int stride, int segmentCount)
+{
+    clear();
+    append(positions, stride, 0, segmentCount);
+}
+
+/** Adds the segments following the ones already in the tree
+ *
+ *  The new segments get a tree of their own, so appending does not touch the
+ *  existing nodes. The positions must contain all segments up to the new ones.
+ **/
+void GLSegmentTree::append(const float *positions, int stride, int firstSegment, int segmentCount)
+{
+    QVector<QVector3D> centers;
+
+    if (segmentCount <= 0)
+    {
+        return;
+    }
+
+    const int first = m_segments.size();
+    centers.reserve(segmentCount);
+    m_segments.reserve(first + segmentCount);
+    for (int i = firstSegment; i < (firstSegment + segmentCount); ++i)
+    {
+        centers.append((position(positions, stride, 2 * i) + position(positions, stride, 2 * i + 1)) / 2.0f);
+        m_segments.append(i);
+    }
+
+    m_nodes.reserve(m_nodes.size() + 2 * (segmentCount / MaxSegmentsPerLeaf + 1));
+    m_roots.append(buildNode(positions, stride, centers, firstSegment, first, segmentCount));
+}
+
+void GLSegmentTree::clear()
+{
+    m_nodes.clear();
+    m_segments.clear();
+    m_roots.clear();
+}
+
+/** Returns the segment closest to the viewer within radius pixels of point */
+bool GLSegmentTree::pick(const QMatrix4x4 &viewProjectionMatrix, const QSizeF &viewportSize,
+                         const QPointF &point, float radius,
+                         const float *positions, int stride,
+                         int *segment, float *depth) const
+{
+    QVector<int> stack;
+    const QVector2D target(point);
+    bool found = false;
+
+    if (m_nodes.isEmpty())
+    {
+        return false;
+    }
+
+    stack = m_roots;
+    while (!stack.isEmpty())
+    {
+        const int nodeIndex = stack.takeLast();
+        const Node &node = m_nodes.at(nodeIndex);
+
+        if (!nodeVisible(node, viewProjectionMatrix, viewportSize, point, radius))
+        {
+            continue;
+        }
+
+        if (node.count == 0)
+        {
+            stack.append(node.right);
+            stack.append(nodeIndex + 1);
+            continue;
+        }
+
+        for (int i = node.first; i < (node.first + node.count); ++i)
+        {
+            const int index = m_segments.at(i);
+            QVector4D clip0 = viewProjectionMatrix * QVector4D(position(positions, stride, 2 * index), 1.0f);
+            QVector4D clip1 = viewProjectionMatrix * QVector4D(position(positions, stride, 2 * index + 1), 1.0f);
+            QVector3D screen0;
+            QVector3D screen1;
+
+            // clip the segment at the camera plane
+            if ((clip0.w() < MinimumW) && (clip1.w() < MinimumW)) {
+                continue;
+            }
+            else if (clip0.w() < MinimumW) {
+                clip0 += (clip1 - clip0) * ((MinimumW - clip0.w()) / (clip1.w() - clip0.w()));
+            }
+            else if (clip1.w() < MinimumW) {
+                clip1 += (clip0 - clip1) * ((MinimumW - clip1.w()) / (clip0.w() - clip1.w()));
+            }
+
+            toScreen(clip0, viewportSize, &screen0);
+            toScreen(clip1, viewportSize, &screen1);
+
+            // closest point of the segment in screen space, depth is linear in screen space
+            const QVector2D start = screen0.toVector2D();
+            const QVector2D direction = screen1.toVector2D() - start;
+            const float lengthSquared = direction.lengthSquared();
+            float t = 0.0f;
+            if (lengthSquared > 0.0f) {
+                t = qBound(0.0f, QVector2D::dotProduct(target - start, direction) / lengthSquared, 1.0f);
+            }
+
+            if ((start + direction * t).distanceToPoint(target) > radius) {
+                continue;
+            }
+
+            const float segmentDepth = screen0.z() + (screen1.z() - screen0.z()) * t;
+            if ((segmentDepth < -1.0f) || (segmentDepth > 1.0f)) {
+                continue;   // clipped by the near or far plane
+            }
+
+            if (!found || (segmentDepth < *depth))
+            {
+                *segment = index;
+                *depth = segmentDepth;
+                found = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+int GLSegmentTree::buildNode(const float *positions, int stride, const QVector<QVector3D> &centers, int centerOffset,
+                             int first, int count)
+{
+    const int nodeIndex = m_nodes.size();
+    Node node;
+    QVector3D centerMinimum;
+    QVector3D centerMaximum;
+
+    for (int i = first; i < (first + count); ++i)
+    {
+        const int index = m_segments.at(i);
+        const QVector3D start = position(positions, stride, 2 * index);
+        const QVector3D end = position(positions, stride, 2 * index + 1);
+        const QVector3D &center = centers.at(index - centerOffset);
+
+        if (i == first)
+        {
+            node.minimum = start;
+            node.maximum = start;
+            centerMinimum = center;
+            centerMaximum = center;
+        }
+
+        for (int k = 0; k < 3; ++k)
+        {
+            node.minimum[k] = qMin(node.minimum[k], qMin(start[k], end[k]));
+            node.maximum[k] = qMax(node.maximum[k], qMax(start[k], end[k]));
+            centerMinimum[k] = qMin(centerMinimum[k], center[k]);
+            centerMaximum[k] = qMax(centerMaximum[k], center[k]);
+        }
+    }
+
+    node.first = first;
+    node.count = count;
+    node.right = -1;
+    m_nodes.append(node);
+
+    if (count <= MaxSegmentsPerLeaf)
+    {
+        return nodeIndex;
+    }
+
+    // median split along the longest axis of the segment centers
+    const QVector3D extent = centerMaximum - centerMinimum;
+    int axis = 0;
+    if (extent.y() > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z() > extent[axis]) {
+        axis = 2;
+    }
+
+    const int half = count / 2;
+    int *begin = m_segments.data() + first;
+    std::nth_element(begin, begin + half, begin + count, [&centers, centerOffset, axis](int a, int b) {
+        return centers.at(a - centerOffset)[axis] < centers.at(b - centerOffset)[axis];
+    });
+
+    buildNode(positions, stride, centers, centerOffset, first, half);
+    const int right = buildNode(positions, stride, centers, centerOffset, first + half, count - half);
+
+    m_nodes[nodeIndex].count = 0;
+    m_nodes[nodeIndex].right = right;
+
+    return nodeIndex;
+}
+
+/** Tests if the projected bounding box of the node is within radius of point */
+bool GLSegmentTree::nodeVisible(const Node &node, const QMatrix4x4 &viewProjectionMatrix, const QSizeF &viewportSize,
+                                const QPointF &point, float radius) const
+{
+    QVector3D minimum;
+    QVector3D maximum;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const QVector3D corner((i & 1) ? node.maximum.x() : node.minimum.x(),
+                               (i & 2) ? node.maximum.y() : node.minimum.y(),
+                               (i & 4) ? node.maximum.z() : node.minimum.z());
+        QVector3D screen;
+
+        if (!toScreen(viewProjectionMatrix * QVector4D(corner, 1.0f), viewportSize, &screen))
+        {
+            return true;    // the box intersects the camera plane
+        }
+
+        if (i == 0)
+        {
+            minimum = screen;
+            maximum = screen;
+        }
+        else
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                minimum[k] = qMin(minimum[k], screen[k]);
+                maximum[k] = qMax(maximum[k], screen[k]);
+            }
+        }
+    }
+
+    return (point.x() >= (minimum.x() - radius)) && (point.x() <= (maximum.x() + radius))
+            && (point.y() >= (minimum.y() - radius)) && (point.y() <= (maximum.y() + radius))
+            && (maximum.z() >= -1.0f) && (minimum.z() <= 1.0f);
+}
+
+QVector3D GLSegmentTree::position(const float *positions, int stride, int vertex)
+{
+    const float *data = reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + vertex * stride);
+    return QVector3D(data[0], data[1], data[2]);
+}
+
+/** Converts clip coordinates to pixel coordinates with the normalized depth as z */
+bool GLSegmentTree::toScreen(const QVector4D &clip, const QSizeF &viewportSize, QVector3D *screen)
+{
+    if (clip.w() < MinimumW)
+    {
+        return false;
+    }
+
+    const QVector3D ndc = clip.toVector3D() / clip.w();
+    screen->setX((ndc.x() + 1.0f) * 0.5f * viewportSize.width());
+    screen->setY((1.0f - ndc.y()) * 0.5f * viewportSize.height());
+    screen->setZ(ndc.z());
+
+    return true;
+}
+}; // namespace qtquickvcp
@@ -0,0 +1,76 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#ifndef GLSEGMENTTREE_H
+#define GLSEGMENTTREE_H
+
+#include <QVector>
+#include <QVector2D>
+#include <QVector3D>
+#include <QVector4D>
+#include <QMatrix4x4>
+#include <QPointF>
+#include <QSizeF>
+
+namespace qtquickvcp {
+
+class GLSegmentTree
+{
+public:
+    GLSegmentTree();
+
+    void build(const float *positions, int stride, int segmentCount);
+    void append(const float *positions, int stride, int firstSegment, int segmentCount);
+    void clear();
+    bool isEmpty() const
+    {
+        return m_nodes.isEmpty();
+    }
+
+    bool pick(const QMatrix4x4 &viewProjectionMatrix, const QSizeF &viewportSize,
+              const QPointF &point, float radius,
+              const float *positions, int stride,
+              int *segment, float *depth) const;
+
+private:
+    struct Node {
+        QVector3D minimum;
+        QVector3D maximum;
+        int first;      // first index of a leaf
+        int count;      // number of segments of a leaf, 0 for inner nodes
+        int right;      // index of the right child of an inner node, the left child follows the node
+    };
+
+    QVector<Node> m_nodes;
+    QVector<int> m_segments;    // segment indices ordered by the leafs
+    QVector<int> m_roots;       // one tree for every appended range of segments
+
+    int buildNode(const float *positions, int stride, const QVector<QVector3D> &centers, int centerOffset,
+                  int first, int count);
+    bool nodeVisible(const Node &node, const QMatrix4x4 &viewProjectionMatrix, const QSizeF &viewportSize,
+                     const QPointF &point, float radius) const;
+
+    static QVector3D position(const float *positions, int stride, int vertex);
+    static bool toScreen(const QVector4D &clip, const QSizeF &viewportSize, QVector3D *screen);
+}; // class GLSegmentTree
+} // namespace qtquickvcp
+
+#endif // GLSEGMENTTREE_H
@@ -27,6 +27,10 @@
 #include <QtGui/QOpenGLContext>
 #include <QtCore/qmath.h>
 #include <QDateTime>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cstddef>
+#include <cstring>
+#include <utility>
 
 const float PI_F = 3.14159265358979f;
 
@@ -35,13 +39,21 @@ namespace qtquickvcp {
 GLView::GLView(QQuickItem *parent)
     : QQuickPaintedItem(parent)
     , m_initialized(false)
+    , m_busy(false)
     , m_modelProgram(0)
     , m_lineProgram(0)
     , m_textProgram(0)
+    , m_instancingSupported(false)
+    , m_drawArraysInstanced(nullptr)
+    , m_vertexAttribDivisor(nullptr)
     , m_projectionAspectRatio(1.0)
+    , m_textDerivativesSupported(false)
     , m_backgroundColor(QColor(Qt::black))
     , m_pathEnabled(false)
-    , m_selectionModeActive(false)
+    , m_glyphTexture(nullptr)
+    , m_glyphTextureRevision(-1)
+    , m_textVerticesDirty(false)
+    , m_textVertexCount(0)
     , m_currentGlItem(nullptr)
     , m_propertySignalMapper(new QSignalMapper(this))
     , m_camera(new QGLCamera(this))
@@ -67,6 +79,11 @@ GLView::~GLView()
 {
     clearDrawables();
     qDeleteAll(m_drawableMap);
+    qDeleteAll(m_lineBatchMap);
+    qDeleteAll(m_releasedLineBatches);
+    qDeleteAll(m_trailMap);
+    qDeleteAll(m_releasedTrails);
+    qDeleteAll(m_modelInstancesMap);
 }
 
 void GLView::setBackgroundColor(const QColor &t)
@@ -78,10 +95,14 @@ void GLView::setBackgroundColor(const QColor &t)
     update();
 }
 
+/** Selects the drawable at the item coordinates x and y, emits drawableSelected
+ *
+ *  The line batches are owned by the render thread, therefore the pick is
+ *  resolved in sync while the GUI thread is blocked.
+ **/
 void GLView::readPixel(int x, int y)
 {
-    m_selectionPoint = QPoint(x, window()->height() - y);
-    m_selectionModeActive = true;
+    m_pickPoints.append(QPointF(x, y));
     update();
 }
 
@@ -223,8 +244,10 @@ GLView::Parameters* GLView::addDrawableData(const GLView::LineParameters &parame
     // add parameter
     QList<Parameters*> *parametersList = m_drawableMap.value(Line);
     LineParameters *lineParameters = new LineParameters(parameters);
+    lineParameters->type = Line;
     lineParameters->creator = m_currentGlItem;
     parametersList->append(lineParameters);
+    addToLineBatch(m_currentGlItem, lineParameters);
 
     // add drawable to list
     Drawable drawable;
@@ -239,8 +262,10 @@ GLView::Parameters* GLView::addDrawableData(const GLView::TextParameters &parame
 {
     QList<Parameters*> *parametersList = m_drawableMap.value(Text);
     TextParameters *textParameters = new TextParameters(parameters);
+    textParameters->type = Text;
     textParameters->creator = m_currentGlItem;
     parametersList->append(textParameters);
+    m_textVerticesDirty = true;
 
     Drawable drawable;
     drawable.type = Text;
@@ -254,8 +279,10 @@ GLView::Parameters* GLView::addDrawableData(GLView::ModelType type, const GLView
 {
     QList<Parameters*> *parametersList = m_drawableMap.value(type);
     Parameters *modelParameters = new Parameters(parameters);
+    modelParameters->type = type;
     modelParameters->creator = m_currentGlItem;
     parametersList->append(modelParameters);
+    invalidateModelInstances(type);
 
     Drawable drawable;
     drawable.type = type;
@@ -321,6 +348,9 @@ void GLView::cleanupDrawables(ModelType type)
         if (parameters->deleteFlag)
         {
             delete parametersList->takeAt(i);
+            if (type == Text) {
+                m_textVerticesDirty = true;
+            }
         }
     }
 }
@@ -336,10 +366,14 @@ void GLView::removeDrawables(QList<GLView::Drawable> *drawableList)
         if (!types.contains(drawable.type)) {
             types.append(drawable.type);
         }
+        if (drawable.type == Line) {
+            invalidateLineBatch(drawable.parameters->creator);
+        }
     }
 
     for (int i = 0; i < types.size(); ++i) {
         cleanupDrawables(types.at(i));
+        invalidateModelInstances(types.at(i));
     }
 
     drawableList->clear();
@@ -372,47 +406,56 @@ void GLView::setupVBOs()
                   0.0, QVector3D(0,0,1),
                   16, Cone);
     setupSphere(16);
-    setupLineVertexBuffer();
     setupTextVertexBuffer();
+    addDrawableList(Line);  // line vertex buffers are created per GL item
 }
 
-void GLView::setupLineVertexBuffer()
+void GLView::setupInstancing()
 {
-    const int MaxLinesPerPath = 100;
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    const QPair<int, int> version = context->format().version();
+    QByteArray suffix;
 
-    m_lineVertexBuffer = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
-    m_lineVertexBuffer->create();
-    m_lineVertexBuffer->setUsagePattern(QOpenGLBuffer::StaticDraw);
-    m_lineVertexBuffer->bind();
-    m_lineVertexBuffer->allocate(MaxLinesPerPath*sizeof(GLvector3D));
-    m_lineVertexBuffer->release();
+    m_instancingSupported = false;
 
-    addDrawableList(Line);
+    if (context->isOpenGLES())
+    {
+        if (version.first >= 3) {
+            suffix = "";
+        }
+        else if (context->hasExtension("GL_EXT_instanced_arrays")) {
+            suffix = "EXT";
+        }
+        else if (context->hasExtension("GL_ANGLE_instanced_arrays")) {
+            suffix = "ANGLE";
+        }
+        else {
+            return; // fall back to one draw call per instance
+        }
+    }
+    else
+    {
+        if (version >= qMakePair(3, 3)) {
+            suffix = "";
+        }
+        else if (context->hasExtension("GL_ARB_instanced_arrays")) {
+            suffix = "ARB";
+        }
+        else {
+            return;
+        }
+    }
+
+    m_drawArraysInstanced = reinterpret_cast<DrawArraysInstancedFunction>(context->getProcAddress("glDrawArraysInstanced" + suffix));
+    m_vertexAttribDivisor = reinterpret_cast<VertexAttribDivisorFunction>(context->getProcAddress("glVertexAttribDivisor" + suffix));
+    m_instancingSupported = (m_drawArraysInstanced != nullptr) && (m_vertexAttribDivisor != nullptr);
 }
 
 void GLView::setupTextVertexBuffer()
 {
-    static const TextVertex vertices[] = {
-        {{0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
-        {{0.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
-        {{1.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-        {{0.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
-        {{1.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-        {{1.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-        {{1.0f, 1.0f, 0.0f}, {0.0f, 0.0f}},
-        {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
-        {{0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-        {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f}},
-        {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f}},
-        {{0.0f, 1.0f, 0.0f}, {1.0f, 0.0f}},
-    };
-
     m_textVertexBuffer = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
     m_textVertexBuffer->create();
-    m_textVertexBuffer->setUsagePattern(QOpenGLBuffer::StaticDraw);
-    m_textVertexBuffer->bind();
-    m_textVertexBuffer->allocate(vertices, sizeof(vertices));
-    m_textVertexBuffer->release();
+    m_textVertexBuffer->setUsagePattern(QOpenGLBuffer::DynamicDraw);
 
     addDrawableList(Text);
 }
@@ -484,17 +527,15 @@ void GLView::setupShaders()
 
     m_positionLocation = m_modelProgram->attributeLocation("position");
     m_normalLocation = m_modelProgram->attributeLocation("normal");
-    m_colorLocation = m_modelProgram->uniformLocation("color");
+    m_colorLocation = m_modelProgram->attributeLocation("color");
     m_lightPositionLocation = m_modelProgram->uniformLocation("light.position");
     m_lightIntensitiesLocation = m_modelProgram->uniformLocation("light.intensities");
     m_lightAttenuationLocation = m_modelProgram->uniformLocation("light.attenuation");
     m_lightAmbientCoefficientLocation = m_modelProgram->uniformLocation("light.ambientCoefficient");
     m_lightEnabledLocation = m_modelProgram->uniformLocation("light.enabled");
-    m_modelMatrixLocation = m_modelProgram->uniformLocation("modelMatrix");
+    m_modelMatrixLocation = m_modelProgram->attributeLocation("modelMatrix");
     m_viewMatrixLocation = m_modelProgram->uniformLocation("viewMatrix");
     m_projectionMatrixLocation = m_modelProgram->uniformLocation("projectionMatrix");
-    m_idColorLocation = m_modelProgram->uniformLocation("idColor");
-    m_selectionModeLocation = m_modelProgram->uniformLocation("selectionMode");
 
     // line shader
     m_lineProgram = new QOpenGLShaderProgram();
@@ -503,14 +544,13 @@ void GLView::setupShaders()
     m_lineProgram->link();
 
     m_linePositionLocation = m_lineProgram->attributeLocation("position");
+    m_lineColorLocation = m_lineProgram->attributeLocation("color");
+    m_lineStippleOriginLocation = m_lineProgram->attributeLocation("stippleOrigin");
+    m_lineStippleLengthLocation = m_lineProgram->attributeLocation("stippleLength");
+    m_lineStateLocation = m_lineProgram->attributeLocation("state");
+    m_linePaletteLocation = m_lineProgram->uniformLocation("palette");
     m_lineProjectionMatrixLocation = m_lineProgram->uniformLocation("projectionMatrix");
     m_lineViewMatrixLocation = m_lineProgram->uniformLocation("viewMatrix");
-    m_lineModelMatrixLocation = m_lineProgram->uniformLocation("modelMatrix");
-    m_lineColorLocation = m_lineProgram->uniformLocation("color");
-    m_lineStippleLocation = m_lineProgram->uniformLocation("stipple");
-    m_lineStippleLengthLocation = m_lineProgram->uniformLocation("stippleLength");
-    m_lineIdColorLocation = m_lineProgram->uniformLocation("idColor");
-    m_lineSelectionModeLocation = m_lineProgram->uniformLocation("selectionMode");
 
     // text shader
     m_textProgram = new QOpenGLShaderProgram();
@@ -520,15 +560,16 @@ void GLView::setupShaders()
 
     m_textPositionLocation = m_textProgram->attributeLocation("position");
     m_textTexCoordinateLocation = m_textProgram->attributeLocation("texCoordinate");
+    m_textColorLocation = m_textProgram->attributeLocation("color");
     m_textProjectionMatrixLocation = m_textProgram->uniformLocation("projectionMatrix");
     m_textViewMatrixLocation = m_textProgram->uniformLocation("viewMatrix");
-    m_textModelMatrixLocation = m_textProgram->uniformLocation("modelMatrix");
-    m_textColorLocation = m_textProgram->uniformLocation("color");
     m_textTextureLocation = m_textProgram->uniformLocation("texture");
-    m_textAspectRatioLocation = m_textProgram->uniformLocation("aspectRatio");
-    m_textAlignmentLocation = m_textProgram->uniformLocation("alignment");
-    m_textIdColorLocation = m_textProgram->uniformLocation("idColor");
-    m_textSelectionModeLocation = m_textProgram->uniformLocation("selectionMode");
+    m_textSmoothingLocation = m_textProgram->uniformLocation("smoothing");
+
+    // GLES 2 only has the derivatives of the text shader with an extension
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    m_textDerivativesSupported = !context->isOpenGLES() || (context->format().majorVersion() >= 3)
+                                 || context->hasExtension("GL_OES_standard_derivatives");
 }
 
 void GLView::setupWindow()
@@ -737,6 +778,7 @@ void GLView::drawModelVertices(ModelType type)
 {
     QOpenGLBuffer *vertexBuffer = m_vertexBufferMap[type];
     QList<Parameters*> *modelParametersList = getDrawableList(type);
+    const int vertexCount = vertexBuffer->size()/sizeof(ModelVertex);
 
     if (modelParametersList->isEmpty())
     {
@@ -748,191 +790,1534 @@ void GLView::drawModelVertices(ModelType type)
     m_modelProgram->enableAttributeArray(m_normalLocation);
     m_modelProgram->setAttributeBuffer(m_positionLocation, GL_FLOAT, 0, 3, sizeof(ModelVertex));
     m_modelProgram->setAttributeBuffer(m_normalLocation, GL_FLOAT, 3*sizeof(GLfloat), 3, sizeof(ModelVertex));
+    vertexBuffer->release();
+
+    if (m_instancingSupported)
+    {
+        drawModelInstances(type, vertexCount);
+    }
+    else    // per instance attributes are passed as constant vertex attributes
+    {
+        for (int i = 0; i < modelParametersList->size(); ++i)
+        {
+            Parameters *modelParameters = static_cast<Parameters*>(modelParametersList->at(i));
+            m_modelProgram->setAttributeValue(m_modelMatrixLocation, modelParameters->modelMatrix.constData(), 4, 4);
+            m_modelProgram->setAttributeValue(m_colorLocation, modelParameters->color);
+
+            glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+        }
+    }
 
+    m_modelProgram->disableAttributeArray(m_positionLocation);
+    m_modelProgram->disableAttributeArray(m_normalLocation);
+}
+
+/** Draws all instances of a model type with a single call */
+void GLView::drawModelInstances(ModelType type, int vertexCount)
+{
+    ModelInstances *modelInstances = m_modelInstancesMap.value(type, nullptr);
+
+    if (modelInstances == nullptr)
+    {
+        modelInstances = new ModelInstances();
+        m_modelInstancesMap.insert(type, modelInstances);
+    }
+
+    if (modelInstances->dirty)
+    {
+        buildModelInstances(type, modelInstances);
+    }
+
+    modelInstances->instanceBuffer->bind();
+    for (int i = 0; i < 4; ++i)
+    {
+        m_modelProgram->enableAttributeArray(m_modelMatrixLocation + i);
+        m_modelProgram->setAttributeBuffer(m_modelMatrixLocation + i, GL_FLOAT, offsetof(ModelInstance, modelMatrix) + i*4*sizeof(GLfloat), 4, sizeof(ModelInstance));
+    }
+    m_modelProgram->enableAttributeArray(m_colorLocation);
+    m_modelProgram->setAttributeBuffer(m_colorLocation, GL_UNSIGNED_BYTE, offsetof(ModelInstance, color), 4, sizeof(ModelInstance));
+    modelInstances->instanceBuffer->release();
+
+    setModelInstanceAttributes(1);
+    m_drawArraysInstanced(GL_TRIANGLES, 0, vertexCount, modelInstances->instances.size());
+    setModelInstanceAttributes(0);  // the attribute locations are shared with the other programs
+
+    for (int i = 0; i < 4; ++i)
+    {
+        m_modelProgram->disableAttributeArray(m_modelMatrixLocation + i);
+    }
+    m_modelProgram->disableAttributeArray(m_colorLocation);
+}
+
+void GLView::invalidateModelInstances(ModelType type)
+{
+    ModelInstances *modelInstances = m_modelInstancesMap.value(type, nullptr);
+
+    if (modelInstances != nullptr)
+    {
+        modelInstances->dirty = true;
+    }
+}
+
+void GLView::buildModelInstances(ModelType type, ModelInstances *modelInstances)
+{
+    QList<Parameters*> *modelParametersList = getDrawableList(type);
+
+    modelInstances->instances.resize(modelParametersList->size());
     for (int i = 0; i < modelParametersList->size(); ++i)
     {
-        Parameters *modelParameters = static_cast<Parameters*>(modelParametersList->at(i));
-        m_modelProgram->setUniformValue(m_colorLocation, modelParameters->color);
-        m_modelProgram->setUniformValue(m_modelMatrixLocation, modelParameters->modelMatrix);
+        Parameters *modelParameters = modelParametersList->at(i);
+        ModelInstance &instance = modelInstances->instances[i];
+
+        memcpy(instance.modelMatrix, modelParameters->modelMatrix.constData(), sizeof(instance.modelMatrix));
+        instance.color[0] = (GLubyte)modelParameters->color.red();
+        instance.color[1] = (GLubyte)modelParameters->color.green();
+        instance.color[2] = (GLubyte)modelParameters->color.blue();
+        instance.color[3] = (GLubyte)modelParameters->color.alpha();
+    }
+
+    if (modelInstances->instanceBuffer == nullptr)
+    {
+        modelInstances->instanceBuffer = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+        modelInstances->instanceBuffer->create();
+        modelInstances->instanceBuffer->setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    }
+
+    modelInstances->instanceBuffer->bind();
+    modelInstances->instanceBuffer->allocate(modelInstances->instances.constData(), modelInstances->instances.size() * sizeof(ModelInstance));
+    modelInstances->instanceBuffer->release();
+
+    modelInstances->dirty = false;
+}
+
+void GLView::setModelInstanceAttributes(int divisor)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        m_vertexAttribDivisor(m_modelMatrixLocation + i, divisor);
+    }
+    m_vertexAttribDivisor(m_colorLocation, divisor);
+}
+
+void GLView::drawLines()
+{
+    qDeleteAll(m_releasedLineBatches);  // batches of removed items, the context is current here
+    m_releasedLineBatches.clear();
+
+    if (getDrawableList(Line)->isEmpty())
+    {
+        return;
+    }
+
+    updateFrustumPlanes();
+
+    m_lineProgram->enableAttributeArray(m_linePositionLocation);
+    m_lineProgram->enableAttributeArray(m_lineColorLocation);
+    m_lineProgram->enableAttributeArray(m_lineStippleOriginLocation);
+    m_lineProgram->enableAttributeArray(m_lineStippleLengthLocation);
+    m_lineProgram->enableAttributeArray(m_lineStateLocation);
+
+    for (int i = 0; i < m_glItems.size(); ++i)
+    {
+        GLItem *item = m_glItems.at(i);
+        LineBatch *batch = lineBatch(item);
+
+        if ((batch->build != nullptr) && batch->buildFuture.isFinished())
+        {
+            finishLineBuild(batch);
+        }
+
+        if (batch->build == nullptr)
+        {
+            const int arcLevel = batch->hasArcs ? selectArcLevel(batch) : batch->arcLevel;
+
+            if (batch->dirty)
+            {
+                startLineBuild(item, batch);
+            }
+            else if (arcLevel != batch->arcLevel)  // zoomed far enough to tessellate the arcs again
+            {
+                if (!restoreArcLevel(batch, arcLevel))
+                {
+                    startArcBuild(batch);
+                }
+            }
+            else if (!batch->appended.isEmpty())
+            {
+                appendLineBatch(batch);
+            }
+        }
+
+        drawLineBatch(batch, batch->palette);
+        drawLineBatch(batch->arcs, batch->palette);
+    }
+
+    m_lineProgram->disableAttributeArray(m_linePositionLocation);
+    m_lineProgram->disableAttributeArray(m_lineColorLocation);
+    m_lineProgram->disableAttributeArray(m_lineStippleOriginLocation);
+    m_lineProgram->disableAttributeArray(m_lineStippleLengthLocation);
+    m_lineProgram->disableAttributeArray(m_lineStateLocation);
+}
+
+/** Draws the visible chunks of the batch, the arcs of a batch use the palette of their parent */
+void GLView::drawLineBatch(LineBatch *batch, const QVector<QVector4D> &palette)
+{
+    if (batch->vertices.isEmpty())
+    {
+        return;
+    }
+
+    uploadLineBatch(batch);
+
+    batch->vertexBuffer->bind();
+    m_lineProgram->setAttributeBuffer(m_linePositionLocation, GL_FLOAT, offsetof(LineVertex, position), 3, sizeof(LineVertex));
+    m_lineProgram->setAttributeBuffer(m_lineStippleOriginLocation, GL_FLOAT, offsetof(LineVertex, stippleOrigin), 3, sizeof(LineVertex));
+    m_lineProgram->setAttributeBuffer(m_lineStippleLengthLocation, GL_FLOAT, offsetof(LineVertex, stippleLength), 1, sizeof(LineVertex));
+    m_lineProgram->setAttributeBuffer(m_lineColorLocation, GL_UNSIGNED_BYTE, offsetof(LineVertex, color), 4, sizeof(LineVertex));
+    batch->vertexBuffer->release();
+    batch->stateBuffer->bind();
+    m_lineProgram->setAttributeBuffer(m_lineStateLocation, GL_UNSIGNED_BYTE, 0, 1, 0);
+    batch->stateBuffer->release();
+    m_lineProgram->setUniformValueArray(m_linePaletteLocation, palette.constData(), palette.size());
+
+    // neighbouring chunks drawn with the same level are contiguous in the buffer and merged
+    GLfloat drawWidth = 0.0;
+    int drawFirst = 0;
+    int drawCount = 0;
+    for (int j = 0; j < batch->chunks.size(); ++j)
+    {
+        const LineChunk &chunk = batch->chunks.at(j);
+
+        if (!boxVisible(chunk.minimum, chunk.maximum))
+        {
+            continue;   // outside of the view, breaks the merged range
+        }
+
+        const LineLevel &level = chunk.levels.at(selectLineLevel(chunk));
+
+        if ((drawCount > 0) && (chunk.width == drawWidth) && (level.first == (drawFirst + drawCount)))
+        {
+            drawCount += level.count;
+            continue;
+        }
+
+        if (drawCount > 0)
+        {
+            glLineWidth(drawWidth);
+            glDrawArrays(GL_LINES, drawFirst, drawCount);
+        }
+
+        drawWidth = chunk.width;
+        drawFirst = level.first;
+        drawCount = level.count;
+    }
+
+    if (drawCount > 0)
+    {
+        glLineWidth(drawWidth);
+        glDrawArrays(GL_LINES, drawFirst, drawCount);
+    }
+}
+
+GLView::LineBatch::~LineBatch()
+{
+    buildFuture.waitForFinished();  // the worker writes to the build
+    delete build;
+    delete arcs;
+    qDeleteAll(arcCache);
+    delete vertexBuffer;
+    delete stateBuffer;
+}
+
+GLView::LineBatch *GLView::lineBatch(GLItem *item)
+{
+    LineBatch *batch = m_lineBatchMap.value(item, nullptr);
+
+    if (batch == nullptr)
+    {
+        batch = new LineBatch();
+        batch->arcs = new LineBatch();
+        m_lineBatchMap.insert(item, batch);
+    }
+
+    return batch;
+}
+
+void GLView::invalidateLineBatch(GLItem *item)
+{
+    LineBatch *batch = m_lineBatchMap.value(item, nullptr);
+
+    if (batch != nullptr)
+    {
+        batch->dirty = true;
+        batch->stale = true;
+        batch->revision++;  // a running build is discarded
+    }
+}
+
+/** Queues a new line of the item to be appended to its built batch
+ *
+ *  Batches with levels of detail are rebuilt instead, since the simplified
+ *  vertices are stored behind the original ones. Streamed batches have no
+ *  levels of detail until they are rebuilt. Lines added during a running
+ *  build are not part of its copies, they are queued and applied after the
+ *  build is finished.
+ **/
+void GLView::addToLineBatch(GLItem *item, LineParameters *lineParameters)
+{
+    LineBatch *batch = m_lineBatchMap.value(item, nullptr);
+
+    if ((batch == nullptr) || batch->dirty)
+    {
+        return;
+    }
+
+    if (!batch->levelSources.isEmpty() && (batch->build == nullptr))
+    {
+        invalidateLineBatch(item);
+        return;
+    }
+
+    batch->appended.append(lineParameters);
+}
+
+/** Starts baking the line drawables of the item in a worker thread
+ *
+ *  The worker gets copies of the drawables, so the items can change and remove
+ *  them while it is running. The arc tolerance depends on the camera and is
+ *  selected here. The previous geometry of the batch is drawn until the build
+ *  is finished.
+ **/
+void GLView::startLineBuild(GLItem *item, LineBatch *batch)
+{
+    QList<Drawable> *drawableList = m_drawableListMap.value(item, nullptr);
+    LineBuild *build = new LineBuild();
+
+    build->revision = batch->revision;
+    build->batch.arcLevel = batch->arcLevel;
+    build->simplify = !batch->streaming;   // the levels of detail would be discarded by the next append
+    batch->build = build;
+    batch->dirty = false;
+    batch->appended.clear();    // the queued lines are part of the copies
+    batch->patchedDuringBuild = false;
+
+    if (drawableList != nullptr)
+    {
+        for (int i = 0; i < drawableList->size(); ++i)
+        {
+            const Drawable &drawable = drawableList->at(i);
+            if (drawable.type == Line)
+            {
+                LineParameters *lineParameters = static_cast<LineParameters*>(drawable.parameters);
+                LineParameters *copy = new LineParameters(lineParameters);
+                build->copies.append(copy);
+                build->sources.insert(copy, lineParameters);
+                if (copy->isArc)
+                {
+                    addArcBounds(&build->batch, copy);
+                }
+            }
+        }
+    }
+
+    if (build->batch.hasArcs)
+    {
+        build->batch.arcLevel = selectArcLevel(&build->batch);
+        build->arcTolerance = std::pow(4.0f, static_cast<float>(build->batch.arcLevel));
+    }
+
+    if (build->copies.isEmpty())
+    {
+        finishLineBuild(batch);     // nothing to bake
+        return;
+    }
+
+    batch->buildFuture = QtConcurrent::run(this, &GLView::buildLines, build);
+}
+
+/** Starts tessellating the arcs of a built batch for the current arc level in a worker thread
+ *
+ *  The lines and their levels of detail are kept, the arcs of the previous
+ *  level are drawn until the build is finished.
+ **/
+void GLView::startArcBuild(LineBatch *batch)
+{
+    LineBuild *build = new LineBuild();
+
+    build->revision = batch->revision;
+    build->arcsOnly = true;
+    build->batch.hasArcs = true;
+    build->batch.arcMinimum = batch->arcMinimum;
+    build->batch.arcMaximum = batch->arcMaximum;
+    build->batch.arcLevel = selectArcLevel(batch);
+    build->arcTolerance = std::pow(4.0f, static_cast<float>(build->batch.arcLevel));
+    batch->build = build;
+    batch->patchedDuringBuild = false;
+
+    foreach (LineParameters *lineParameters, batch->arcs->drawables)
+    {
+        LineParameters *copy = new LineParameters(lineParameters);
+        build->copies.append(copy);
+        build->sources.insert(copy, lineParameters);
+    }
+
+    batch->buildFuture = QtConcurrent::run(this, &GLView::buildLines, build);
+}
+
+/** Bakes the copied line drawables of the build into world space line segments
+ *
+ *  Runs in a worker thread and must not touch anything except the build.
+ *  The arcs are baked to a batch of their own, so they can be tessellated
+ *  again without the lines.
+ **/
+void GLView::buildLines(LineBuild *build)
+{
+    QList<LineParameters*> lines;
+    QList<LineParameters*> arcs;
+
+    for (int i = 0; i < build->copies.size(); ++i)
+    {
+        LineParameters *lineParameters = build->copies.at(i);
+        if (lineParameters->isArc)
+        {
+            arcs.append(lineParameters);
+        }
+        else if (lineParameters->vertices.size() > 1)
+        {
+            lines.append(lineParameters);
+        }
+    }
+
+    bakeLines(&build->batch, lines, build->arcTolerance, build->simplify);
+    bakeLines(build->batch.arcs, arcs, build->arcTolerance, false); // the tessellation depends on the zoom already
+
+    QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);   // the build is applied with the next frame
+}
+
+/** Bakes the lines into the empty batch grouped by line width */
+void GLView::bakeLines(LineBatch *batch, const QList<LineParameters*> &lines, GLfloat arcTolerance, bool simplify)
+{
+    QMap<GLfloat, QList<LineParameters*> > widthMap;
+    QList<LineRange> ranges;
+    int vertexCount = 0;
+
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        LineParameters *lineParameters = lines.at(i);
+        widthMap[lineParameters->width].append(lineParameters);
+        if (!lineParameters->isArc)     // arcs are tessellated while they are baked
+        {
+            vertexCount += (lineParameters->vertices.size() - 1) * 2;
+        }
+    }
+
+    batch->vertices.reserve(vertexCount);
+    batch->states.reserve(vertexCount);
+
+    QMapIterator<GLfloat, QList<LineParameters*> > it(widthMap);
+    while (it.hasNext())
+    {
+        it.next();
+        LineRange range;
+        range.width = it.key();
+        range.first = batch->vertices.size();
+
+        foreach (LineParameters *lineParameters, it.value())
+        {
+            bakeLine(batch, lineParameters, arcTolerance);
+        }
+
+        range.count = batch->vertices.size() - range.first;
+        ranges.append(range);
+    }
+
+    batch->baseVertexCount = batch->vertices.size();
+    if (batch->baseVertexCount > 0)
+    {
+        batch->segmentTree.build(&batch->vertices.constData()->position.x, sizeof(LineVertex), batch->baseVertexCount / 2);
+    }
+
+    buildLineChunks(batch, ranges, simplify);
+
+    // the simplified vertices take the state of their original vertex
+    batch->states.resize(batch->vertices.size());
+    for (int i = 0; i < batch->levelSources.size(); ++i)
+    {
+        batch->states[batch->baseVertexCount + i] = batch->states.at(batch->levelSources.at(i));
+    }
+}
+
+/** Replaces the geometry of the batch with the finished build
+ *
+ *  Builds started before the drawables of the batch changed are discarded,
+ *  the batch is dirty in this case and a new build is started. A build of
+ *  the arcs only replaces the arcs, the previous ones are kept in the cache.
+ **/
+void GLView::finishLineBuild(LineBatch *batch)
+{
+    LineBuild *build = batch->build;
+    LineBatch &result = build->batch;
+
+    batch->build = nullptr;
+
+    if (build->revision != batch->revision)
+    {
+        delete build;
+        return;
+    }
+
+    if (build->arcsOnly)
+    {
+        cacheArcLevel(batch, batch->arcs, batch->arcLevel);     // reads the offsets before they are replaced
+        batch->arcs = nullptr;
+    }
+
+    for (int i = 0; i < build->copies.size(); ++i)
+    {
+        const LineParameters *copy = build->copies.at(i);
+        LineParameters *lineParameters = build->sources.value(copy);
+        lineParameters->vertexOffset = copy->vertexOffset;
+        lineParameters->vertexCount = copy->vertexCount;
+    }
+
+    for (int i = 0; i < result.drawables.size(); ++i)
+    {
+        result.drawables[i] = build->sources.value(result.drawables.at(i));
+    }
+    for (int i = 0; i < result.arcs->drawables.size(); ++i)
+    {
+        result.arcs->drawables[i] = build->sources.value(result.arcs->drawables.at(i));
+    }
+
+    // colors and states changed during the build were only patched into the previous geometry
+    if (batch->patchedDuringBuild)
+    {
+        patchLineBatch(&result);
+        patchLineBatch(result.arcs);
+    }
+
+    if (!build->arcsOnly)
+    {
+        batch->vertices.swap(result.vertices);
+        batch->states.swap(result.states);
+        batch->drawables.swap(result.drawables);
+        batch->chunks.swap(result.chunks);
+        batch->levelSources.swap(result.levelSources);
+        batch->baseVertexCount = result.baseVertexCount;
+        batch->segmentTree = result.segmentTree;
+        batch->hasArcs = result.hasArcs;
+        batch->arcMinimum = result.arcMinimum;
+        batch->arcMaximum = result.arcMaximum;
+        batch->stale = false;
+        batch->dirtyFirst = -1;
+        batch->dirtyLast = -1;
+        batch->stateFirst = -1;
+        batch->stateLast = -1;
+        qDeleteAll(batch->arcCache);    // the cached arcs reference the previous drawables
+        batch->arcCache.clear();
+        writeLineBuffers(batch, 0);
+    }
+
+    std::swap(batch->arcs, result.arcs);    // the previous arcs are deleted with the build
+    batch->arcLevel = result.arcLevel;
+    batch->patchedDuringBuild = false;
+
+    delete build;
+
+    // lines queued during the build are appended with the next frame, levels of detail need a rebuild
+    if (!batch->appended.isEmpty() && !batch->levelSources.isEmpty())
+    {
+        batch->appended.clear();
+        batch->dirty = true;
+    }
+
+    writeLineBuffers(batch->arcs, 0);
+}
+
+/** Writes the current colors and states of the drawables to the vertices of the batch */
+void GLView::patchLineBatch(LineBatch *batch)
+{
+    for (int i = 0; i < batch->drawables.size(); ++i)
+    {
+        const LineParameters *lineParameters = batch->drawables.at(i);
+        const int first = lineParameters->vertexOffset;
+        for (int j = first; j < (first + lineParameters->vertexCount); ++j)
+        {
+            GLubyte *vertexColor = batch->vertices[j].color;
+            vertexColor[0] = (GLubyte)lineParameters->color.red();
+            vertexColor[1] = (GLubyte)lineParameters->color.green();
+            vertexColor[2] = (GLubyte)lineParameters->color.blue();
+            vertexColor[3] = (GLubyte)lineParameters->color.alpha();
+        }
+        memset(batch->states.data() + first, lineParameters->state, lineParameters->vertexCount);
+    }
+
+    for (int i = 0; i < batch->levelSources.size(); ++i)
+    {
+        const int source = batch->levelSources.at(i);
+        memcpy(batch->vertices[batch->baseVertexCount + i].color, batch->vertices.at(source).color, 4);
+        batch->states[batch->baseVertexCount + i] = batch->states.at(source);
+    }
+}
+
+/** Keeps the arcs of the batch tessellated for arcLevel to switch back without a build
+ *
+ *  Only the vertices are kept, the buffers are released. The cache holds the
+ *  levels next to the current one, zooming usually returns to them.
+ **/
+void GLView::cacheArcLevel(LineBatch *batch, LineBatch *arcs, int arcLevel)
+{
+    const int maximumCachedLevels = 2;
+
+    arcs->cachedOffsets.resize(arcs->drawables.size() * 2);
+    for (int i = 0; i < arcs->drawables.size(); ++i)
+    {
+        arcs->cachedOffsets[2 * i] = arcs->drawables.at(i)->vertexOffset;
+        arcs->cachedOffsets[2 * i + 1] = arcs->drawables.at(i)->vertexCount;
+    }
+
+    delete arcs->vertexBuffer;
+    delete arcs->stateBuffer;
+    arcs->vertexBuffer = nullptr;
+    arcs->stateBuffer = nullptr;
+    arcs->bufferCapacity = 0;
+
+    delete batch->arcCache.take(arcLevel);
+    batch->arcCache.insert(arcLevel, arcs);
+
+    while (batch->arcCache.size() > maximumCachedLevels)   // drop the level farthest from the cached one
+    {
+        const int first = batch->arcCache.firstKey();
+        const int last = batch->arcCache.lastKey();
+        delete batch->arcCache.take((qAbs(first - arcLevel) > qAbs(last - arcLevel)) ? first : last);
+    }
+}
+
+/** Replaces the arcs of the batch with the cached arcs of arcLevel, returns false if there are none */
+bool GLView::restoreArcLevel(LineBatch *batch, int arcLevel)
+{
+    LineBatch *arcs = batch->arcCache.take(arcLevel);
+
+    if (arcs == nullptr)
+    {
+        return false;
+    }
+
+    cacheArcLevel(batch, batch->arcs, batch->arcLevel);
+    batch->arcs = arcs;
+    batch->arcLevel = arcLevel;
+
+    for (int i = 0; i < arcs->drawables.size(); ++i)
+    {
+        arcs->drawables.at(i)->vertexOffset = arcs->cachedOffsets.at(2 * i);
+        arcs->drawables.at(i)->vertexCount = arcs->cachedOffsets.at(2 * i + 1);
+    }
+    arcs->cachedOffsets.clear();
+
+    patchLineBatch(arcs);   // colors and states changed while the arcs were cached
+    writeLineBuffers(arcs, 0);
+
+    return true;
+}
+
+/** Bakes the lines added to a built batch to its end
+ *
+ *  Only chunks for the new lines are added and the segment tree is extended,
+ *  so streamed lines show up without a full rebuild. The appended lines are
+ *  drawn without levels of detail until the batch is rebuilt.
+ **/
+void GLView::appendLineBatch(LineBatch *batch)
+{
+    const GLfloat arcTolerance = std::pow(4.0f, static_cast<float>(batch->arcLevel));
+    QList<LineParameters*> lines;
+    QList<LineParameters*> arcs;
+
+    foreach (LineParameters *lineParameters, batch->appended)
+    {
+        if (lineParameters->isArc)
+        {
+            addArcBounds(batch, lineParameters);
+            arcs.append(lineParameters);
+        }
+        else if (lineParameters->vertices.size() < 2)
+        {
+            lineParameters->vertexOffset = -1;
+            lineParameters->vertexCount = 0;
+        }
+        else
+        {
+            lines.append(lineParameters);
+        }
+    }
+
+    batch->appended.clear();
+    appendLines(batch, lines, arcTolerance);
+    appendLines(batch->arcs, arcs, arcTolerance);
+
+    if (!arcs.isEmpty())
+    {
+        qDeleteAll(batch->arcCache);    // the cached arcs miss the appended ones
+        batch->arcCache.clear();
+    }
+}
+
+/** Bakes the lines to the end of a batch without simplified vertices */
+void GLView::appendLines(LineBatch *batch, const QList<LineParameters*> &lines, GLfloat arcTolerance)
+{
+    const int first = batch->vertices.size();
+    QList<LineRange> ranges;
+
+    if (lines.isEmpty())
+    {
+        return;
+    }
+
+    foreach (LineParameters *lineParameters, lines)
+    {
+        if (ranges.isEmpty() || (ranges.last().width != lineParameters->width))
+        {
+            LineRange range;
+            range.width = lineParameters->width;
+            range.first = batch->vertices.size();
+            range.count = 0;
+            ranges.append(range);
+        }
+
+        bakeLine(batch, lineParameters, arcTolerance);
+        ranges.last().count = batch->vertices.size() - ranges.last().first;
+    }
+
+    batch->baseVertexCount = batch->vertices.size();   // only batches without simplified vertices are appended
+    batch->segmentTree.append(&batch->vertices.constData()->position.x, sizeof(LineVertex),
+                              first / 2, (batch->baseVertexCount - first) / 2);
+    buildLineChunks(batch, ranges, false);
+    writeLineBuffers(batch, first);
+}
+
+/** Converts the line into world space line pairs at the end of the batch */
+void GLView::bakeLine(LineBatch *batch, LineParameters *lineParameters, GLfloat arcTolerance)
+{
+    const QMatrix4x4 &matrix = lineParameters->modelMatrix;
+    const QVector3D origin = matrix.map(QVector3D(0.0, 0.0, 0.0));
+    LineVertex vertex;
+
+    vertex.stippleOrigin.x = origin.x();
+    vertex.stippleOrigin.y = origin.y();
+    vertex.stippleOrigin.z = origin.z();
+    vertex.stippleLength = lineParameters->stipple ? lineParameters->stippleLength : 0.0f;
+    vertex.color[0] = (GLubyte)lineParameters->color.red();
+    vertex.color[1] = (GLubyte)lineParameters->color.green();
+    vertex.color[2] = (GLubyte)lineParameters->color.blue();
+    vertex.color[3] = (GLubyte)lineParameters->color.alpha();
+
+    lineParameters->vertexOffset = batch->vertices.size();
+
+    // arcs are tessellated with the tolerance converted to model space
+    QVector<GLvector3D> vertices = lineParameters->vertices;
+    if (lineParameters->isArc)
+    {
+        const GLfloat scale = qMax(qMax(matrix.column(0).toVector3D().length(),
+                                        matrix.column(1).toVector3D().length()),
+                                   matrix.column(2).toVector3D().length());
+        vertices = tessellateArc(lineParameters->arc, (scale > 0.0f) ? (arcTolerance / scale) : arcTolerance);
+    }
+
+    // the line strip is converted to line pairs to draw everything with a single call
+    for (int i = 0; i < (vertices.size() - 1); ++i)
+    {
+        for (int k = 0; k < 2; ++k)
+        {
+            const GLvector3D &point = vertices.at(i + k);
+            const QVector3D position = matrix.map(QVector3D(point.x, point.y, point.z));
+            vertex.position.x = position.x();
+            vertex.position.y = position.y();
+            vertex.position.z = position.z();
+            batch->vertices.append(vertex);
+        }
+    }
+
+    lineParameters->vertexCount = batch->vertices.size() - lineParameters->vertexOffset;
+    batch->drawables.append(lineParameters);
+
+    batch->states.resize(batch->vertices.size());
+    memset(batch->states.data() + lineParameters->vertexOffset, lineParameters->state, lineParameters->vertexCount);
+}
+
+/** Extends the world space bounds of the arcs of the batch by the arc */
+void GLView::addArcBounds(LineBatch *batch, const LineParameters *lineParameters)
+{
+    const LineArc &arc = lineParameters->arc;
+
+    for (int k = 0; k < 8; ++k)
+    {
+        const QVector3D corner((k & 1) ? (arc.x + arc.radius) : (arc.x - arc.radius),
+                               (k & 2) ? (arc.y + arc.radius) : (arc.y - arc.radius),
+                               (k & 4) ? arc.helixOffset : 0.0f);
+        const QVector3D position = lineParameters->modelMatrix.map(corner);
+        if (!batch->hasArcs)
+        {
+            batch->arcMinimum = position;
+            batch->arcMaximum = position;
+            batch->hasArcs = true;
+        }
+        else
+        {
+            batch->arcMinimum = QVector3D(qMin(batch->arcMinimum.x(), position.x()),
+                                          qMin(batch->arcMinimum.y(), position.y()),
+                                          qMin(batch->arcMinimum.z(), position.z()));
+            batch->arcMaximum = QVector3D(qMax(batch->arcMaximum.x(), position.x()),
+                                          qMax(batch->arcMaximum.y(), position.y()),
+                                          qMax(batch->arcMaximum.z(), position.z()));
+        }
+    }
+}
+
+/** Writes the vertices and states from first to the end of the batch to the buffers
+ *
+ *  Appending to a batch reserves twice the space, so growing batches are not
+ *  uploaded completely on every append.
+ **/
+void GLView::writeLineBuffers(LineBatch *batch, int first)
+{
+    if (batch->vertexBuffer == nullptr)
+    {
+        batch->vertexBuffer = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+        batch->vertexBuffer->create();
+        batch->vertexBuffer->setUsagePattern(QOpenGLBuffer::StaticDraw);
+        batch->stateBuffer = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+        batch->stateBuffer->create();
+        batch->stateBuffer->setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    }
+
+    if ((first == 0) || (batch->vertices.size() > batch->bufferCapacity))
+    {
+        batch->bufferCapacity = (first == 0) ? batch->vertices.size() : qMax(batch->vertices.size(), 2 * batch->bufferCapacity);
+        first = 0;
+
+        batch->vertexBuffer->bind();
+        batch->vertexBuffer->allocate(batch->bufferCapacity * sizeof(LineVertex));
+        batch->vertexBuffer->release();
+        batch->stateBuffer->bind();
+        batch->stateBuffer->allocate(batch->bufferCapacity * sizeof(GLubyte));
+        batch->stateBuffer->release();
+    }
+
+    const int count = batch->vertices.size() - first;
+    if (count == 0)
+    {
+        return;
+    }
+
+    batch->vertexBuffer->bind();
+    batch->vertexBuffer->write(first * sizeof(LineVertex), batch->vertices.constData() + first, count * sizeof(LineVertex));
+    batch->vertexBuffer->release();
+    batch->stateBuffer->bind();
+    batch->stateBuffer->write(first, batch->states.constData() + first, count);
+    batch->stateBuffer->release();
+}
+
+/** Uploads only the vertices with changed colors and states */
+void GLView::uploadLineBatch(LineBatch *batch)
+{
+    if (batch->stateFirst != -1)
+    {
+        const int first = batch->stateFirst;
+        const int count = batch->stateLast - batch->stateFirst + 1;
+        int levelFirst = -1;
+        int levelLast = -1;
+        batch->stateFirst = -1;
+        batch->stateLast = -1;
+
+        for (int i = 0; i < batch->levelSources.size(); ++i)
+        {
+            const int source = batch->levelSources.at(i);
+            if ((source >= first) && (source < (first + count)))
+            {
+                const int index = batch->baseVertexCount + i;
+                batch->states[index] = batch->states.at(source);
+                levelFirst = (levelFirst == -1) ? index : levelFirst;
+                levelLast = index;
+            }
+        }
+
+        batch->stateBuffer->bind();
+        batch->stateBuffer->write(first, batch->states.constData() + first, count);
+        if (levelFirst != -1)
+        {
+            batch->stateBuffer->write(levelFirst, batch->states.constData() + levelFirst, levelLast - levelFirst + 1);
+        }
+        batch->stateBuffer->release();
+    }
+
+    if (batch->dirtyFirst == -1)
+    {
+        return;
+    }
+
+    const int first = batch->dirtyFirst;
+    const int count = batch->dirtyLast - batch->dirtyFirst + 1;
+    int levelFirst = -1;
+    int levelLast = -1;
+    batch->dirtyFirst = -1;
+    batch->dirtyLast = -1;
+
+    // the simplified vertices take the color of their original vertex
+    for (int i = 0; i < batch->levelSources.size(); ++i)
+    {
+        const int source = batch->levelSources.at(i);
+        if ((source >= first) && (source < (first + count)))
+        {
+            const int index = batch->baseVertexCount + i;
+            memcpy(batch->vertices[index].color, batch->vertices.at(source).color, sizeof(LineVertex::color));
+            levelFirst = (levelFirst == -1) ? index : levelFirst;
+            levelLast = index;
+        }
+    }
+
+    batch->vertexBuffer->bind();
+    batch->vertexBuffer->write(first * sizeof(LineVertex), batch->vertices.constData() + first, count * sizeof(LineVertex));
+    if (levelFirst != -1)
+    {
+        batch->vertexBuffer->write(levelFirst * sizeof(LineVertex), batch->vertices.constData() + levelFirst,
+                                   (levelLast - levelFirst + 1) * sizeof(LineVertex));
+    }
+    batch->vertexBuffer->release();
+}
+
+/** Splits the lines into chunks and creates simplified levels of detail for large batches
+ *
+ *  The levels are stored level by level after the original vertices. The level of a chunk
+ *  is selected at render time from its projected error, so the number of drawn vertices
+ *  depends on the screen resolution and not on the number of lines.
+ *
+ *  A chunk is closed early when its bounds grow beyond a fraction of the bounds of
+ *  its range, so the chunks stay compact for culling at the view frustum.
+ **/
+void GLView::buildLineChunks(LineBatch *batch, const QList<LineRange> &ranges, bool simplify)
+{
+    const int segmentsPerChunk = 4096;
+    const int minimumSegmentsPerChunk = 256;        // limits the number of draw calls
+    const float maximumChunkFraction = 1.0f / 16.0f;
+    const int minimumSimplifiedSegments = 16384;    // smaller batches are drawn as they are
+    const int maximumLevels = 6;
+
+    for (int i = 0; i < ranges.size(); ++i)
+    {
+        const LineRange &range = ranges.at(i);
+        const int end = range.first + range.count;
+        QVector3D rangeMinimum;
+        QVector3D rangeMaximum;
+
+        if (range.count == 0)
+        {
+            continue;
+        }
+
+        rangeMinimum = rangeMaximum = vertexPosition(batch, range.first);
+        for (int k = range.first + 1; k < end; ++k)
+        {
+            extendBounds(vertexPosition(batch, k), &rangeMinimum, &rangeMaximum);
+        }
+
+        const float maximumChunkSize = (rangeMaximum - rangeMinimum).length() * maximumChunkFraction;
+        int first = range.first;
+        while (first < end)
+        {
+            LineChunk chunk;
+            LineLevel level;
+            int k = first;
+
+            chunk.width = range.width;
+            chunk.minimum = chunk.maximum = vertexPosition(batch, first);
+            for (; (k < end) && ((k - first) < (2 * segmentsPerChunk)); k += 2)
+            {
+                QVector3D minimum = chunk.minimum;
+                QVector3D maximum = chunk.maximum;
+                extendBounds(vertexPosition(batch, k), &minimum, &maximum);
+                extendBounds(vertexPosition(batch, k + 1), &minimum, &maximum);
+
+                if (((k - first) >= (2 * minimumSegmentsPerChunk))
+                    && ((maximum - minimum).length() > maximumChunkSize))
+                {
+                    break;
+                }
+
+                chunk.minimum = minimum;
+                chunk.maximum = maximum;
+            }
+
+            level.first = first;
+            level.count = k - first;
+            level.error = 0.0f;
+            chunk.levels.append(level);
+
+            batch->chunks.append(chunk);
+            first = k;
+        }
+    }
+
+    if (!simplify || ((batch->baseVertexCount / 2) < minimumSimplifiedSegments))
+    {
+        return;
+    }
+
+    for (int levelIndex = 1; levelIndex < maximumLevels; ++levelIndex)
+    {
+        for (int i = 0; i < batch->chunks.size(); ++i)
+        {
+            LineChunk &chunk = batch->chunks[i];
+            if (chunk.levels.size() != levelIndex)
+            {
+                continue;   // simplification of this chunk stopped at a previous level
+            }
+
+            const LineLevel &previous = chunk.levels.last();
+            const int first = batch->vertices.size();
+            LineLevel level;
+
+            level.error = (chunk.maximum - chunk.minimum).length() * 1e-4f * std::pow(4.0f, float(levelIndex - 1));
+            simplifyLines(batch, chunk.levels.first(), level.error);
+            level.first = first;
+            level.count = batch->vertices.size() - first;
+
+            if (level.count > (previous.count * 3 / 4))  // not worth another level
+            {
+                batch->vertices.resize(first);
+                batch->levelSources.resize(first - batch->baseVertexCount);
+                continue;
+            }
+
+            chunk.levels.append(level);
+        }
+    }
+}
+
+QVector3D GLView::vertexPosition(const LineBatch *batch, int vertex)
+{
+    const GLvector3D &position = batch->vertices.at(vertex).position;
+    return QVector3D(position.x, position.y, position.z);
+}
+
+void GLView::extendBounds(const QVector3D &vector, QVector3D *minimum, QVector3D *maximum)
+{
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        (*minimum)[axis] = qMin((*minimum)[axis], vector[axis]);
+        (*maximum)[axis] = qMax((*maximum)[axis], vector[axis]);
+    }
+}
+
+static float distanceToSegment(const QVector3D &point, const QVector3D &start, const QVector3D &end)
+{
+    const QVector3D direction = end - start;
+    const float lengthSquared = direction.lengthSquared();
+    float t = 0.0f;
+
+    if (lengthSquared > 0.0f)
+    {
+        t = qBound(0.0f, QVector3D::dotProduct(point - start, direction) / lengthSquared, 1.0f);
+    }
+
+    return (start + direction * t).distanceToPoint(point);
+}
+
+/** Appends the lines of the base level simplified with the Douglas-Peucker algorithm
+ *
+ *  Connected segments with the same stipple setting are joined to polylines
+ *  before they are simplified, so no point moves more than tolerance.
+ **/
+void GLView::simplifyLines(LineBatch *batch, const LineLevel &baseLevel, GLfloat tolerance)
+{
+    const float connectTolerance = tolerance * 1e-3f;
+    QVector<int> polyline;      // original vertex indices of the polyline points
+    QVector<QVector3D> points;
+    QVector<bool> keep;
+    QVector<QPair<int, int> > stack;
+
+    for (int i = baseLevel.first; i <= (baseLevel.first + baseLevel.count); i += 2)
+    {
+        bool connected = false;
 
-        if (m_selectionModeActive)  // selection mode active
+        if ((i < (baseLevel.first + baseLevel.count)) && !polyline.isEmpty())
         {
-            m_modelProgram->setUniformValue(m_idColorLocation, QColor(0xFF000000u + m_currentDrawableId));    // color for selection mode
-            m_drawableIdMap.insert(m_currentDrawableId, modelParameters);
-            m_currentDrawableId++;
+            const LineVertex &last = batch->vertices.at(polyline.last());
+            const LineVertex &start = batch->vertices.at(i);
+            connected = (last.stippleLength == start.stippleLength)
+                    && (std::fabs(last.position.x - start.position.x) <= connectTolerance)
+                    && (std::fabs(last.position.y - start.position.y) <= connectTolerance)
+                    && (std::fabs(last.position.z - start.position.z) <= connectTolerance);
         }
 
-        glDrawArrays(GL_TRIANGLES, 0, vertexBuffer->size()/sizeof(ModelVertex));
+        if (connected)
+        {
+            polyline.append(i + 1);
+            continue;
+        }
+
+        if (polyline.size() > 1) // simplify and emit the finished polyline
+        {
+            points.resize(polyline.size());
+            keep.fill(false, polyline.size());
+            for (int k = 0; k < polyline.size(); ++k)
+            {
+                const GLvector3D &position = batch->vertices.at(polyline.at(k)).position;
+                points[k] = QVector3D(position.x, position.y, position.z);
+            }
+
+            keep[0] = true;
+            keep[polyline.size() - 1] = true;
+            stack.append(qMakePair(0, polyline.size() - 1));
+            while (!stack.isEmpty())
+            {
+                const QPair<int, int> span = stack.takeLast();
+                float maximumDistance = 0.0f;
+                int maximumIndex = -1;
+
+                for (int k = (span.first + 1); k < span.second; ++k)
+                {
+                    const float distance = distanceToSegment(points.at(k), points.at(span.first), points.at(span.second));
+                    if (distance > maximumDistance)
+                    {
+                        maximumDistance = distance;
+                        maximumIndex = k;
+                    }
+                }
+
+                if ((maximumIndex != -1) && (maximumDistance > tolerance))
+                {
+                    keep[maximumIndex] = true;
+                    stack.append(qMakePair(span.first, maximumIndex));
+                    stack.append(qMakePair(maximumIndex, span.second));
+                }
+            }
+
+            int previous = 0;
+            for (int k = 1; k < polyline.size(); ++k)
+            {
+                if (!keep.at(k))
+                {
+                    continue;
+                }
+
+                const int source[2] = { polyline.at(previous), polyline.at(k) };
+                for (int n = 0; n < 2; ++n)
+                {
+                    const LineVertex vertex = batch->vertices.at(source[n]);
+                    batch->vertices.append(vertex);
+                    batch->levelSources.append(source[n]);
+                }
+                previous = k;
+            }
+        }
+
+        polyline.clear();
+        if (i < (baseLevel.first + baseLevel.count))
+        {
+            polyline.append(i);
+            polyline.append(i + 1);
+        }
     }
+}
+
+/** Returns the coarsest level of the chunk with a projected error below one pixel */
+int GLView::selectLineLevel(const LineChunk &chunk) const
+{
+    const float maximumPixelError = 1.0f;
+
+    if (chunk.levels.size() == 1)
+    {
+        return 0;
+    }
+
+    const float size = pixelSize(chunk.minimum, chunk.maximum);
+    if (size <= 0.0f)
+    {
+        return 0;   // the chunk intersects the camera plane
+    }
+
+    const float pixelsPerUnit = 1.0f / size;
+    for (int i = (chunk.levels.size() - 1); i > 0; --i)
+    {
+        if ((chunk.levels.at(i).error * pixelsPerUnit) <= maximumPixelError)
+        {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+/** Returns the zoom level the arcs of the batch should be tessellated for,
+ *  a level allows a deviation of 4^level world units
+ *
+ *  The current level is kept until the zoom leaves it by a quarter level, so
+ *  zooming around a level boundary does not tessellate the arcs on every frame.
+ **/
+int GLView::selectArcLevel(const LineBatch *batch) const
+{
+    const float hysteresis = 0.25f;
+    const float size = pixelSize(batch->arcMinimum, batch->arcMaximum);
+
+    if (size <= 0.0f)
+    {
+        return batch->arcLevel; // the arcs intersect the camera plane, keep the current tessellation
+    }
+
+    // half a pixel deviation, quantized to powers of four to tessellate again only on larger zoom changes
+    const float level = std::log(0.5f * size) / std::log(4.0f);
+    if ((level >= (batch->arcLevel - hysteresis)) && (level < (batch->arcLevel + 1 + hysteresis)))
+    {
+        return batch->arcLevel;
+    }
+
+    return static_cast<int>(std::floor(level));
+}
+
+/** Tessellates the arc into a line strip whose chords deviate at most tolerance from the arc */
+QVector<GLView::GLvector3D> GLView::tessellateArc(const LineArc &arc, GLfloat tolerance) const
+{
+    const float minimumSegmentAngle = 2.0f * PI_F / 256.0f;   // at most 256 segments per revolution
+    const float maximumSegmentAngle = 2.0f * PI_F / 3.0f;     // at least 3 segments per revolution
+    QVector<GLvector3D> vertices;
+    float segmentAngle;
+    int nSegments;
+
+    if (arc.radius > 0.0f)
+    {
+        segmentAngle = 2.0f * std::acos(1.0f - qMin(tolerance / arc.radius, 1.0f));
+    }
+    else
+    {
+        segmentAngle = maximumSegmentAngle;
+    }
+    segmentAngle = qBound(minimumSegmentAngle, segmentAngle, maximumSegmentAngle);
+    nSegments = qMax(1, static_cast<int>(std::ceil(std::fabs(arc.angle) / segmentAngle)));
+
+    vertices.reserve(nSegments + 1);
+    for (int i = 0; i < (nSegments + 1); ++i)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(nSegments);
+        const float angle = arc.startAngle + arc.angle * t;
+        GLvector3D vertex;
+        vertex.x = std::cos(angle) * arc.radius + arc.x;
+        vertex.y = std::sin(angle) * arc.radius + arc.y;
+        vertex.z = arc.helixOffset * t;
+        vertices.append(vertex);
+    }
+
+    return vertices;
+}
+
+/** Returns the size of a pixel in world units at the point of the box closest to the camera,
+ *  0 if the box intersects the camera plane
+ **/
+GLfloat GLView::pixelSize(const QVector3D &minimum, const QVector3D &maximum) const
+{
+    // the camera looks along the negative z axis
+    const QVector3D center = (minimum + maximum) / 2.0f;
+    const float radius = (maximum - minimum).length() / 2.0f;
+    const float eyeZ = m_viewMatrix.map(center).z() + radius;
+    const float w = m_projectionMatrix(3, 2) * eyeZ + m_projectionMatrix(3, 3);
+
+    if ((w <= 0.0f) || (height() <= 0.0))
+    {
+        return 0.0f;
+    }
+
+    return w / (0.5f * static_cast<float>(height()) * m_projectionMatrix(1, 1));
+}
+
+/** Draws the trails of the items with the line program, each with a single call
+ *
+ *  The ring stores every position twice, so the positions from the oldest to
+ *  the newest are always contiguous in the buffer.
+ **/
+void GLView::drawTrails()
+{
+    qDeleteAll(m_releasedTrails);   // trails of removed items, the context is current here
+    m_releasedTrails.clear();
+
+    if (m_trailMap.isEmpty())
+    {
+        return;
+    }
+
+    m_lineProgram->enableAttributeArray(m_linePositionLocation);
+    m_lineProgram->enableAttributeArray(m_lineStateLocation);
+    m_lineProgram->setAttributeValue(m_lineColorLocation, 1.0f, 1.0f, 1.0f, 1.0f);
+    m_lineProgram->setAttributeValue(m_lineStippleLengthLocation, 0.0f);   // trails are not stippled
+
+    QMapIterator<GLItem*, Trail*> it(m_trailMap);
+    while (it.hasNext())
+    {
+        it.next();
+        Trail *trail = it.value();
+
+        uploadTrail(trail);
+
+        if (!trail->visible || (trail->count < 2))
+        {
+            continue;
+        }
+
+        const int first = (trail->head - trail->count + trail->capacity) % trail->capacity;
+        const LineBatch *batch = lineBatch(it.key());
+
+        trail->buffer->bind();
+        m_lineProgram->setAttributeBuffer(m_linePositionLocation, GL_FLOAT, offsetof(TrailVertex, position), 3, sizeof(TrailVertex));
+        m_lineProgram->setAttributeBuffer(m_lineStateLocation, GL_UNSIGNED_BYTE, offsetof(TrailVertex, state), 1, sizeof(TrailVertex));
+        trail->buffer->release();
+        m_lineProgram->setUniformValueArray(m_linePaletteLocation, batch->palette.constData(), batch->palette.size());
+
+        glLineWidth(trail->width);
+        glDrawArrays(GL_LINE_STRIP, first, trail->count);
+    }
+
+    m_lineProgram->disableAttributeArray(m_linePositionLocation);
+    m_lineProgram->disableAttributeArray(m_lineStateLocation);
+}
+
+/** Writes the positions appended since the last frame to the buffer of the trail
+ *
+ *  The written ring range and its copy are at most three pieces, so the cost
+ *  depends on the number of new positions and not on the capacity.
+ **/
+void GLView::uploadTrail(Trail *trail)
+{
+    if (trail->buffer == nullptr)
+    {
+        trail->buffer = new QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
+        trail->buffer->create();
+        trail->buffer->setUsagePattern(QOpenGLBuffer::DynamicDraw);
+        trail->reallocate = true;
+    }
+
+    trail->buffer->bind();
+    if (trail->reallocate)
+    {
+        trail->buffer->allocate(trail->vertices.constData(), trail->vertices.size() * sizeof(TrailVertex));
+        trail->reallocate = false;
+    }
+    else if (trail->uploadCount > 0)
+    {
+        const int first = trail->uploadFirst;
+        const int count = trail->uploadCount;
+
+        writeTrailVertices(trail, first, count);
+        writeTrailVertices(trail, first + trail->capacity, qMin(count, trail->capacity - first));
+        if ((first + count) > trail->capacity)
+        {
+            writeTrailVertices(trail, 0, first + count - trail->capacity);
+        }
+    }
+    trail->buffer->release();
+
+    trail->uploadCount = 0;
+}
 
-    m_modelProgram->disableAttributeArray(m_positionLocation);
-    m_modelProgram->disableAttributeArray(m_normalLocation);
-    vertexBuffer->release();
+void GLView::writeTrailVertices(Trail *trail, int first, int count)
+{
+    trail->buffer->write(first * sizeof(TrailVertex), trail->vertices.constData() + first, count * sizeof(TrailVertex));
 }
 
-void GLView::drawLines()
+/** Extracts the planes of the view frustum from the view projection matrix (Gribb and Hartmann) */
+void GLView::updateFrustumPlanes()
 {
-    QList<Parameters*>* parametersList = getDrawableList(Line);
+    const QMatrix4x4 viewProjectionMatrix = m_projectionMatrix * m_viewMatrix;
+    const QVector4D w = viewProjectionMatrix.row(3);
 
-    if (parametersList->isEmpty())
+    for (int i = 0; i < 3; ++i)
     {
-        return;
+        const QVector4D row = viewProjectionMatrix.row(i);
+        m_frustumPlanes[2 * i] = w + row;
+        m_frustumPlanes[2 * i + 1] = w - row;
     }
+}
 
-    m_lineVertexBuffer->bind();
-    m_lineProgram->enableAttributeArray(m_linePositionLocation);
-    m_lineProgram->setAttributeBuffer(m_linePositionLocation, GL_FLOAT, 0, 3);
-
-    for (int i = 0; i < parametersList->size(); ++i)
+/** Returns false if the axis aligned box is completely outside of one of the frustum planes
+ *
+ *  Boxes close to a corner of the frustum can be visible although they are not,
+ *  which only costs drawing them.
+ **/
+bool GLView::boxVisible(const QVector3D &minimum, const QVector3D &maximum) const
+{
+    for (int i = 0; i < 6; ++i)
     {
-        LineParameters *lineParameters = static_cast<LineParameters*>(parametersList->at(i));
-        m_lineVertexBuffer->write(0, lineParameters->vertices.data(), lineParameters->vertices.size() * sizeof(GLvector3D));
-        m_lineProgram->setUniformValue(m_lineColorLocation, lineParameters->color);
-        m_lineProgram->setUniformValue(m_lineModelMatrixLocation, lineParameters->modelMatrix);
-        m_lineProgram->setUniformValue(m_lineStippleLocation, lineParameters->stipple);
-        m_lineProgram->setUniformValue(m_lineStippleLengthLocation, lineParameters->stippleLength);
+        const QVector4D &plane = m_frustumPlanes[i];
+        // the corner furthest along the plane normal
+        const QVector3D corner((plane.x() >= 0.0f) ? maximum.x() : minimum.x(),
+                               (plane.y() >= 0.0f) ? maximum.y() : minimum.y(),
+                               (plane.z() >= 0.0f) ? maximum.z() : minimum.z());
 
-        if (m_selectionModeActive)  // selection mode active
+        if ((plane.x() * corner.x() + plane.y() * corner.y() + plane.z() * corner.z() + plane.w()) < 0.0f)
         {
-            m_lineProgram->setUniformValue(m_lineIdColorLocation, QColor(0xFF000000u + m_currentDrawableId));    // color for selection mode
-            m_drawableIdMap.insert(m_currentDrawableId, lineParameters);
-            m_currentDrawableId++;
+            return false;
         }
-
-        glLineWidth(lineParameters->width);
-        glDrawArrays(GL_LINE_STRIP, 0, lineParameters->vertices.size());
     }
 
-    m_lineProgram->disableAttributeArray(m_linePositionLocation);
-    m_lineVertexBuffer->release();
+    return true;
 }
 
+/** Draws the glyphs of all texts with a single call */
 void GLView::drawTexts()
 {
-    QList<Parameters*>* parametersList = getDrawableList(Text);
+    if (m_textVerticesDirty)
+    {
+        writeTextVertices();
+    }
 
-    if (parametersList->isEmpty())
+    if (m_textVertexCount == 0)
     {
         return;
     }
 
+    uploadGlyphTexture();
+
     m_textVertexBuffer->bind();
     m_textProgram->enableAttributeArray(m_textPositionLocation);
     m_textProgram->enableAttributeArray(m_textTexCoordinateLocation);
-    m_textProgram->setAttributeBuffer(m_textPositionLocation, GL_FLOAT, 0, 3, sizeof(TextVertex));
-    m_textProgram->setAttributeBuffer(m_textTexCoordinateLocation, GL_FLOAT, 3*sizeof(GLfloat), 2, sizeof(TextVertex));
+    m_textProgram->enableAttributeArray(m_textColorLocation);
+    m_textProgram->setAttributeBuffer(m_textPositionLocation, GL_FLOAT, offsetof(TextVertex, position), 3, sizeof(TextVertex));
+    m_textProgram->setAttributeBuffer(m_textTexCoordinateLocation, GL_FLOAT, offsetof(TextVertex, texCoordinate), 2, sizeof(TextVertex));
+    m_textProgram->setAttributeBuffer(m_textColorLocation, GL_UNSIGNED_BYTE, offsetof(TextVertex, color), 4, sizeof(TextVertex));
 
-    for (int i = 0; i < parametersList->size(); ++i)
-    {
-        TextParameters *textParameters = static_cast<TextParameters*>(parametersList->at(i));
-        QStaticText staticText = textParameters->staticText;
-        int textureIndex;
-        QOpenGLTexture *texture;
-        float aspectRatio;
-
-        textureIndex = m_textTextList.indexOf(staticText);
-        texture = m_textTextureList.at(textureIndex);
-        aspectRatio = m_textAspectRatioList.at(textureIndex);
-
-        if (!texture->isCreated()) // initialize texture on first use
-        {
-            createTextTexture(textParameters);
-        }
-
-        m_textProgram->setUniformValue(m_textAspectRatioLocation, aspectRatio);
-        m_textProgram->setUniformValue(m_textAlignmentLocation, (GLint)textParameters->alignment);
-        m_textProgram->setUniformValue(m_textColorLocation, textParameters->color);
-        m_textProgram->setUniformValue(m_textModelMatrixLocation, textParameters->modelMatrix);
-        m_textProgram->setUniformValue(m_textTextureLocation, texture->textureId());
-
-        if (m_selectionModeActive)  // selection mode active
-        {
-            m_textProgram->setUniformValue(m_textIdColorLocation, QColor(0xFF000000u + m_currentDrawableId));    // color for selection mode
-            m_drawableIdMap.insert(m_currentDrawableId, textParameters);
-            m_currentDrawableId++;
-        }
-
-        texture->bind(texture->textureId());
-        glDrawArrays(GL_TRIANGLES, 0, m_textVertexBuffer->size()/sizeof(TextVertex));
-        texture->release(texture->textureId());
-    }
+    m_glyphTexture->bind(0);
+    m_textProgram->setUniformValue(m_textTextureLocation, 0);
+    m_textProgram->setUniformValue(m_textSmoothingLocation, m_textDerivativesSupported ? 0.0f : 0.1f);
+    glDrawArrays(GL_TRIANGLES, 0, m_textVertexCount);
+    m_glyphTexture->release(0);
 
     m_textProgram->disableAttributeArray(m_textPositionLocation);
     m_textProgram->disableAttributeArray(m_textTexCoordinateLocation);
+    m_textProgram->disableAttributeArray(m_textColorLocation);
     m_textVertexBuffer->release();
 }
 
-void GLView::prepareTextTexture(const QStaticText &staticText, QFont font)
+/** Lays out the glyphs of the text, a full glyph atlas is rebuilt with the texts in use */
+void GLView::layoutText(TextParameters *textParameters)
 {
-    if (m_textTextList.contains(staticText))
+    if (m_glyphAtlas.layoutText(textParameters->text, textParameters->font,
+                                &textParameters->glyphs, &textParameters->width))
     {
         return;
     }
 
-    if (m_textTextureList.size() > 100) // maximum of 100 rendered texts TODO: make parameter
+    QList<Parameters*> *parametersList = getDrawableList(Text);
+
+    m_glyphAtlas.clear();
+    for (int i = 0; i < parametersList->size(); ++i)
     {
-        clearTextTextures();
+        TextParameters *usedTextParameters = static_cast<TextParameters*>(parametersList->at(i));
+        m_glyphAtlas.layoutText(usedTextParameters->text, usedTextParameters->font,
+                                &usedTextParameters->glyphs, &usedTextParameters->width);
     }
+    m_glyphAtlas.layoutText(textParameters->text, textParameters->font,
+                            &textParameters->glyphs, &textParameters->width);
+
+    m_textVerticesDirty = true;
+}
 
-    QPixmap pixmap(QSize(qCeil(staticText.size().width()), qCeil(staticText.size().height())));
-    pixmap.fill(QColor(Qt::transparent));
+/** Writes the glyph quads of all texts in world space to the text vertex buffer
+ *
+ *  Every glyph gets a back face with the text mirrored about its center,
+ *  so texts are readable from both sides.
+ **/
+void GLView::writeTextVertices()
+{
+    const QList<Parameters*> *parametersList = getDrawableList(Text);
+    QVector<TextVertex> vertices;
 
-    QPainter painter(&pixmap);
-    painter.setPen(Qt::white);
-    painter.setFont(font);
-    painter.drawStaticText(0, 0, staticText);
+    for (int i = 0; i < parametersList->size(); ++i)
+    {
+        const TextParameters *textParameters = static_cast<TextParameters*>(parametersList->at(i));
+        const QMatrix4x4 &matrix = textParameters->modelMatrix;
+        const GLfloat width = textParameters->width;
+        GLfloat offset = 0.0f;
+        TextVertex vertex;
+
+        if (textParameters->alignment == AlignCenter) {
+            offset = -width / 2.0f;
+        }
+        else if (textParameters->alignment == AlignRight) {
+            offset = -width;
+        }
 
-    QOpenGLTexture *texture = new QOpenGLTexture(QOpenGLTexture::Target2D);
-    float aspectRatio = staticText.size().width()/staticText.size().height();
+        vertex.color[0] = (GLubyte)textParameters->color.red();
+        vertex.color[1] = (GLubyte)textParameters->color.green();
+        vertex.color[2] = (GLubyte)textParameters->color.blue();
+        vertex.color[3] = (GLubyte)textParameters->color.alpha();
 
-    m_textTextList.append(staticText);
-    m_textTextureList.append(texture);
-    m_textAspectRatioList.append(aspectRatio);
-    m_textImageList.append(pixmap.toImage());
-}
+        for (int j = 0; j < textParameters->glyphs.size(); ++j)
+        {
+            const GLGlyphAtlas::GlyphQuad &glyph = textParameters->glyphs.at(j);
+            const QVector2D minimum(offset + glyph.minimum.x(), glyph.minimum.y());
+            const QVector2D maximum(offset + glyph.maximum.x(), glyph.maximum.y());
+            const QVector2D mirroredMinimum(2.0f * offset + width - maximum.x(), minimum.y());
+            const QVector2D mirroredMaximum(2.0f * offset + width - minimum.x(), maximum.y());
+
+            appendTextQuad(&vertices, vertex, matrix, minimum, maximum,
+                           glyph.textureMinimum, glyph.textureMaximum, false);
+            appendTextQuad(&vertices, vertex, matrix, mirroredMinimum, mirroredMaximum,
+                           QVector2D(glyph.textureMaximum.x(), glyph.textureMinimum.y()),
+                           QVector2D(glyph.textureMinimum.x(), glyph.textureMaximum.y()), true);
+        }
+    }
 
-void GLView::createTextTexture(TextParameters *textParameters)
-{
-    int textureIndex = m_textTextList.indexOf(textParameters->staticText);
-    QOpenGLTexture *texture = m_textTextureList.at(textureIndex);
+    m_textVertexBuffer->bind();
+    m_textVertexBuffer->allocate(vertices.constData(), vertices.size() * sizeof(TextVertex));
+    m_textVertexBuffer->release();
 
-    texture->create();
-    texture->setMinificationFilter(QOpenGLTexture::Nearest);
-    texture->setMagnificationFilter(QOpenGLTexture::Nearest);
-    texture->setWrapMode(QOpenGLTexture::ClampToEdge);
-    texture->setData(m_textImageList.at(textureIndex));
+    m_textVertexCount = vertices.size();
+    m_textVerticesDirty = false;
 }
 
-void GLView::clearTextTextures()
+/** Appends the two triangles of a glyph quad, back faces are wound clockwise */
+void GLView::appendTextQuad(QVector<TextVertex> *vertices, TextVertex vertex, const QMatrix4x4 &matrix,
+                            const QVector2D &minimum, const QVector2D &maximum,
+                            const QVector2D &textureMinimum, const QVector2D &textureMaximum, bool backFace) const
 {
-    QList<int> usedIndexes;
-    QList<Parameters*>* parametersList = getDrawableList(Text);
+    const QVector2D corners[4] = { minimum, QVector2D(maximum.x(), minimum.y()),
+                                   maximum, QVector2D(minimum.x(), maximum.y()) };
+    const QVector2D textureCorners[4] = { textureMinimum, QVector2D(textureMaximum.x(), textureMinimum.y()),
+                                          textureMaximum, QVector2D(textureMinimum.x(), textureMaximum.y()) };
+    static const int frontIndexes[6] = { 0, 1, 2, 0, 2, 3 };
+    static const int backIndexes[6] = { 0, 2, 1, 0, 3, 2 };
+    const int *indexes = backFace ? backIndexes : frontIndexes;
 
-
-    // search for indexes still in use
-    for (int i = 0; i < parametersList->size(); ++i)
+    for (int i = 0; i < 6; ++i)
     {
-        TextParameters *textParameters = static_cast<TextParameters*>(parametersList->at(i));
-
-        if (m_textTextList.contains(textParameters->staticText))
-        {
-            usedIndexes.append(i);
-        }
+        const QVector2D &corner = corners[indexes[i]];
+        const QVector3D position = matrix.map(QVector3D(corner.x(), corner.y(), 0.0f));
+        vertex.position.x = position.x();
+        vertex.position.y = position.y();
+        vertex.position.z = position.z();
+        vertex.texCoordinate.x = textureCorners[indexes[i]].x();
+        vertex.texCoordinate.y = textureCorners[indexes[i]].y();
+        vertices->append(vertex);
     }
+}
 
-    // remove all textures that are not in use anymore
-    for (int i = (m_textTextureList.size()-1); i >= 0; i--)
+/** Uploads the glyph atlas again when glyphs were added */
+void GLView::uploadGlyphTexture()
+{
+    if ((m_glyphTexture != nullptr) && (m_glyphTextureRevision == m_glyphAtlas.revision()))
     {
-        if (!usedIndexes.contains(i))
-        {
-            m_textTextList.removeAt(i);
-            m_textAspectRatioList.removeAt(i);
-            m_textTextureList.at(i)->destroy();
-            delete m_textTextureList.at(i);
-            m_textTextureList.removeAt(i);
-            m_textImageList.removeAt(i);
-        }
+        return;
+    }
+
+    if (m_glyphTexture == nullptr) {
+        m_glyphTexture = new QOpenGLTexture(QOpenGLTexture::Target2D);
     }
+    else {
+        m_glyphTexture->destroy();
+    }
+
+    // the distance field is interpolated linearly, mip maps would blur the outlines
+    m_glyphTexture->setData(m_glyphAtlas.image(), QOpenGLTexture::DontGenerateMipMaps);
+    m_glyphTexture->setMinificationFilter(QOpenGLTexture::Linear);
+    m_glyphTexture->setMagnificationFilter(QOpenGLTexture::Linear);
+    m_glyphTexture->setWrapMode(QOpenGLTexture::ClampToEdge);
+    m_glyphTextureRevision = m_glyphAtlas.revision();
 }
 
 void GLView::updateGLItems()
@@ -953,17 +2338,42 @@ void GLView::updateGLItem(GLItem *item)
     m_modifiedGlItems.append(item);
 }
 
-void GLView::paintGLItems()
+/** Moves the batches and trails of removed items to the lists destroyed by the next paint */
+void GLView::releaseGLItems()
 {
-    for (int i = 0; i < m_modifiedGlItems.size(); ++i)
+    foreach (GLItem *item, m_removedGlItems)
     {
-        paintGLItem(m_modifiedGlItems.at(i));
+        if (m_lineBatchMap.contains(item)) {
+            m_releasedLineBatches.append(m_lineBatchMap.take(item));
+        }
+        if (m_trailMap.contains(item)) {
+            m_releasedTrails.append(m_trailMap.take(item));
+        }
     }
+    m_removedGlItems.clear();
+}
+
+void GLView::paintGLItems()
+{
+    // items requesting another update while painting are painted with the next synchronization
+    const QList<GLItem*> modifiedGlItems = m_modifiedGlItems;
     m_modifiedGlItems.clear();
+
+    for (int i = 0; i < modifiedGlItems.size(); ++i)
+    {
+        paintGLItem(modifiedGlItems.at(i));
+    }
 }
 
 void GLView::paintGLItem(GLItem *item)
 {
+    Trail *trail = m_trailMap.value(item, nullptr);
+
+    if (trail != nullptr)
+    {
+        trail->visible = item->isVisible();
+    }
+
     if (item->isVisible())
     {
         item->paint(this);
@@ -974,59 +2384,187 @@ void GLView::paintGLItem(GLItem *item)
     }
 }
 
-quint32 GLView::getSelection()
+/** Finds the drawable closest to the viewer at point, the lines are looked up in the segment trees */
+GLView::Parameters *GLView::pickDrawable(const QPointF &point) const
 {
-    QList<quint32> ids;
-    QList<quint32> sortedIds;
-    int selectionSize = 5;  // only odd selection sizes make sense
-    int sizeOffset;
-    QPoint correctedSelectionPoint;
+    const float pickRadius = 3.0f;  // in pixels
+    const QList<ModelType> modelTypes = QList<ModelType>() << Cube << Cylinder << Cone << Sphere;
+    Parameters *selected = nullptr;
+    float selectedDepth = 0.0f;
+
+    if (!m_initialized || (width() <= 0.0) || (height() <= 0.0))
+    {
+        return nullptr;
+    }
+
+    const QMatrix4x4 viewProjectionMatrix = m_projectionMatrix * m_viewMatrix;
+    const QMatrix4x4 inverseMatrix = viewProjectionMatrix.inverted();
+    const QSizeF viewportSize(width(), height());
+    const float ndcX = 2.0f * point.x() / width() - 1.0f;
+    const float ndcY = 1.0f - 2.0f * point.y() / height();
+    const QVector3D rayStart = inverseMatrix.map(QVector3D(ndcX, ndcY, -1.0f));
+    const QVector3D rayEnd = inverseMatrix.map(QVector3D(ndcX, ndcY, 1.0f));
+
+    // lines
+    for (int i = 0; i < m_glItems.size(); ++i)
+    {
+        LineBatch *batch = m_lineBatchMap.value(m_glItems.at(i), nullptr);
+
+        if ((batch == nullptr) || batch->stale)
+        {
+            continue;   // a stale batch can reference removed drawables
+        }
+
+        const LineBatch *geometries[2] = { batch, batch->arcs };
+        for (int j = 0; j < 2; ++j)
+        {
+            const LineBatch *geometry = geometries[j];
+            int segment;
+            float depth;
+
+            if (geometry->vertices.isEmpty())
+            {
+                continue;
+            }
+
+            if (geometry->segmentTree.pick(viewProjectionMatrix, viewportSize, point, pickRadius,
+                                           &geometry->vertices.constData()->position.x, sizeof(LineVertex),
+                                           &segment, &depth)
+                && ((selected == nullptr) || (depth < selectedDepth)))
+            {
+                selected = lineDrawable(geometry, segment * 2);
+                selectedDepth = depth;
+            }
+        }
+    }
 
-    sizeOffset = qFloor((float)selectionSize/2.0);  // calculate the offset
+    // models, tested against their bounding box in model space
+    for (int i = 0; i < modelTypes.size(); ++i)
+    {
+        const ModelType type = modelTypes.at(i);
+        const QList<Parameters*> *parametersList = m_drawableMap.value(type);
+        QVector3D minimum(-1.0f, -1.0f, -1.0f);
+        QVector3D maximum(1.0f, 1.0f, 1.0f);
+
+        if (type == Cube) {
+            minimum = QVector3D(0.0f, 0.0f, 0.0f);
+        }
+        else if ((type == Cylinder) || (type == Cone)) {
+            minimum.setZ(0.0f);
+        }
 
-    // correct the position of the selection to center the mouse click
-    correctedSelectionPoint.setX(qMin(qMax(m_selectionPoint.x() - sizeOffset, 0), window()->width() - selectionSize));
-    correctedSelectionPoint.setY(qMin(qMax(m_selectionPoint.y() - sizeOffset, 0), window()->height() - selectionSize));
+        for (int j = 0; j < parametersList->size(); ++j)
+        {
+            Parameters *parameters = parametersList->at(j);
+            float depth;
+
+            if (intersectBox(parameters->modelMatrix, minimum, maximum, rayStart, rayEnd, viewProjectionMatrix, &depth)
+                && ((selected == nullptr) || (depth < selectedDepth)))
+            {
+                selected = parameters;
+                selectedDepth = depth;
+            }
+        }
+    }
 
-    // read the data
-    for (int i = 0; i < (selectionSize * selectionSize); ++i)
+    // texts, tested against the text quad
+    const QList<Parameters*> *textParametersList = m_drawableMap.value(Text);
+    for (int i = 0; i < textParametersList->size(); ++i)
     {
-        GLcolorRGB colorRGB;
-        quint32 id;
+        TextParameters *textParameters = static_cast<TextParameters*>(textParametersList->at(i));
+        const float width = textParameters->width;
+        float offset = 0.0f;
+        float depth;
+
+        if (textParameters->glyphs.isEmpty())
+        {
+            continue;
+        }
 
-        glReadPixels(correctedSelectionPoint.x() + (i % selectionSize), correctedSelectionPoint.y() + (i / selectionSize), 1, 1, GL_RGB, GL_UNSIGNED_BYTE, &colorRGB);
-        id = ((quint32)colorRGB.r << 16) + ((quint32)colorRGB.g << 8) + (quint32)colorRGB.b;
+        if (textParameters->alignment == AlignCenter) {
+            offset = -width / 2.0f;
+        }
+        else if (textParameters->alignment == AlignRight) {
+            offset = -width;
+        }
 
-        if ((id != 0) && (!ids.contains(id)))   // collect all ids in selection
+        if (intersectBox(textParameters->modelMatrix,
+                         QVector3D(offset, 0.0f, 0.0f), QVector3D(offset + width, 1.0f, 0.0f),
+                         rayStart, rayEnd, viewProjectionMatrix, &depth)
+            && ((selected == nullptr) || (depth < selectedDepth)))
         {
-            ids.append(id);
+            selected = textParameters;
+            selectedDepth = depth;
         }
     }
 
-    int maxCount = 0;
+    return selected;
+}
+
+/** Returns the line drawable that owns the vertex of the batch */
+GLView::Parameters *GLView::lineDrawable(const LineBatch *batch, int vertex) const
+{
+    int first = 0;
+    int last = batch->drawables.size() - 1;
 
-    // find the id that is most common in the selection
-    foreach(quint32 id, ids)
+    while (first < last)
     {
-        int count = 0;
-        qCount(ids.begin(), ids.end(), id, count);
-        if (count > maxCount) {
-            sortedIds.prepend(id);
-            maxCount = count;
+        const int middle = (first + last + 1) / 2;
+        if (batch->drawables.at(middle)->vertexOffset <= vertex) {
+            first = middle;
         }
         else {
-            sortedIds.append(id);
+            last = middle - 1;
         }
     }
 
-    if (sortedIds.size() > 0)
+    return batch->drawables.value(first, nullptr);
+}
+
+/** Intersects the ray with a box in the model space of the drawable, depth is the normalized depth of the hit */
+bool GLView::intersectBox(const QMatrix4x4 &modelMatrix, const QVector3D &minimum, const QVector3D &maximum,
+                          const QVector3D &rayStart, const QVector3D &rayEnd,
+                          const QMatrix4x4 &viewProjectionMatrix, float *depth) const
+{
+    bool invertible;
+    const QMatrix4x4 inverseMatrix = modelMatrix.inverted(&invertible);
+    float tMinimum = 0.0f;
+    float tMaximum = 1.0f;
+
+    if (!invertible)
     {
-        return sortedIds.first();
+        return false;
     }
-    else
+
+    // the ray parameter is the same in model and world space for affine transformations
+    const QVector3D start = inverseMatrix.map(rayStart);
+    const QVector3D direction = inverseMatrix.map(rayEnd) - start;
+
+    for (int k = 0; k < 3; ++k)
     {
-        return 0;   // nothing selected
+        if (qFuzzyIsNull(direction[k]))
+        {
+            if ((start[k] < minimum[k]) || (start[k] > maximum[k])) {
+                return false;
+            }
+            continue;
+        }
+
+        float t1 = (minimum[k] - start[k]) / direction[k];
+        float t2 = (maximum[k] - start[k]) / direction[k];
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+
+        tMinimum = qMax(tMinimum, t1);
+        tMaximum = qMin(tMaximum, t2);
+        if (tMinimum > tMaximum) {
+            return false;
+        }
     }
+
+    *depth = viewProjectionMatrix.map(rayStart + (rayEnd - rayStart) * tMinimum).z();
+    return true;
 }
 
 void GLView::addGlItem(GLItem *item)
@@ -1059,6 +2597,8 @@ void GLView::removeGlItem(int index)
     }
 
     delete m_drawableListMap.take(item);
+    m_modifiedGlItems.removeAll(item);
+    m_removedGlItems.append(item);  // the render thread may still draw the batch and trail
 
     m_propertySignalMapper->removeMappings(item);
     disconnect(item, &GLItem::needsUpdate,
@@ -1292,6 +2832,12 @@ void GLView::lineStipple(float enable, float length)
     m_lineParameters->stippleLength = length;
 }
 
+/** Sets the palette entry used for the following lines, 0 draws the lines with their color */
+void GLView::lineState(int state)
+{
+    m_lineParameters->state = static_cast<GLubyte>(qBound(0, state, LinePaletteSize - 1));
+}
+
 void *GLView::line(float x, float y, float z)
 {
     GLvector3D vector;
@@ -1401,12 +2947,11 @@ void *GLView::arc(float x, float y, float radius, float startAngle, float endAng
     float currentZ;
     float startX = 0.0f;
     float startY = 0.0f;
-    const float arcPrecision = 16.0f;  // 16 segments per revolution
+    const float arcPrecision = 16.0f;  // 16 segments per revolution inside a path
     int nSegments;
     float totalAngle;
     float segmentAngle;
     float segmentZ;
-    bool inPath;
 
     if (anticlockwise && (startAngle > endAngle)) {
         totalAngle = std::fabs(endAngle - (startAngle - 2.0f * PI_F));
@@ -1418,6 +2963,22 @@ void *GLView::arc(float x, float y, float radius, float startAngle, float endAng
         totalAngle = std::fabs(endAngle - startAngle);
     }
 
+    if (!m_pathEnabled) // stored analytically and tessellated depending on the zoom level
+    {
+        m_lineParameters->vertices.clear();
+        m_lineParameters->isArc = true;
+        m_lineParameters->arc.x = x;
+        m_lineParameters->arc.y = y;
+        m_lineParameters->arc.radius = radius;
+        m_lineParameters->arc.startAngle = startAngle;
+        m_lineParameters->arc.angle = anticlockwise ? totalAngle : -totalAngle;
+        m_lineParameters->arc.helixOffset = helixOffset;
+
+        Parameters *parameters = addDrawableData(m_lineParameters);
+        resetTransformations();
+        return parameters;
+    }
+
     nSegments = static_cast<int>(std::ceil(totalAngle * arcPrecision / (2.0f * PI_F)));
     segmentAngle = totalAngle / static_cast<float>(nSegments);
     if (!anticlockwise) {
@@ -1425,8 +2986,6 @@ void *GLView::arc(float x, float y, float radius, float startAngle, float endAng
     }
     segmentZ = helixOffset / static_cast<float>(nSegments);
 
-    inPath = m_pathEnabled;
-    beginPath();
     for (int i = 0; i < (nSegments + 1); ++i)
     {
         currentX = std::cos(startAngle + segmentAngle * static_cast<float>(i)) * radius + x;
@@ -1442,25 +3001,15 @@ void *GLView::arc(float x, float y, float radius, float startAngle, float endAng
         }
     }
 
-    if (!inPath)    // if no path was previousle active end the path started in this function
-    {
-        return endPath();
-    }
-    else
-    {
-        return nullptr;
-    }
+    return nullptr;
 }
 
 void GLView::text(QString text, TextAlignment alignment , QFont font)
 {
-    QStaticText staticText(text);
-    font.setPixelSize(100);
-    staticText.prepare(QTransform(), font);
-
-    m_textParameters->staticText = staticText;
+    m_textParameters->text = text;
+    m_textParameters->font = font;
     m_textParameters->alignment = alignment;
-    prepareTextTexture(staticText, font);
+    layoutText(m_textParameters);
 
     addDrawableData(m_textParameters);
     resetTransformations();
@@ -1491,6 +3040,202 @@ void GLView::updateColor(void *drawablePointer, const QColor &color)
 
     parameters = static_cast<Parameters*>(drawablePointer);
     parameters->color = color;
+
+    if (parameters->type == Line)   // patch the vertex colors, no rebuild of the batch required
+    {
+        LineParameters *lineParameters = static_cast<LineParameters*>(parameters);
+        LineBatch *batch = m_lineBatchMap.value(lineParameters->creator, nullptr);
+
+        if (batch == nullptr)
+        {
+            return;
+        }
+
+        if (batch->build != nullptr)
+        {
+            batch->patchedDuringBuild = true;   // the running build copied the previous color
+        }
+
+        if (batch->stale || (lineParameters->vertexOffset < 0))
+        {
+            return;
+        }
+
+        if (lineParameters->isArc)
+        {
+            batch = batch->arcs;
+        }
+
+        const int first = lineParameters->vertexOffset;
+        const int last = first + lineParameters->vertexCount - 1;
+        for (int i = first; i <= last; ++i)
+        {
+            GLubyte *vertexColor = batch->vertices[i].color;
+            vertexColor[0] = (GLubyte)color.red();
+            vertexColor[1] = (GLubyte)color.green();
+            vertexColor[2] = (GLubyte)color.blue();
+            vertexColor[3] = (GLubyte)color.alpha();
+        }
+
+        batch->dirtyFirst = (batch->dirtyFirst == -1) ? first : qMin(batch->dirtyFirst, first);
+        batch->dirtyLast = qMax(batch->dirtyLast, last);
+    }
+    else if (parameters->type == Text)
+    {
+        m_textVerticesDirty = true;     // the colors are part of the glyph vertices
+    }
+    else
+    {
+        invalidateModelInstances(parameters->type);
+    }
+}
+
+/** Changes the palette entry of a line, only the state bytes of the line are uploaded again */
+void GLView::updateState(void *drawablePointer, int state)
+{
+    Parameters *parameters = static_cast<Parameters*>(drawablePointer);
+
+    if (parameters->type != Line)
+    {
+        return;
+    }
+
+    LineParameters *lineParameters = static_cast<LineParameters*>(parameters);
+    LineBatch *batch = m_lineBatchMap.value(lineParameters->creator, nullptr);
+
+    lineParameters->state = static_cast<GLubyte>(qBound(0, state, LinePaletteSize - 1));
+
+    if (batch == nullptr)
+    {
+        return;
+    }
+
+    if (batch->build != nullptr)
+    {
+        batch->patchedDuringBuild = true;   // the running build copied the previous state
+    }
+
+    if (batch->stale || (lineParameters->vertexOffset < 0))
+    {
+        return;
+    }
+
+    if (lineParameters->isArc)
+    {
+        batch = batch->arcs;
+    }
+
+    const int first = lineParameters->vertexOffset;
+    const int last = first + lineParameters->vertexCount - 1;
+    memset(batch->states.data() + first, lineParameters->state, lineParameters->vertexCount);
+
+    batch->stateFirst = (batch->stateFirst == -1) ? first : qMin(batch->stateFirst, first);
+    batch->stateLast = qMax(batch->stateLast, last);
+}
+
+/** Rebuilds the line geometry of the item from its drawables
+ *
+ *  Creates the levels of detail and the picking data of lines appended
+ *  since the last build, e.g. at the end of a streamed preview.
+ **/
+void GLView::rebuild(GLItem *glItem)
+{
+    LineBatch *batch = m_lineBatchMap.value(glItem, nullptr);
+
+    if (batch != nullptr)
+    {
+        batch->streaming = false;
+    }
+    invalidateLineBatch(glItem);
+}
+
+/** Sets whether lines are still streamed to the item
+ *
+ *  The lines of a streamed item are appended to its batch without levels
+ *  of detail, they are created once by the rebuild at the end of the stream.
+ **/
+void GLView::streamLines(GLItem *glItem, bool streaming)
+{
+    lineBatch(glItem)->streaming = streaming;
+}
+
+/** Sets the number of positions the trail of the item keeps, a new capacity clears the trail */
+void GLView::updateTrail(GLItem *glItem, int capacity, float width)
+{
+    Trail *trail = m_trailMap.value(glItem, nullptr);
+
+    capacity = qMax(2, capacity);
+
+    if (trail == nullptr)
+    {
+        trail = new Trail();
+        m_trailMap.insert(glItem, trail);
+    }
+
+    trail->width = width;
+
+    if (trail->capacity != capacity)
+    {
+        trail->capacity = capacity;
+        trail->vertices = QVector<TrailVertex>(2 * capacity);
+        trail->head = 0;
+        trail->count = 0;
+        trail->uploadCount = 0;
+        trail->reallocate = true;
+    }
+}
+
+/** Appends a position with a palette entry to the trail of the item, a full trail drops its oldest position */
+void GLView::appendTrail(GLItem *glItem, const QVector3D &position, int state)
+{
+    Trail *trail = m_trailMap.value(glItem, nullptr);
+    TrailVertex vertex;
+
+    if ((trail == nullptr) || (trail->capacity == 0))
+    {
+        return;
+    }
+
+    memset(&vertex, 0, sizeof(TrailVertex));
+    vertex.position.x = position.x();
+    vertex.position.y = position.y();
+    vertex.position.z = position.z();
+    vertex.state = static_cast<GLubyte>(qBound(0, state, LinePaletteSize - 1));
+
+    trail->vertices[trail->head] = vertex;
+    trail->vertices[trail->head + trail->capacity] = vertex;
+
+    if (trail->uploadCount == 0)
+    {
+        trail->uploadFirst = trail->head;
+    }
+    trail->uploadCount = qMin(trail->uploadCount + 1, trail->capacity);
+    trail->head = (trail->head + 1) % trail->capacity;
+    trail->count = qMin(trail->count + 1, trail->capacity);
+}
+
+void GLView::clearTrail(GLItem *glItem)
+{
+    Trail *trail = m_trailMap.value(glItem, nullptr);
+
+    if (trail != nullptr)
+    {
+        trail->head = 0;
+        trail->count = 0;
+        trail->uploadCount = 0;
+    }
+}
+
+/** Sets the colors of the line states of the item, entry 0 is not used */
+void GLView::updatePalette(GLItem *glItem, const QList<QColor> &palette)
+{
+    LineBatch *batch = lineBatch(glItem);
+
+    for (int i = 1; i < LinePaletteSize; ++i)
+    {
+        const QColor color = palette.value(i, QColor(Qt::transparent));
+        batch->palette[i] = QVector4D(color.redF(), color.greenF(), color.blueF(), color.alphaF());
+    }
 }
 
 void GLView::paint()
@@ -1536,22 +3281,16 @@ void GLView::paint()
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glEnable(GL_BLEND);
 
-    if (m_selectionModeActive)
-    {
-        m_currentDrawableId = 1;    // we start by one since 0 is the background color
-    }
-
     m_lineProgram->bind();
     m_lineProgram->setUniformValue(m_lineProjectionMatrixLocation, m_projectionMatrix);
     m_lineProgram->setUniformValue(m_lineViewMatrixLocation, m_viewMatrix);
-    m_lineProgram->setUniformValue(m_lineSelectionModeLocation, m_selectionModeActive);
     drawLines();
+    drawTrails();
     m_lineProgram->release();
 
     m_textProgram->bind();
     m_textProgram->setUniformValue(m_textProjectionMatrixLocation, m_projectionMatrix);
     m_textProgram->setUniformValue(m_textViewMatrixLocation, m_viewMatrix);
-    m_textProgram->setUniformValue(m_textSelectionModeLocation, m_selectionModeActive);
     drawTexts();
     m_textProgram->release();
 
@@ -1563,23 +3302,12 @@ void GLView::paint()
     m_modelProgram->setUniformValue(m_lightAttenuationLocation, m_light->attenuation());
     m_modelProgram->setUniformValue(m_lightAmbientCoefficientLocation, m_light->ambientCoefficient());
     m_modelProgram->setUniformValue(m_lightEnabledLocation, m_light->enabled());
-    m_modelProgram->setUniformValue(m_selectionModeLocation, m_selectionModeActive);
     drawDrawables(Cube);
     drawDrawables(Cylinder);
     drawDrawables(Cone);
     drawDrawables(Sphere);
     m_modelProgram->release();
 
-    if (m_selectionModeActive)
-    {
-        quint32 id = getSelection();
-        emit drawableSelected(m_drawableIdMap.value(id, nullptr));
-
-        m_drawableIdMap.clear();
-        m_selectionModeActive = false;
-        paint();
-    }
-
     /*if (!scissorEnabled)
     {
         glDisable(GL_SCISSOR_TEST);
@@ -1615,6 +3343,25 @@ void GLView::cleanup()
         delete m_textProgram;
         m_textProgram = 0;
     }
+
+    delete m_glyphTexture;
+    m_glyphTexture = nullptr;
+
+    qDeleteAll(m_lineBatchMap);
+    m_lineBatchMap.clear();
+    qDeleteAll(m_releasedLineBatches);
+    m_releasedLineBatches.clear();
+    qDeleteAll(m_modelInstancesMap);
+    m_modelInstancesMap.clear();
+
+    // the trails keep their positions and are uploaded again to a new context
+    foreach (Trail *trail, m_trailMap)
+    {
+        delete trail->buffer;
+        trail->buffer = nullptr;
+    }
+    qDeleteAll(m_releasedTrails);
+    m_releasedTrails.clear();
 }
 
 void GLView::sync()
@@ -1622,6 +3369,7 @@ void GLView::sync()
     if (!m_initialized)
     {
         initializeOpenGLFunctions();
+        setupInstancing();
         setupShaders();
         setupWindow();
         setupVBOs();
@@ -1633,7 +3381,38 @@ void GLView::sync()
 
     m_thread_backgroundColor = m_backgroundColor;
 
+    releaseGLItems();
     paintGLItems();
+
+    foreach (const QPointF &point, m_pickPoints)
+    {
+        emit drawableSelected(pickDrawable(point));
+    }
+    m_pickPoints.clear();
+
+    updateBusy();
+}
+
+/** The view is busy until all items are painted and their lines are built and uploaded */
+void GLView::updateBusy()
+{
+    bool busy = !m_modifiedGlItems.isEmpty();
+
+    foreach (LineBatch *batch, m_lineBatchMap)
+    {
+        if (busy || getDrawableList(Line)->isEmpty())
+        {
+            break;  // without lines the batches are not drawn and stay dirty
+        }
+        busy = (batch->build != nullptr) || batch->dirty || !batch->appended.isEmpty()
+               || (batch->hasArcs && (selectArcLevel(batch) != batch->arcLevel));
+    }
+
+    if (m_busy != busy)
+    {
+        m_busy = busy;
+        emit busyChanged(busy);
+    }
 }
 
 void GLView::reset()
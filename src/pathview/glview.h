@@ -30,13 +30,17 @@
 #include <QOpenGLTexture>
 #include <QOpenGLFunctions>
 #include <QStack>
-#include <QStaticText>
+#include <QHash>
 #include <QPainter>
 #include <QQmlListProperty>
 #include <QSignalMapper>
+#include <QVector4D>
+#include <QFuture>
 #include "glitem.h"
 #include "qglcamera.h"
 #include "gllight.h"
+#include "glsegmenttree.h"
+#include "glglyphatlas.h"
 
 namespace qtquickvcp {
 
@@ -51,6 +55,7 @@ class GLView : public QQuickPaintedItem, protected QOpenGLFunctions
     Q_PROPERTY(QGLCamera *camera READ camera WRITE setCamera NOTIFY cameraChanged)
     Q_PROPERTY(GLLight *light READ light WRITE setLight NOTIFY lightChanged)
     Q_PROPERTY(QQmlListProperty<qtquickvcp::GLItem> glItems READ glItems NOTIFY glItemsChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
     Q_ENUMS(TextAlignment)
 
 public:
@@ -78,6 +83,11 @@ public:
         return m_light;
     }
 
+    bool isBusy() const
+    {
+        return m_busy;
+    }
+
     QQmlListProperty<GLItem> glItems();
     int glItemCount() const;
     GLItem *glItem(int index) const;
@@ -91,6 +101,7 @@ signals:
     void lightChanged(GLLight * arg);
     void initialized();
     void drawableSelected(void *pointer);
+    void busyChanged(bool busy);
 
 public slots:
     void paint();
@@ -133,6 +144,7 @@ public slots:
     // line functions
     void lineWidth(float width);
     void lineStipple(float enable, float length = 5.0);
+    void lineState(int state);
     void *line(float x, float y, float z);
     void *line(const QVector3D &vector);
     void* lineTo(float x, float y, float z);
@@ -152,6 +164,15 @@ public slots:
 
     // update functions
     void updateColor(void *drawablePointer, const QColor &color);
+    void updateState(void *drawablePointer, int state);
+    void updatePalette(GLItem *glItem, const QList<QColor> &palette);
+    void rebuild(GLItem *glItem);
+    void streamLines(GLItem *glItem, bool streaming);
+
+    // trail functions
+    void updateTrail(GLItem *glItem, int capacity, float width);
+    void appendTrail(GLItem *glItem, const QVector3D &position, int state);
+    void clearTrail(GLItem *glItem);
 
     void setCamera(QGLCamera *arg)
     {
@@ -206,25 +227,70 @@ private:
         GLfloat z;
     } GLvector3D;
 
-    typedef struct {
-        GLubyte r;
-        GLubyte g;
-        GLubyte b;
-    } GLcolorRGB ;
-
     typedef struct {
         GLvector3D position;
         GLvector3D normal;
     } ModelVertex;
 
     typedef struct {
-        GLvector3D position;
-        GLvector2D texCoordinate;
+        GLvector3D position;        // world space position
+        GLvector2D texCoordinate;   // position inside the glyph atlas
+        GLubyte color[4];
     } TextVertex;
 
+    typedef struct {
+        GLvector3D position;        // world space position
+        GLvector3D stippleOrigin;   // world space origin of the stipple pattern
+        GLfloat stippleLength;      // 0 disables stippling
+        GLubyte color[4];
+    } LineVertex;
+
+    typedef struct {
+        GLvector3D position;        // world space position
+        GLubyte state;              // palette entry of the creator
+        GLubyte padding[3];
+    } TrailVertex;
+
+    typedef struct {
+        GLfloat modelMatrix[16];
+        GLubyte color[4];
+    } ModelInstance;
+
+    // per instance attributes of one model type
+    class ModelInstances {
+    public:
+        ModelInstances():
+            instanceBuffer(nullptr),
+            dirty(true)
+        { }
+
+        ~ModelInstances()
+        {
+            delete instanceBuffer;
+        }
+
+        QOpenGLBuffer *instanceBuffer;
+        QVector<ModelInstance> instances;
+        bool dirty;
+    };
+
+    // analytic arc in model space, tessellated when the line batch is built
+    typedef struct {
+        GLfloat x;
+        GLfloat y;
+        GLfloat radius;
+        GLfloat startAngle;
+        GLfloat angle;          // signed, positive is anticlockwise
+        GLfloat helixOffset;
+    } LineArc;
+
+    typedef void (QOPENGLF_APIENTRYP DrawArraysInstancedFunction)(GLenum mode, GLint first, GLsizei count, GLsizei primcount);
+    typedef void (QOPENGLF_APIENTRYP VertexAttribDivisorFunction)(GLuint index, GLuint divisor);
+
     class Parameters {
     public:
         Parameters():
+            type(NoType),
             creator(nullptr),
             modelMatrix(QMatrix4x4()),
             color(QColor(Qt::yellow)),
@@ -233,12 +299,14 @@ private:
 
         Parameters(Parameters *parameters)
         {
+            type = parameters->type;
             creator = parameters->creator;
             modelMatrix = parameters->modelMatrix;
             color = parameters->color;
             deleteFlag = parameters->deleteFlag;
         }
 
+        ModelType type;
         GLItem *creator;
         QMatrix4x4 modelMatrix;
         QColor color;
@@ -251,7 +319,11 @@ private:
             Parameters(),
             width(1.0),
             stipple(false),
-            stippleLength(1.0)
+            stippleLength(1.0),
+            state(0),
+            isArc(false),
+            vertexOffset(-1),
+            vertexCount(0)
         {
             GLvector3D vector;
             vector.x = 0.0;
@@ -262,26 +334,176 @@ private:
         }
 
         LineParameters(LineParameters *parameters):
-            Parameters(parameters)
+            Parameters(parameters),
+            vertexOffset(-1),
+            vertexCount(0)
         {
             vertices = parameters->vertices;
             width = parameters->width;
             stipple = parameters->stipple;
             stippleLength = parameters->stippleLength;
+            state = parameters->state;
+            isArc = parameters->isArc;
+            arc = parameters->arc;
         }
 
         QVector<GLvector3D> vertices;
         GLfloat width;
         bool stipple;
         GLfloat stippleLength;
+        GLubyte state;      // palette entry of the creator, 0 uses the color
+        bool isArc;         // the vertices are generated from arc
+        LineArc arc;
+        int vertexOffset;   // position inside the line batch of the creator
+        int vertexCount;
+    };
+
+    enum { LinePaletteSize = 16 };  // must match the palette size of the line shader
+
+    typedef struct {
+        GLfloat width;
+        int first;
+        int count;
+    } LineRange;
+
+    typedef struct {
+        int first;
+        int count;
+        GLfloat error;  // maximum deviation from the original lines in world units
+    } LineLevel;
+
+    // spatially coherent part of a line batch with simplified levels of detail
+    typedef struct {
+        GLfloat width;
+        QVector3D minimum;
+        QVector3D maximum;
+        QList<LineLevel> levels;    // level 0 contains the original lines
+    } LineChunk;
+
+    class LineBuild;
+
+    // all line drawables of one GL item baked into a single vertex buffer
+    class LineBatch {
+    public:
+        LineBatch():
+            vertexBuffer(nullptr),
+            stateBuffer(nullptr),
+            bufferCapacity(0),
+            palette(LinePaletteSize),
+            baseVertexCount(0),
+            hasArcs(false),
+            arcLevel(-5),
+            arcs(nullptr),
+            streaming(false),
+            dirty(true),
+            stale(true),
+            revision(0),
+            build(nullptr),
+            patchedDuringBuild(false),
+            dirtyFirst(-1),
+            dirtyLast(-1),
+            stateFirst(-1),
+            stateLast(-1)
+        { }
+
+        ~LineBatch();
+
+        QOpenGLBuffer *vertexBuffer;
+        QOpenGLBuffer *stateBuffer;         // one state byte per vertex
+        int bufferCapacity;                 // vertices the buffers can hold
+        QVector<LineVertex> vertices;
+        QVector<GLubyte> states;
+        QVector<QVector4D> palette;         // colors of the states, resolved in the shader
+        QList<LineParameters*> drawables;   // ordered by vertex offset
+        QList<LineParameters*> appended;    // added since the last build, baked to the end
+        QList<LineChunk> chunks;
+        QVector<int> levelSources;          // original vertex of every simplified vertex
+        int baseVertexCount;                // number of original vertices, followed by the simplified ones
+        GLSegmentTree segmentTree;          // for picking
+        bool hasArcs;
+        int arcLevel;                       // quantized zoom level the arcs are tessellated for
+        QVector3D arcMinimum;               // world space bounds of the arcs
+        QVector3D arcMaximum;
+        LineBatch *arcs;                    // tessellated arcs, replaced without the lines when the arc level changes
+        QMap<int, LineBatch*> arcCache;     // arcs tessellated for previous arc levels
+        QVector<int> cachedOffsets;         // vertex offset and count of every drawable of cached arcs
+        bool streaming;     // lines are appended without levels of detail until the next rebuild
+        bool dirty;         // geometry changed, a build must be started
+        bool stale;         // the built geometry can reference changed drawables
+        int revision;       // incremented on every geometry change
+        LineBuild *build;   // running build, the previous geometry is drawn meanwhile
+        QFuture<void> buildFuture;
+        bool patchedDuringBuild;    // colors or states changed after the build copied them
+        int dirtyFirst;     // range of vertices with changed colors
+        int dirtyLast;
+        int stateFirst;     // range of vertices with changed states
+        int stateLast;
+    };
+
+    // geometry of a line batch baked by a worker from copies of the line drawables
+    class LineBuild {
+    public:
+        LineBuild():
+            revision(0),
+            arcTolerance(0.0f),
+            simplify(true),
+            arcsOnly(false)
+        {
+            batch.arcs = new LineBatch();
+        }
+
+        ~LineBuild()
+        {
+            qDeleteAll(copies);
+        }
+
+        LineBatch batch;                    // only the geometry is used, it has no buffers
+        QList<LineParameters*> copies;      // owned by the build
+        QHash<const LineParameters*, LineParameters*> sources;  // original drawable of every copy
+        int revision;                       // revision of the batch when the build was started
+        GLfloat arcTolerance;
+        bool simplify;                      // create the levels of detail
+        bool arcsOnly;                      // only the arcs are tessellated again
+    };
+
+    // positions of a GL item kept in a fixed size ring and drawn as a single line strip
+    class Trail {
+    public:
+        Trail():
+            buffer(nullptr),
+            capacity(0),
+            width(1.0),
+            head(0),
+            count(0),
+            uploadFirst(0),
+            uploadCount(0),
+            reallocate(true),
+            visible(true)
+        { }
+
+        ~Trail()
+        {
+            delete buffer;
+        }
+
+        QOpenGLBuffer *buffer;
+        QVector<TrailVertex> vertices;  // every position is stored at its index and index + capacity
+        int capacity;
+        GLfloat width;
+        int head;           // ring index the next position is written to
+        int count;          // positions in the ring
+        int uploadFirst;    // ring range written since the last upload
+        int uploadCount;
+        bool reallocate;    // the buffer must be allocated and written completely
+        bool visible;       // visibility of the creator, updated on synchronization
     };
 
     class TextParameters: public Parameters {
     public:
         TextParameters():
             Parameters(),
-            staticText(QStaticText()),
-            alignment(AlignLeft)
+            alignment(AlignLeft),
+            width(0.0)
         {
             color = QColor(Qt::white);
         }
@@ -289,12 +511,18 @@ private:
         TextParameters(TextParameters *parameters):
             Parameters(parameters)
         {
-            staticText = parameters->staticText;
+            text = parameters->text;
+            font = parameters->font;
             alignment = parameters->alignment;
+            glyphs = parameters->glyphs;
+            width = parameters->width;
         }
 
-        QStaticText staticText;
+        QString text;
+        QFont font;
         TextAlignment alignment;
+        QVector<GLGlyphAtlas::GlyphQuad> glyphs;    // laid out in text units, the text is one unit high
+        GLfloat width;      // in text units
     };
 
     typedef struct {
@@ -303,6 +531,7 @@ private:
     } Drawable;
 
     bool m_initialized;
+    bool m_busy;        // items or line builds are pending, updated in sync
 
     // the shader programs
     QOpenGLShaderProgram *m_modelProgram;
@@ -311,12 +540,18 @@ private:
 
     // vertex buffers
     QMap<ModelType, QOpenGLBuffer*> m_vertexBufferMap;
-    QOpenGLBuffer *m_lineVertexBuffer;
+    QMap<ModelType, ModelInstances*> m_modelInstancesMap;
+
+    // instancing, resolved at runtime since OpenGL ES 2 has no instancing
+    bool m_instancingSupported;
+    DrawArraysInstancedFunction m_drawArraysInstanced;
+    VertexAttribDivisorFunction m_vertexAttribDivisor;
     QOpenGLBuffer *m_textVertexBuffer;
 
     // transformation matrices
     QMatrix4x4 m_viewMatrix;
     QMatrix4x4 m_projectionMatrix;
+    QVector4D m_frustumPlanes[6];   // world space planes of the view frustum, the normals point inside
     float m_projectionAspectRatio;
 
     // shader program location ids
@@ -331,30 +566,24 @@ private:
     int m_projectionMatrixLocation;
     int m_viewMatrixLocation;
     int m_modelMatrixLocation;
-    int m_selectionModeLocation;
-    int m_idColorLocation;
 
     int m_lineProjectionMatrixLocation;
     int m_lineViewMatrixLocation;
-    int m_lineModelMatrixLocation;
-    int m_lineColorLocation;
     int m_linePositionLocation;
-    int m_lineStippleLocation;
+    int m_lineColorLocation;
+    int m_lineStippleOriginLocation;
     int m_lineStippleLengthLocation;
-    int m_lineSelectionModeLocation;
-    int m_lineIdColorLocation;
+    int m_lineStateLocation;
+    int m_linePaletteLocation;
 
     int m_textProjectionMatrixLocation;
     int m_textViewMatrixLocation;
-    int m_textModelMatrixLocation;
     int m_textColorLocation;
     int m_textPositionLocation;
     int m_textTexCoordinateLocation;
     int m_textTextureLocation;
-    int m_textAspectRatioLocation;
-    int m_textAlignmentLocation;
-    int m_textSelectionModeLocation;
-    int m_textIdColorLocation;
+    int m_textSmoothingLocation;
+    bool m_textDerivativesSupported;    // the text shader can antialias with dFdx and dFdy
 
     // thread secure properties
     QColor m_backgroundColor;
@@ -373,20 +602,21 @@ private:
     bool m_pathEnabled;
     LineParameters *m_lineParameters;
     QStack<LineParameters*> m_lineParametersStack;
+    QMap<GLItem*, LineBatch*> m_lineBatchMap;
+    QList<LineBatch*> m_releasedLineBatches;    // destroyed when the context is current
+
+    // trails
+    QMap<GLItem*, Trail*> m_trailMap;
+    QList<Trail*> m_releasedTrails;             // destroyed when the context is current
 
     // text stack
     TextParameters *m_textParameters;
     QStack<TextParameters*> m_textParametersStack;
-    QList<QStaticText> m_textTextList;
-    QList<QImage> m_textImageList;
-    QList<QOpenGLTexture*> m_textTextureList;
-    QList<float> m_textAspectRatioList;
-
-    // item selection
-    quint32 m_currentDrawableId;
-    QMap<quint32, Parameters* > m_drawableIdMap;
-    QPoint m_selectionPoint;
-    bool m_selectionModeActive;
+    GLGlyphAtlas m_glyphAtlas;
+    QOpenGLTexture *m_glyphTexture;
+    int m_glyphTextureRevision;     // atlas revision of the uploaded texture
+    bool m_textVerticesDirty;       // texts changed, the glyph quads must be written again
+    int m_textVertexCount;
 
     //GL items
     GLItem *m_currentGlItem;
@@ -395,6 +625,8 @@ private:
     QList<Drawable> *m_currentDrawableList;
     QSignalMapper *m_propertySignalMapper;
     QList<GLItem*> m_modifiedGlItems;  // list of gl items that have been modified
+    QList<GLItem*> m_removedGlItems;   // batches and trails are released with the next synchronization
+    QList<QPointF> m_pickPoints;        // picks resolved with the next synchronization
 
     // camera
     QGLCamera *m_camera;
@@ -414,27 +646,72 @@ private:
     void removeDrawables(QList<Drawable> *drawableList);
 
     void drawModelVertices(ModelType type);
+    void drawModelInstances(ModelType type, int vertexCount);
+    void invalidateModelInstances(ModelType type);
+    void buildModelInstances(ModelType type, ModelInstances *modelInstances);
+    void setModelInstanceAttributes(int divisor);
 
     void drawLines();
+    void drawLineBatch(LineBatch *batch, const QVector<QVector4D> &palette);
+    LineBatch *lineBatch(GLItem *item);
+    void invalidateLineBatch(GLItem *item);
+    void addToLineBatch(GLItem *item, LineParameters *lineParameters);
+    void startLineBuild(GLItem *item, LineBatch *batch);
+    void startArcBuild(LineBatch *batch);
+    void buildLines(LineBuild *build);
+    void bakeLines(LineBatch *batch, const QList<LineParameters*> &lines, GLfloat arcTolerance, bool simplify);
+    void finishLineBuild(LineBatch *batch);
+    void patchLineBatch(LineBatch *batch);
+    void cacheArcLevel(LineBatch *batch, LineBatch *arcs, int arcLevel);
+    bool restoreArcLevel(LineBatch *batch, int arcLevel);
+    void appendLineBatch(LineBatch *batch);
+    void appendLines(LineBatch *batch, const QList<LineParameters*> &lines, GLfloat arcTolerance);
+    void bakeLine(LineBatch *batch, LineParameters *lineParameters, GLfloat arcTolerance);
+    void addArcBounds(LineBatch *batch, const LineParameters *lineParameters);
+    void writeLineBuffers(LineBatch *batch, int first);
+    void uploadLineBatch(LineBatch *batch);
+    void buildLineChunks(LineBatch *batch, const QList<LineRange> &ranges, bool simplify);
+    void simplifyLines(LineBatch *batch, const LineLevel &baseLevel, GLfloat tolerance);
+    static QVector3D vertexPosition(const LineBatch *batch, int vertex);
+    static void extendBounds(const QVector3D &vector, QVector3D *minimum, QVector3D *maximum);
+    int selectLineLevel(const LineChunk &chunk) const;
+    int selectArcLevel(const LineBatch *batch) const;
+    QVector<GLvector3D> tessellateArc(const LineArc &arc, GLfloat tolerance) const;
+    GLfloat pixelSize(const QVector3D &minimum, const QVector3D &maximum) const;
+    void updateFrustumPlanes();
+    bool boxVisible(const QVector3D &minimum, const QVector3D &maximum) const;
+
+    void drawTrails();
+    void uploadTrail(Trail *trail);
+    void writeTrailVertices(Trail *trail, int first, int count);
 
     void drawTexts();
-    void prepareTextTexture(const QStaticText &staticText, QFont font);
-    void createTextTexture(TextParameters *textParameters);
-    void clearTextTextures();
+    void layoutText(TextParameters *textParameters);
+    void writeTextVertices();
+    void appendTextQuad(QVector<TextVertex> *vertices, TextVertex vertex, const QMatrix4x4 &matrix,
+                        const QVector2D &minimum, const QVector2D &maximum,
+                        const QVector2D &textureMinimum, const QVector2D &textureMaximum, bool backFace) const;
+    void uploadGlyphTexture();
 
     void updateGLItems();
     void clearGLItem(GLItem *item);
     void updateGLItem(GLItem *item);
+    void releaseGLItems();
     void paintGLItems();
     void paintGLItem(GLItem *item);
 
-    quint32 getSelection();
+    Parameters *pickDrawable(const QPointF &point) const;
+    void updateBusy();
+    Parameters *lineDrawable(const LineBatch *batch, int vertex) const;
+    bool intersectBox(const QMatrix4x4 &modelMatrix, const QVector3D &minimum, const QVector3D &maximum,
+                      const QVector3D &rayStart, const QVector3D &rayEnd,
+                      const QMatrix4x4 &viewProjectionMatrix, float *depth) const;
 
     // setup functions
     void initializeVertexBuffer(ModelType type, const QVector<ModelVertex> & vertices);
     void initializeVertexBuffer(ModelType type, const void *bufferData, int bufferLength);
     void setupVBOs();
-    void setupLineVertexBuffer();
+    void setupInstancing();
     void setupTextVertexBuffer();
     void setupShaders();
     void setupWindow();
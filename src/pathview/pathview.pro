@@ -1,5 +1,5 @@
 TEMPLATE = lib
-QT += qml quick network
+QT += qml quick network concurrent
 
 uri = Machinekit.PathView
 include(../plugin.pri)
@@ -13,14 +13,24 @@ include(../machinetalk/machinetalk.pri)
 SOURCES += \
     plugin.cpp \
     qglcamera.cpp \
-    gcodeprogramitem.cpp \
     gcodeprogramloader.cpp \
     gcodeprogrammodel.cpp \
+    gcodepreviewstore.cpp \
+    gcodepreviewcache.cpp \
+    gcodesourcefile.cpp \
+    glbackplotitem.cpp \
+    glboundingboxitem.cpp \
     glcanvas.cpp \
+    glcoordinateitem.cpp \
     glcubeitem.cpp \
     glcylinderitem.cpp \
+    glglyphatlas.cpp \
+    glgriditem.cpp \
     glitem.cpp \
     glpathitem.cpp \
+    glprogramextentsitem.cpp \
+    glprogramoffsetsitem.cpp \
+    glsegmenttree.cpp \
     gllight.cpp \
     glsphereitem.cpp \
     glview.cpp \
@@ -28,16 +38,26 @@ SOURCES += \
 
 HEADERS += \
     plugin.h \
-    gcodeprogramitem.h \
     gcodeprogramloader.h \
     gcodeprogrammodel.h \
+    gcodepreviewstore.h \
+    gcodepreviewcache.h \
+    gcodesourcefile.h \
+    glbackplotitem.h \
+    glboundingboxitem.h \
     glcanvas.h \
+    glcoordinateitem.h \
     glcubeitem.h \
     glcylinderitem.h \
+    glglyphatlas.h \
+    glgriditem.h \
     qglcamera.h \
     glitem.h \
     gllight.h \
     glpathitem.h \
+    glprogramextentsitem.h \
+    glprogramoffsetsitem.h \
+    glsegmenttree.h \
     glsphereitem.h \
     glview.h \
     previewclient.h
@@ -47,15 +67,10 @@ RESOURCES += \
     pathview.qrc
 
 QML_FILES = \
-    BoundingBox3D.qml \
-    Coordinate3D.qml \
     GCodeSync.qml \
-    Grid3D.qml \
     PathView3D.qml \
     PathViewCore.qml \
     PathViewObject.qml \
-    ProgramExtents3D.qml \
-    ProgramOffsets3D.qml \
     SourceView.qml \
     ViewModeAction.qml \
     ZoomInAction.qml \
@@ -28,10 +28,17 @@
 #include "glsphereitem.h"
 #include "qglcamera.h"
 #include "glpathitem.h"
+#include "glbackplotitem.h"
+#include "glgriditem.h"
+#include "glboundingboxitem.h"
+#include "glprogramextentsitem.h"
+#include "glprogramoffsetsitem.h"
+#include "glcoordinateitem.h"
 #include "gllight.h"
 #include "glcanvas.h"
 #include "gcodeprogrammodel.h"
 #include "gcodeprogramloader.h"
+#include "gcodepreviewcache.h"
 
 static void initResources()
 {
@@ -42,15 +49,10 @@ static const struct {
     const char *type;
     int major, minor;
 } qmldir [] = {
-    { "BoundingBox3D", 1, 0 },
-    { "Coordinate3D", 1, 0 },
     { "GCodeSync", 1, 0 },
-    { "Grid3D", 1, 0 },
     { "PathView3D", 1, 0 },
     { "PathViewCore", 1, 0 },
     { "PathViewObject", 1, 0 },
-    { "ProgramExtents3D", 1, 0 },
-    { "ProgramOffsets3D", 1, 0 },
     { "SourceView", 1, 0 },
     { "ViewModeAction", 1, 0 },
     { "ZoomInAction", 1, 0 },
@@ -71,10 +73,17 @@ void MachinekitPathViewPlugin::registerTypes(const char *uri)
     qmlRegisterType<qtquickvcp::GLCylinderItem>(uri, 1, 0, "Cylinder3D");
     qmlRegisterType<qtquickvcp::GLSphereItem>(uri, 1, 0, "Sphere3D");
     qmlRegisterType<qtquickvcp::GLPathItem>(uri, 1, 0, "Path3D");
+    qmlRegisterType<qtquickvcp::GLBackplotItem>(uri, 1, 0, "Backplot3D");
+    qmlRegisterType<qtquickvcp::GLGridItem>(uri, 1, 0, "Grid3D");
+    qmlRegisterType<qtquickvcp::GLBoundingBoxItem>(uri, 1, 0, "BoundingBox3D");
+    qmlRegisterType<qtquickvcp::GLProgramExtentsItem>(uri, 1, 0, "ProgramExtents3D");
+    qmlRegisterType<qtquickvcp::GLProgramOffsetsItem>(uri, 1, 0, "ProgramOffsets3D");
+    qmlRegisterType<qtquickvcp::GLCoordinateItem>(uri, 1, 0, "Coordinate3D");
     qmlRegisterType<qtquickvcp::GLCanvas>(uri, 1, 0, "Canvas3D");
     qmlRegisterType<qtquickvcp::PreviewClient>(uri, 1, 0, "PreviewClient");
     qmlRegisterType<qtquickvcp::GCodeProgramModel>(uri, 1, 0, "GCodeProgramModel");
     qmlRegisterType<qtquickvcp::GCodeProgramLoader>(uri, 1, 0, "GCodeProgramLoader");
+    qmlRegisterType<qtquickvcp::GCodePreviewCache>(uri, 1, 0, "GCodePreviewCache");
 
     const QString filesLocation = fileLocation();
     for (int i = 0; i < int(sizeof(qmldir)/sizeof(qmldir[0])); i++) {
@@ -72,14 +72,14 @@ void PreviewClient::previewReceived(const QByteArray &topic, const Container &rx
         if (preview.type() == PV_PREVIEW_START)
         {
             m_previewUpdated = false;
-            m_model->beginUpdate();
-            m_model->clearPreview(false);
+            m_model->beginPreview();
             continue;
         }
 
         if (preview.type() == PV_PREVIEW_END)
         {
-            m_model->endUpdate();
+            m_model->endPreview();
+            m_previewUpdated = false;
             continue;
         }
 
@@ -88,6 +88,12 @@ void PreviewClient::previewReceived(const QByteArray &topic, const Container &rx
 
         m_previewUpdated = true;
     }
+
+    if (m_previewUpdated)   // show the part of the preview received so far
+    {
+        m_model->updatePreview();
+        m_previewUpdated = false;
+    }
 }
 
 void PreviewClient::interpStatReceived(const QByteArray &topic, const Container &rx)
@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+import QtQuick 2.0
+import Machinekit.PathView 1.0
+
+GLView3D {
+    property real heading: -135
+    property real pitch: 60
+    property vector3d extentsSize: path.maximumExtents.minus(path.minimumExtents)
+    property vector3d extentsCenter: path.minimumExtents.plus(path.maximumExtents).times(0.5)
+
+    id: glView
+
+    camera: Camera3D {
+        property real distance: Math.max(glView.extentsSize.length(), 10.0) * 2.5
+
+        id: camera
+        projectionType: Camera3D.Perspective
+        center: glView.extentsCenter
+        eye: {
+            var headingAngle = Math.PI * glView.heading / 180;
+            var pitchAngle = Math.PI * glView.pitch / 180;
+            return glView.extentsCenter.plus(Qt.vector3d(distance * Math.sin(pitchAngle) * Math.cos(headingAngle),
+                                                         distance * Math.sin(pitchAngle) * Math.sin(headingAngle),
+                                                         distance * Math.cos(pitchAngle)));
+        }
+        upVector: Qt.vector3d(0, 0, 1)
+        nearPlane: 5.0
+        farPlane: 100000.0
+    }
+
+    light: Light3D {
+        position: camera.eye
+        intensities: Qt.vector3d(1.0, 1.0, 1.0)
+        ambientCoefficient: 0.7
+        attenuation: 0.01
+    }
+
+    GCodeProgramModel {
+        id: gcodeModel
+        objectName: "model"
+    }
+
+    Grid3D {
+        minimum: path.minimumExtents
+        maximum: path.maximumExtents
+        colorAxis1: Qt.rgba(0.15, 0.15, 0.15, 1.0)
+        colorAxis1Min: Qt.rgba(0.05, 0.05, 0.05, 1.0)
+        intervalAxis1: 10.0
+        intervalAxis1Min: 2.0
+        intervalAxis2: 10.0
+        intervalAxis2Min: 2.0
+        plane: "XY"
+    }
+
+    Cylinder3D {
+        position: glView.extentsCenter.plus(Qt.vector3d(0, 0, 10))
+        cone: true
+        radius: 5
+        height: 10
+        color: Qt.rgba(0.6, 0.6, 0.6, 0.8)
+        rotationAngle: 180
+        rotationAxis: Qt.vector3d(1, 0, 0)
+    }
+
+    Sphere3D {
+        position: path.minimumExtents
+        radius: 2
+        color: Qt.rgba(1.0, 0.0, 0.0, 1.0)
+    }
+
+    Path3D {
+        id: path
+        objectName: "path"
+        model: gcodeModel
+        arcFeedColor: Qt.rgba(1.0, 1.0, 1.0, 0.5)
+        straightFeedColor: Qt.rgba(1.0, 1.0, 1.0, 0.33)
+        traverseColor: Qt.rgba(0.3, 0.5, 0.5, 0.33)
+        selectedColor: Qt.rgba(0.0, 1.0, 1.0, 1.0)
+        activeColor: Qt.rgba(1.0, 0.0, 0.0, 1.0)
+    }
+}
@@ -0,0 +1,20 @@
+TEMPLATE = app
+TARGET = pathviewbenchmark
+
+QT += qml quick
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+SOURCES += main.cpp
+
+RESOURCES += qml.qrc
+
+# the synthetic previews are built from machinetalk messages
+include(../../3rdparty/machinetalk-protobuf-qt/machinetalk-protobuf-lib.pri)
+!win32: LIBS += -lprotobuf
+
+# Additional import path used to resolve QML modules in Qt Creator's code model
+QML_IMPORT_PATH =
+
+# Default rules for deployment.
+include(../SpeedTest/deployment.pri)
@@ -0,0 +1,408 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ Roessler Systems <mail AT roessler DOT systems>
+**
+****************************************************************************/
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QAbstractItemModel>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMetaMethod>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickRenderControl>
+#include <QQuickWindow>
+#include <QTextStream>
+#include <QtMath>
+#include <algorithm>
+#include <machinetalk/protobuf/preview.pb.h>
+
+/** Headless rendering benchmark of the path view
+ *
+ *  Renders a GLView3D with a path, a grid and tool models offscreen with
+ *  QQuickRenderControl. For every scenario and program size a synthetic
+ *  preview is streamed into the GCodeProgramModel, the benchmark reports the
+ *  time from the start of the preview to the first complete frame, the
+ *  steady-state frame time while orbiting the camera, the picking latency
+ *  and the resident memory.
+ *
+ *  Use a release build of the Machinekit.PathView plugin, the debug build
+ *  logs every preview item. Without display and GPU the benchmark runs on
+ *  Mesa llvmpipe, e.g. xvfb-run -a ./pathviewbenchmark -I <qml import path>
+ **/
+
+static const QString fileName = QStringLiteral("benchmark.ngc");
+static const int previewContainerSize = 10000;   // items per preview update, like the preview client
+
+class PathViewBenchmark
+{
+public:
+    PathViewBenchmark(const QSize &size);
+    ~PathViewBenchmark();
+
+    bool initialize(const QStringList &importPaths);
+    void run(const QString &scenario, int segments, int frames);
+
+private:
+    QSize m_size;
+    QOffscreenSurface m_surface;
+    QOpenGLContext m_context;
+    QQuickRenderControl m_renderControl;
+    QQuickWindow *m_window;
+    QOpenGLFramebufferObject *m_framebuffer;
+    QQmlEngine m_engine;
+    QQuickItem *m_view;
+    QObject *m_model;
+    QObject *m_path;
+    QMetaMethod m_addPreviewItem;
+
+    double renderFrame();
+    void feedPreview(const QString &scenario, int segments);
+    static machinetalk::Preview previewItem(const QString &scenario, int index, int segments);
+    static double residentMemory();
+};
+
+PathViewBenchmark::PathViewBenchmark(const QSize &size) :
+    m_size(size),
+    m_window(nullptr),
+    m_framebuffer(nullptr),
+    m_view(nullptr),
+    m_model(nullptr),
+    m_path(nullptr)
+{
+}
+
+PathViewBenchmark::~PathViewBenchmark()
+{
+    delete m_view;
+    delete m_window;
+    if (m_context.makeCurrent(&m_surface))
+    {
+        delete m_framebuffer;
+        m_context.doneCurrent();
+    }
+}
+
+bool PathViewBenchmark::initialize(const QStringList &importPaths)
+{
+    QSurfaceFormat format;
+    format.setDepthBufferSize(24);
+    format.setStencilBufferSize(8);
+
+    m_context.setFormat(format);
+    if (!m_context.create())
+    {
+        qCritical() << "cannot create OpenGL context";
+        return false;
+    }
+
+    m_surface.setFormat(m_context.format());
+    m_surface.create();
+    if (!m_context.makeCurrent(&m_surface))
+    {
+        qCritical() << "cannot make OpenGL context current";
+        return false;
+    }
+
+    m_window = new QQuickWindow(&m_renderControl);
+    m_window->setGeometry(0, 0, m_size.width(), m_size.height());
+    m_framebuffer = new QOpenGLFramebufferObject(m_size, QOpenGLFramebufferObject::CombinedDepthStencil);
+    m_window->setRenderTarget(m_framebuffer);
+    m_renderControl.initialize(&m_context);
+
+    for (const QString &path: importPaths)
+    {
+        m_engine.addImportPath(path);
+    }
+
+    QQmlComponent component(&m_engine, QUrl(QStringLiteral("qrc:///Benchmark.qml")));
+    QObject *object = component.create();
+    m_view = qobject_cast<QQuickItem*>(object);
+    if (m_view == nullptr)
+    {
+        qCritical() << component.errors();
+        delete object;
+        return false;
+    }
+
+    m_view->setParentItem(m_window->contentItem());
+    m_view->setSize(QSizeF(m_size));
+
+    m_model = m_view->findChild<QObject*>(QStringLiteral("model"));
+    m_path = m_view->findChild<QObject*>(QStringLiteral("path"));
+    if ((qobject_cast<QAbstractItemModel*>(m_model) == nullptr) || (m_path == nullptr))
+    {
+        qCritical() << "model or path not found in Benchmark.qml";
+        return false;
+    }
+
+    // the plugin is not linked, the model is accessed through its meta object
+    const QMetaObject *metaObject = m_model->metaObject();
+    const int methodIndex = metaObject->indexOfSlot(QMetaObject::normalizedSignature("addPreviewItem(QModelIndex,machinetalk::Preview)"));
+    if (methodIndex == -1)
+    {
+        qCritical() << "model has no addPreviewItem slot";
+        return false;
+    }
+    m_addPreviewItem = metaObject->method(methodIndex);
+
+    renderFrame();
+    return true;
+}
+
+/** Renders a frame and waits until the GPU is done, returns the time in milliseconds */
+double PathViewBenchmark::renderFrame()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QCoreApplication::processEvents();
+    m_renderControl.polishItems();
+    m_renderControl.sync();
+    m_renderControl.render();
+    m_context.functions()->glFinish();
+
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+/** Streams the preview in containers like the preview client */
+void PathViewBenchmark::feedPreview(const QString &scenario, int segments)
+{
+    QAbstractItemModel *itemModel = qobject_cast<QAbstractItemModel*>(m_model);
+
+    QMetaObject::invokeMethod(m_model, "prepareFile", Q_ARG(QString, fileName), Q_ARG(int, segments));
+    QMetaObject::invokeMethod(m_model, "beginPreview");
+
+    for (int i = 0; i < segments; ++i)
+    {
+        const machinetalk::Preview preview = previewItem(scenario, i, segments);
+        m_addPreviewItem.invoke(m_model, Qt::DirectConnection,
+                                Q_ARG(QModelIndex, itemModel->index(i, 0)),
+                                Q_ARG(machinetalk::Preview, preview));
+
+        if (((i + 1) % previewContainerSize) == 0)
+        {
+            QMetaObject::invokeMethod(m_model, "updatePreview");
+            QCoreApplication::processEvents();
+        }
+    }
+
+    QMetaObject::invokeMethod(m_model, "endPreview");
+}
+
+/** Creates the preview item at index
+ *
+ *  lines: straight feeds in a zig zag pattern
+ *  arcs: arc feeds along a circle
+ *  helices: arc feeds descending in z
+ *  mixed: straight feeds with a traverse every tenth segment and arcs in between
+ **/
+machinetalk::Preview PathViewBenchmark::previewItem(const QString &scenario, int index, int segments)
+{
+    const int rowLength = qMax(1, static_cast<int>(qSqrt(segments)));
+    const double step = 200.0 / rowLength;
+    const int row = index / rowLength;
+    const int column = index % rowLength;
+    machinetalk::Preview preview;
+
+    if ((scenario == QLatin1String("arcs")) || (scenario == QLatin1String("helices"))
+        || ((scenario == QLatin1String("mixed")) && ((index % 10) == 5)))
+    {
+        const double radius = 50.0 + (index % 50);
+        const double angle = (index + 1) * 0.1;
+        const bool helix = (scenario == QLatin1String("helices"));
+
+        preview.set_type(machinetalk::PV_ARC_FEED);
+        preview.set_first_end(100.0 + radius * qCos(angle));
+        preview.set_second_end(100.0 + radius * qSin(angle));
+        preview.set_first_axis(100.0);
+        preview.set_second_axis(100.0);
+        preview.set_rotation(1);
+        preview.set_axis_end_point(helix ? (-0.01 * index) : 0.0);
+        return preview;
+    }
+
+    machinetalk::Position *position = preview.mutable_pos();
+    const bool traverse = (scenario == QLatin1String("mixed")) && ((index % 10) == 0);
+
+    preview.set_type(traverse ? machinetalk::PV_STRAIGHT_TRAVERSE : machinetalk::PV_STRAIGHT_FEED);
+    position->set_x(((row % 2) == 0) ? (column * step) : ((rowLength - column) * step));
+    position->set_y(row * step);
+    position->set_z(traverse ? 5.0 : ((column % 2) * -1.0));
+
+    return preview;
+}
+
+/** Returns the resident memory of the process in MiB, -1 when not available */
+double PathViewBenchmark::residentMemory()
+{
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return -1.0;
+    }
+
+    while (!file.atEnd())
+    {
+        const QByteArray line = file.readLine();
+        if (line.startsWith("VmRSS:"))
+        {
+            return line.mid(6).trimmed().split(' ').first().toDouble() / 1024.0;   // in kB
+        }
+    }
+
+    return -1.0;
+}
+
+void PathViewBenchmark::run(const QString &scenario, int segments, int frames)
+{
+    QTextStream out(stdout);
+    QElapsedTimer timer;
+
+    QMetaObject::invokeMethod(m_model, "clear");
+    renderFrame();
+    const double memoryBefore = residentMemory();
+
+    // load to first frame
+    timer.start();
+    feedPreview(scenario, segments);
+    const double feedTime = timer.nsecsElapsed() / 1000000.0;
+    // the path is complete when it is processed and all its lines are built and drawn
+    do
+    {
+        renderFrame();
+    }
+    while (m_path->property("processing").toBool() || m_view->property("busy").toBool());
+    const double firstFrameTime = timer.nsecsElapsed() / 1000000.0;
+    const double memoryAfter = residentMemory();
+
+    // steady state, the camera orbits to defeat any caching
+    QVector<double> frameTimes;
+    for (int i = 0; i < frames; ++i)
+    {
+        m_view->setProperty("heading", -135.0 + (360.0 * i / qMax(1, frames)));
+        frameTimes.append(renderFrame());
+    }
+    std::sort(frameTimes.begin(), frameTimes.end());
+    double frameSum = 0.0;
+    for (double time: frameTimes)
+    {
+        frameSum += time;
+    }
+
+    // picking latency on a grid of points over the view, the picks are resolved in the synchronization
+    QVector<double> pickTimes;
+    for (int y = 1; y < 10; ++y)
+    {
+        for (int x = 1; x < 10; ++x)
+        {
+            timer.restart();
+            QMetaObject::invokeMethod(m_view, "readPixel",
+                                      Q_ARG(int, m_size.width() * x / 10),
+                                      Q_ARG(int, m_size.height() * y / 10));
+            m_renderControl.polishItems();
+            m_renderControl.sync();
+            pickTimes.append(timer.nsecsElapsed() / 1000000.0);
+            m_renderControl.render();
+            m_context.functions()->glFinish();
+        }
+    }
+    std::sort(pickTimes.begin(), pickTimes.end());
+    double pickSum = 0.0;
+    for (double time: pickTimes)
+    {
+        pickSum += time;
+    }
+
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9")
+           .arg(scenario, -8)
+           .arg(segments, 8)
+           .arg(feedTime, 10, 'f', 1)
+           .arg(firstFrameTime, 12, 'f', 1)
+           .arg(frameTimes.isEmpty() ? 0.0 : (frameSum / frameTimes.size()), 10, 'f', 2)
+           .arg(frameTimes.isEmpty() ? 0.0 : frameTimes.at(frameTimes.size() * 95 / 100), 10, 'f', 2)
+           .arg(pickSum / pickTimes.size(), 10, 'f', 3)
+           .arg(pickTimes.last(), 10, 'f', 3)
+           .arg(memoryAfter - memoryBefore, 10, 'f', 1)
+        << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("LIBGL_ALWAYS_SOFTWARE"))
+    {
+        qputenv("LIBGL_ALWAYS_SOFTWARE", "1");  // Mesa llvmpipe, comparable numbers on every machine
+    }
+
+    QGuiApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless rendering benchmark of the Machinekit path view");
+    parser.addHelpOption();
+
+    QCommandLineOption importOption(QStringList() << "I" << "import", "Adds a QML import path.", "path");
+    QCommandLineOption scenarioOption("scenarios", "Comma separated scenarios: lines, arcs, helices, mixed.", "list", "lines,arcs,helices,mixed");
+    QCommandLineOption segmentOption("segments", "Comma separated program sizes in segments.", "list", "1000,10000,100000,1000000,5000000");
+    QCommandLineOption frameOption("frames", "Number of frames for the steady-state frame time.", "count", "100");
+    QCommandLineOption sizeOption("size", "Size of the rendered view.", "widthxheight", "1280x720");
+    QCommandLineOption hardwareOption("hardware", "Uses the default OpenGL driver instead of llvmpipe.");
+    parser.addOption(importOption);
+    parser.addOption(scenarioOption);
+    parser.addOption(segmentOption);
+    parser.addOption(frameOption);
+    parser.addOption(sizeOption);
+    parser.addOption(hardwareOption);
+    parser.process(app);
+
+    if (parser.isSet(hardwareOption))
+    {
+        qunsetenv("LIBGL_ALWAYS_SOFTWARE");     // before the first context is created
+    }
+
+    const QStringList sizeValues = parser.value(sizeOption).split('x');
+    const QSize size = (sizeValues.size() == 2) ? QSize(sizeValues.at(0).toInt(), sizeValues.at(1).toInt()) : QSize(1280, 720);
+
+    PathViewBenchmark benchmark(size.isValid() ? size : QSize(1280, 720));
+    if (!benchmark.initialize(parser.values(importOption)))
+    {
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9")
+           .arg("scenario", -8).arg("segments", 8).arg("feed_ms", 10).arg("1st_frame_ms", 12)
+           .arg("frame_ms", 10).arg("frame_p95", 10).arg("pick_ms", 10).arg("pick_max", 10).arg("rss_mb", 10)
+        << endl;
+
+    const int frames = qMax(1, parser.value(frameOption).toInt());
+    for (const QString &scenario: parser.value(scenarioOption).split(',', QString::SkipEmptyParts))
+    {
+        for (const QString &segments: parser.value(segmentOption).split(',', QString::SkipEmptyParts))
+        {
+            benchmark.run(scenario.trimmed(), segments.toInt(), frames);
+        }
+    }
+
+    return 0;
+}